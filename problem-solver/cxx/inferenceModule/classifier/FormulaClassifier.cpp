@@ -6,7 +6,10 @@
 
 #include "FormulaClassifier.hpp"
 
+#include <algorithm>
+
 #include <sc-agents-common/utils/CommonUtils.hpp>
+#include <sc-agents-common/utils/IteratorUtils.hpp>
 
 namespace inference
 {
@@ -94,4 +97,190 @@ bool FormulaClassifier::isFormulaToGenerate(ScMemoryContext * ms_context, ScAddr
       InferenceKeynodes::concept_template_for_generation, formula, ScType::EdgeAccessConstPosPerm);
 }
 
+bool FormulaClassifier::isTransitivityRule(
+    ScMemoryContext * ms_context,
+    ScAddr const & premise,
+    ScAddr const & conclusion,
+    TransitivityRule & rule)
+{
+  std::vector<RelationPair> premisePairs;
+  if (typeOfFormula(ms_context, premise) == CONJUNCTION)
+  {
+    ScIterator3Ptr const operandsIterator =
+        ms_context->Iterator3(premise, ScType::EdgeAccessConstPosPerm, ScType::Unknown);
+    while (operandsIterator->Next())
+    {
+      ScAddr const & operand = operandsIterator->Get(2);
+      if (typeOfFormula(ms_context, operand) != ATOMIC || !addRelationPairs(ms_context, operand, premisePairs))
+        return false;
+    }
+  }
+  else if (typeOfFormula(ms_context, premise) != ATOMIC || !addRelationPairs(ms_context, premise, premisePairs))
+    return false;
+
+  std::vector<RelationPair> conclusionPairs;
+  if (typeOfFormula(ms_context, conclusion) != ATOMIC || !addRelationPairs(ms_context, conclusion, conclusionPairs))
+    return false;
+  if (premisePairs.size() != 2 || conclusionPairs.size() != 1)
+    return false;
+
+  RelationPair first = premisePairs[0];
+  RelationPair second = premisePairs[1];
+  if (first.end != second.begin)
+    std::swap(first, second);
+  RelationPair const & conclusionPair = conclusionPairs.front();
+  bool const isChain = first.end == second.begin && first.begin != first.end && second.begin != second.end &&
+                       first.begin != second.end;
+  if (!isChain || first.relation != second.relation || first.relation != conclusionPair.relation ||
+      conclusionPair.begin != first.begin || conclusionPair.end != second.end)
+    return false;
+
+  rule = {first.relation, first.begin, second.end};
+  return true;
+}
+
+bool FormulaClassifier::isMembershipRule(
+    ScMemoryContext * ms_context,
+    ScAddr const & premise,
+    ScAddr const & conclusion,
+    MembershipRule & rule)
+{
+  ScAddr subclass;
+  ScAddr premiseElementVariable;
+  ScAddr superclass;
+  ScAddr conclusionElementVariable;
+  if (!findClassMembership(ms_context, premise, subclass, premiseElementVariable) ||
+      !findClassMembership(ms_context, conclusion, superclass, conclusionElementVariable))
+    return false;
+  if (premiseElementVariable != conclusionElementVariable || subclass == superclass)
+    return false;
+
+  rule = {subclass, superclass, premiseElementVariable};
+  return true;
+}
+
+bool FormulaClassifier::isInverseRule(
+    ScMemoryContext * ms_context,
+    ScAddr const & premise,
+    ScAddr const & conclusion,
+    InverseRule & rule)
+{
+  std::vector<RelationPair> premisePairs;
+  std::vector<RelationPair> conclusionPairs;
+  if (typeOfFormula(ms_context, premise) != ATOMIC || typeOfFormula(ms_context, conclusion) != ATOMIC)
+    return false;
+  if (!addRelationPairs(ms_context, premise, premisePairs) ||
+      !addRelationPairs(ms_context, conclusion, conclusionPairs))
+    return false;
+  if (premisePairs.size() != 1 || conclusionPairs.size() != 1)
+    return false;
+
+  RelationPair const & premisePair = premisePairs.front();
+  RelationPair const & conclusionPair = conclusionPairs.front();
+  if (premisePair.begin == premisePair.end || conclusionPair.begin != premisePair.end ||
+      conclusionPair.end != premisePair.begin)
+    return false;
+
+  rule = {premisePair.relation, conclusionPair.relation, premisePair.begin, premisePair.end};
+  return true;
+}
+
+bool FormulaClassifier::getImplicationOperands(
+    ScMemoryContext * ms_context,
+    ScAddr const & formula,
+    ScAddr & premise,
+    ScAddr & conclusion)
+{
+  switch (typeOfFormula(ms_context, formula))
+  {
+  case IMPLICATION_EDGE:
+    ms_context->GetEdgeInfo(formula, premise, conclusion);
+    break;
+  case IMPLICATION_TUPLE:
+    premise = utils::IteratorUtils::getAnyByOutRelation(ms_context, formula, InferenceKeynodes::rrel_if);
+    conclusion = utils::IteratorUtils::getAnyByOutRelation(ms_context, formula, InferenceKeynodes::rrel_then);
+    break;
+  default:
+    return false;
+  }
+  return premise.IsValid() && conclusion.IsValid();
+}
+
+bool FormulaClassifier::addRelationPairs(
+    ScMemoryContext * ms_context,
+    ScAddr const & formula,
+    std::vector<RelationPair> & pairs)
+{
+  ScAddrVector pairsArcs;
+  std::vector<std::pair<ScAddr, ScAddr>> relationsPairsArcs;
+  ScIterator3Ptr const elementsIterator =
+      ms_context->Iterator3(formula, ScType::EdgeAccessConstPosPerm, ScType::Unknown);
+  ScAddr begin;
+  ScAddr end;
+  while (elementsIterator->Next())
+  {
+    ScAddr const & element = elementsIterator->Get(2);
+    ScType const & elementType = ms_context->GetElementType(element);
+    if (elementType.IsNode())
+      continue;
+
+    if (!ms_context->GetEdgeInfo(element, begin, end))
+      return false;
+    if (elementType == ScType::EdgeDCommonVar && ms_context->GetElementType(begin) == ScType::NodeVar &&
+        ms_context->GetElementType(end) == ScType::NodeVar)
+      pairsArcs.push_back(element);
+    else if (
+        elementType == ScType::EdgeAccessVarPosPerm && ms_context->GetElementType(begin).IsNode() &&
+        ms_context->GetElementType(begin).IsConst() && ms_context->GetElementType(end) == ScType::EdgeDCommonVar)
+      relationsPairsArcs.emplace_back(begin, end);
+    else
+      return false;
+  }
+
+  if (pairsArcs.size() != relationsPairsArcs.size())
+    return false;
+  for (ScAddr const & pairArc : pairsArcs)
+  {
+    auto const & relationPairArc = std::find_if(
+        relationsPairsArcs.cbegin(),
+        relationsPairsArcs.cend(),
+        [&pairArc](std::pair<ScAddr, ScAddr> const & relationPair) { return relationPair.second == pairArc; });
+    if (relationPairArc == relationsPairsArcs.cend())
+      return false;
+
+    ms_context->GetEdgeInfo(pairArc, begin, end);
+    pairs.push_back({relationPairArc->first, begin, end});
+  }
+  return true;
+}
+
+bool FormulaClassifier::findClassMembership(
+    ScMemoryContext * ms_context,
+    ScAddr const & formula,
+    ScAddr & classAddr,
+    ScAddr & elementVariable)
+{
+  if (typeOfFormula(ms_context, formula) != ATOMIC)
+    return false;
+
+  size_t arcsAmount = 0;
+  ScIterator3Ptr const elementsIterator =
+      ms_context->Iterator3(formula, ScType::EdgeAccessConstPosPerm, ScType::Unknown);
+  while (elementsIterator->Next())
+  {
+    ScAddr const & element = elementsIterator->Get(2);
+    ScType const & elementType = ms_context->GetElementType(element);
+    if (elementType.IsNode())
+      continue;
+    if (elementType != ScType::EdgeAccessVarPosPerm || ++arcsAmount > 1)
+      return false;
+
+    ms_context->GetEdgeInfo(element, classAddr, elementVariable);
+    ScType const & classType = ms_context->GetElementType(classAddr);
+    if (!classType.IsNode() || !classType.IsConst() || ms_context->GetElementType(elementVariable) != ScType::NodeVar)
+      return false;
+  }
+  return arcsAmount == 1;
+}
+
 }  // namespace inference
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "../keynodes/InferenceKeynodes.hpp"
 
 namespace inference
@@ -26,10 +28,85 @@ public:
     EQUIVALENCE_TUPLE = 8
   };
 
+  /// Rule with premise `_a => relation: _b;; _b => relation: _c;;` and conclusion `_a => relation: _c;;`
+  struct TransitivityRule
+  {
+    ScAddr relation;
+    ScAddr sourceVariable;
+    ScAddr targetVariable;
+  };
+
+  /// Rule with premise `subclass _-> _element;;` and conclusion `superclass _-> _element;;`
+  struct MembershipRule
+  {
+    ScAddr subclass;
+    ScAddr superclass;
+    ScAddr elementVariable;
+  };
+
+  /// Rule with premise `_a => relation: _b;;` and conclusion `_b => inverseRelation: _a;;`, relations are equal if
+  /// the relation is symmetric
+  struct InverseRule
+  {
+    ScAddr relation;
+    ScAddr inverseRelation;
+    ScAddr beginVariable;
+    ScAddr endVariable;
+  };
+
   static int typeOfFormula(ScMemoryContext * ms_context, ScAddr const & formula);
   static bool isFormulaWithConst(ScMemoryContext * ms_context, ScAddr const & formula);
   static bool isFormulaWithVar(ScMemoryContext * ms_context, ScAddr const & formula);
   static bool isFormulaToGenerate(ScMemoryContext * ms_context, ScAddr const & formula);
+
+  /**
+   * @brief Check if implication of `premise` and `conclusion` makes pairs of a relation transitive. Premise is an
+   * atomic formula with both pairs or a conjunction of two atomic formulas with a pair each
+   */
+  static bool isTransitivityRule(
+      ScMemoryContext * ms_context,
+      ScAddr const & premise,
+      ScAddr const & conclusion,
+      TransitivityRule & rule);
+
+  /// Check if implication of `premise` and `conclusion` makes elements of a class elements of another class
+  static bool isMembershipRule(
+      ScMemoryContext * ms_context,
+      ScAddr const & premise,
+      ScAddr const & conclusion,
+      MembershipRule & rule);
+
+  /// Check if implication of `premise` and `conclusion` makes pairs of a relation inverse pairs of another relation
+  static bool isInverseRule(
+      ScMemoryContext * ms_context,
+      ScAddr const & premise,
+      ScAddr const & conclusion,
+      InverseRule & rule);
+
+  /// Get premise and conclusion of an implication edge or tuple, @returns false if `formula` is not an implication
+  static bool getImplicationOperands(
+      ScMemoryContext * ms_context,
+      ScAddr const & formula,
+      ScAddr & premise,
+      ScAddr & conclusion);
+
+private:
+  struct RelationPair
+  {
+    ScAddr relation;
+    ScAddr begin;
+    ScAddr end;
+  };
+
+  /// Add pairs of atomic `formula` to `pairs`, returns false if there are other constructions in the formula
+  static bool addRelationPairs(ScMemoryContext * ms_context, ScAddr const & formula, std::vector<RelationPair> & pairs);
+
+  /// Find the only construction `class _-> _element` of atomic `formula`
+  static bool findClassMembership(
+      ScMemoryContext * ms_context,
+      ScAddr const & formula,
+      ScAddr & classAddr,
+      ScAddr & elementVariable);
 };
 
 }  // namespace inference
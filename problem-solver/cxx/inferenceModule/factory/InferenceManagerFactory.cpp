@@ -13,6 +13,9 @@
 #include "manager/solutionTreeManager/SolutionTreeManager.hpp"
 #include "manager/inferenceManager/DirectInferenceManagerAll.hpp"
 #include "manager/inferenceManager/DirectInferenceManagerTarget.hpp"
+#include "manager/inferenceManager/DirectInferenceManagerBestFirst.hpp"
+#include "manager/inferenceManager/DirectInferenceManagerBidirectional.hpp"
+#include "manager/inferenceManager/DirectInferenceManagerPortfolio.hpp"
 
 using namespace inference;
 
@@ -21,33 +24,8 @@ std::unique_ptr<InferenceManagerAbstract> InferenceManagerFactory::constructDire
     InferenceConfig const & inferenceFlowConfig)
 {
   std::unique_ptr<DirectInferenceManagerAll> strategyAll = std::make_unique<DirectInferenceManagerAll>(context);
-  std::shared_ptr<SolutionTreeManagerAbstract> solutionTreeManager;
-  if (inferenceFlowConfig.solutionTreeType == TREE_FULL)
-  {
-    solutionTreeManager = std::make_unique<SolutionTreeManager>(context);
-  }
-  else if (inferenceFlowConfig.solutionTreeType == TREE_ONLY_OUTPUT_STRUCTURE)
-  {
-    solutionTreeManager = std::make_unique<SolutionTreeManagerEmpty>(context);
-  }
-  strategyAll->setSolutionTreeManager(solutionTreeManager);
-
-  std::shared_ptr<TemplateManagerAbstract> templateManager = std::make_shared<TemplateManagerFixedArguments>(context);
-  templateManager->setReplacementsUsingType(inferenceFlowConfig.replacementsUsingType);
-  templateManager->setGenerationType(inferenceFlowConfig.generationType);
-  strategyAll->setTemplateManager(templateManager);
-
-  std::shared_ptr<TemplateSearcherAbstract> templateSearcher;
-  if (inferenceFlowConfig.searchType == SEARCH_IN_ALL_KB)
-  {
-    templateSearcher = std::make_shared<TemplateSearcherGeneral>(context);
-  }
-  else if (inferenceFlowConfig.searchType == SEARCH_IN_STRUCTURES)
-  {
-    templateSearcher = std::make_shared<TemplateSearcherInStructures>(context);
-  }
-  strategyAll->setTemplateSearcher(templateSearcher);
-
+  configureManager(
+      *strategyAll, context, inferenceFlowConfig, std::make_shared<TemplateManagerFixedArguments>(context));
   return strategyAll;
 }
 
@@ -57,7 +35,68 @@ std::unique_ptr<InferenceManagerAbstract> InferenceManagerFactory::constructDire
 {
   std::unique_ptr<DirectInferenceManagerTarget> strategyTarget =
       std::make_unique<DirectInferenceManagerTarget>(context);
+  configureManager(*strategyTarget, context, inferenceFlowConfig, std::make_shared<TemplateManager>(context));
+  return strategyTarget;
+}
 
+std::unique_ptr<InferenceManagerAbstract> InferenceManagerFactory::constructDirectInferenceManagerBestFirst(
+    ScMemoryContext * context,
+    InferenceConfig const & inferenceFlowConfig)
+{
+  std::unique_ptr<DirectInferenceManagerBestFirst> strategyBestFirst =
+      std::make_unique<DirectInferenceManagerBestFirst>(context);
+  configureManager(*strategyBestFirst, context, inferenceFlowConfig, std::make_shared<TemplateManager>(context));
+  strategyBestFirst->setFrontierSize(inferenceFlowConfig.frontierSize);
+  return strategyBestFirst;
+}
+
+std::unique_ptr<InferenceManagerAbstract> InferenceManagerFactory::constructDirectInferenceManagerBidirectional(
+    ScMemoryContext * context,
+    InferenceConfig const & inferenceFlowConfig)
+{
+  std::unique_ptr<DirectInferenceManagerBidirectional> strategyBidirectional =
+      std::make_unique<DirectInferenceManagerBidirectional>(context);
+  configureManager(*strategyBidirectional, context, inferenceFlowConfig, std::make_shared<TemplateManager>(context));
+  return strategyBidirectional;
+}
+
+std::unique_ptr<InferenceManagerAbstract> InferenceManagerFactory::constructDirectInferenceManagerPortfolio(
+    ScMemoryContext * context,
+    InferenceConfig const & inferenceFlowConfig)
+{
+  std::unique_ptr<DirectInferenceManagerPortfolio> strategyPortfolio =
+      std::make_unique<DirectInferenceManagerPortfolio>(context, inferenceFlowConfig);
+  configureManager(*strategyPortfolio, context, inferenceFlowConfig, std::make_shared<TemplateManager>(context));
+  return strategyPortfolio;
+}
+
+std::unique_ptr<InferenceManagerAbstract> InferenceManagerFactory::constructInferenceManager(
+    ScMemoryContext * context,
+    InferenceStrategy strategy,
+    InferenceConfig const & inferenceFlowConfig)
+{
+  switch (strategy)
+  {
+  case STRATEGY_TARGET:
+    return constructDirectInferenceManagerTarget(context, inferenceFlowConfig);
+  case STRATEGY_ALL:
+    return constructDirectInferenceManagerAll(context, inferenceFlowConfig);
+  case STRATEGY_BEST_FIRST:
+    return constructDirectInferenceManagerBestFirst(context, inferenceFlowConfig);
+  case STRATEGY_BIDIRECTIONAL:
+    return constructDirectInferenceManagerBidirectional(context, inferenceFlowConfig);
+  case STRATEGY_PORTFOLIO:
+    return constructDirectInferenceManagerPortfolio(context, inferenceFlowConfig);
+  }
+  SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Unknown inference strategy " << strategy);
+}
+
+void InferenceManagerFactory::configureManager(
+    InferenceManagerAbstract & inferenceManager,
+    ScMemoryContext * context,
+    InferenceConfig const & inferenceFlowConfig,
+    std::shared_ptr<TemplateManagerAbstract> const & templateManager)
+{
   std::shared_ptr<SolutionTreeManagerAbstract> solutionTreeManager;
   if (inferenceFlowConfig.solutionTreeType == TREE_FULL)
   {
@@ -67,12 +106,11 @@ std::unique_ptr<InferenceManagerAbstract> InferenceManagerFactory::constructDire
   {
     solutionTreeManager = std::make_unique<SolutionTreeManagerEmpty>(context);
   }
-  strategyTarget->setSolutionTreeManager(solutionTreeManager);
+  inferenceManager.setSolutionTreeManager(solutionTreeManager);
 
-  std::shared_ptr<TemplateManagerAbstract> templateManager = std::make_shared<TemplateManager>(context);
   templateManager->setReplacementsUsingType(inferenceFlowConfig.replacementsUsingType);
   templateManager->setGenerationType(inferenceFlowConfig.generationType);
-  strategyTarget->setTemplateManager(templateManager);
+  inferenceManager.setTemplateManager(templateManager);
 
   std::shared_ptr<TemplateSearcherAbstract> templateSearcher;
   if (inferenceFlowConfig.searchType == SEARCH_IN_ALL_KB)
@@ -83,7 +121,22 @@ std::unique_ptr<InferenceManagerAbstract> InferenceManagerFactory::constructDire
   {
     templateSearcher = std::make_shared<TemplateSearcherInStructures>(context);
   }
-  strategyTarget->setTemplateSearcher(templateSearcher);
+  inferenceManager.setTemplateSearcher(templateSearcher);
+  inferenceManager.setJoinConfig(inferenceFlowConfig.joinConfig);
+  inferenceManager.setIdentityType(inferenceFlowConfig.identityType);
 
-  return strategyTarget;
+  if (inferenceFlowConfig.workersAmount > 1)
+  {
+    std::shared_ptr<ScMemoryContextPool> contextPool =
+        std::make_shared<ScMemoryContextPool>(inferenceFlowConfig.workersAmount);
+    templateSearcher->setContextPool(contextPool);
+    inferenceManager.setContextPool(contextPool);
+
+    // The thread waiting for tasks runs them too, so it is one of workers
+    std::shared_ptr<WorkStealingScheduler> scheduler =
+        std::make_shared<WorkStealingScheduler>(inferenceFlowConfig.workersAmount - 1);
+    templateSearcher->setScheduler(scheduler);
+    inferenceManager.setScheduler(scheduler);
+    inferenceManager.setOrderedCommit(inferenceFlowConfig.orderedCommit);
+  }
 }
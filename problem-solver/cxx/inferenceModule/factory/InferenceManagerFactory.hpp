@@ -20,5 +20,31 @@ public:
   static std::unique_ptr<InferenceManagerAbstract> constructDirectInferenceManagerTarget(
       ScMemoryContext * context,
       InferenceConfig const & inferenceFlowConfig);
+
+  static std::unique_ptr<InferenceManagerAbstract> constructDirectInferenceManagerBestFirst(
+      ScMemoryContext * context,
+      InferenceConfig const & inferenceFlowConfig);
+
+  static std::unique_ptr<InferenceManagerAbstract> constructDirectInferenceManagerBidirectional(
+      ScMemoryContext * context,
+      InferenceConfig const & inferenceFlowConfig);
+
+  /// Construct portfolio inference manager which races strategies of the config (see DirectInferenceManagerPortfolio)
+  static std::unique_ptr<InferenceManagerAbstract> constructDirectInferenceManagerPortfolio(
+      ScMemoryContext * context,
+      InferenceConfig const & inferenceFlowConfig);
+
+  static std::unique_ptr<InferenceManagerAbstract> constructInferenceManager(
+      ScMemoryContext * context,
+      InferenceStrategy strategy,
+      InferenceConfig const & inferenceFlowConfig);
+
+private:
+  /// Set solution tree manager, template manager, template searcher and workers of the config to the manager
+  static void configureManager(
+      InferenceManagerAbstract & inferenceManager,
+      ScMemoryContext * context,
+      InferenceConfig const & inferenceFlowConfig,
+      std::shared_ptr<TemplateManagerAbstract> const & templateManager);
 };
 }  // namespace inference
@@ -26,7 +26,7 @@ SolutionTreeGenerator::SolutionTreeGenerator(ScMemoryContext * ms_context)
 bool SolutionTreeGenerator::addNode(
     ScAddr const & formula,
     ScTemplateParams const & templateParams,
-    std::set<std::string> const & varNames)
+    VarNames const & varNames)
 {
   ScAddr newSolutionNode = createSolutionNode(formula, templateParams, varNames);
   bool result = newSolutionNode.IsValid();
@@ -61,7 +61,7 @@ bool SolutionTreeGenerator::addNode(
 ScAddr SolutionTreeGenerator::createSolutionNode(
     ScAddr const & formula,
     ScTemplateParams const & templateParams,
-    std::set<std::string> const & varNames)
+    VarNames const & varNames)
 {
   ScAddr const & solutionNode = ms_context->CreateNode(ScType::NodeConst);
   GenerationUtils::generateRelationBetween(ms_context, solutionNode, formula, CoreKeynodes::rrel_1);
@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <vector>
+
 #include <sc-memory/sc_addr.hpp>
 
 enum GenerationType
@@ -33,12 +36,74 @@ enum SearchType
   SEARCH_IN_STRUCTURES = 2
 };
 
+/// Elements which are the same entity for search and joins of replacements
+enum IdentityType
+{
+  IDENTITY_NONE = 1,
+  /// Elements connected by pairs of nrel_identity
+  IDENTITY_RELATION = 2,
+  /// Elements connected by pairs of nrel_identity and links of input structures with the same content
+  IDENTITY_RELATION_AND_CONTENT = 3
+};
+
+/// Inference manager to apply formulas with
+enum InferenceStrategy
+{
+  /// Use formulas until the target is achieved (see DirectInferenceManagerTarget)
+  STRATEGY_TARGET = 1,
+  /// Use all formulas (see DirectInferenceManagerAll)
+  STRATEGY_ALL = 2,
+  /// Use formulas in order of their distance to the target (see DirectInferenceManagerBestFirst)
+  STRATEGY_BEST_FIRST = 3,
+  /// Search derivations forward from facts and backward from the target (see DirectInferenceManagerBidirectional)
+  STRATEGY_BIDIRECTIONAL = 4,
+  /// Race strategies of the config (see DirectInferenceManagerPortfolio)
+  STRATEGY_PORTFOLIO = 5
+};
+
+/// When inference with several targets is stopped
+enum TargetsType
+{
+  /// Any of targets is achieved
+  TARGETS_ANY = 1,
+  /// All targets are achieved
+  TARGETS_ALL = 2
+};
+
+/// Config of replacements intersection (join by common variables)
+struct JoinConfig
+{
+  /// Amount of threads to join partitions of replacements in. Join is single-threaded if it is 1
+  size_t threadsAmount = 1;
+  /// Join is parallel only if both replacements have at least this amount of columns
+  size_t parallelThreshold = 10000;
+  /// Keep the same order of joined columns as single-threaded join has
+  bool deterministic = true;
+  /// Join spills partitions of replacements to temporary files if its hash table needs more bytes. 0 means no limit.
+  /// Only the hash table is limited, replacements of operands and the result of join are kept in memory
+  size_t memoryThreshold = 0;
+};
+
 struct InferenceConfig
 {
   GenerationType generationType;
   ReplacementsUsingType replacementsUsingType;
   SolutionTreeType solutionTreeType;
   SearchType searchType;
+  JoinConfig joinConfig;
+  /// Amount of workers (and their memory contexts) to use formulas of a level and to search concurrently. Inference is
+  /// sequential if it is 1. Formulas of independent partitions of a level don't see knowledge generated by each other
+  /// until the next level (see FormulasDependencyGraph)
+  size_t workersAmount = 1;
+  /// Search premises of formulas of a level concurrently and commit formulas in sequential order, so output structure
+  /// and solution tree are the same as after sequential inference. Used only if workersAmount is more than 1
+  bool orderedCommit = false;
+  /// Search and join replacements by representatives of identical elements (see IdentityClasses)
+  IdentityType identityType = IDENTITY_NONE;
+  /// The largest amount of formulas waiting to be used by best-first inference, the least promising ones are dropped
+  size_t frontierSize = 64;
+  /// Strategies which are raced by portfolio inference, the first one to achieve the target wins
+  std::vector<InferenceStrategy> portfolioStrategies = {STRATEGY_TARGET, STRATEGY_ALL, STRATEGY_BEST_FIRST};
 };
 
 struct InferenceParams
@@ -48,4 +113,26 @@ struct InferenceParams
   ScAddrVector inputStructures;
   ScAddr outputStructure;
   ScAddr targetStructure;
+  /// Targets in addition to `targetStructure`
+  ScAddrVector targetStructures;
+  TargetsType targetsType = TARGETS_ANY;
+
+  /// @returns `targetStructure` if it is valid and `targetStructures`
+  ScAddrVector getTargetStructures() const
+  {
+    ScAddrVector allTargetStructures;
+    if (targetStructure.IsValid())
+      allTargetStructures.push_back(targetStructure);
+    allTargetStructures.insert(allTargetStructures.end(), targetStructures.cbegin(), targetStructures.cend());
+    return allTargetStructures;
+  }
+};
+
+/// Result of a target of inference
+struct TargetResult
+{
+  ScAddr targetStructure;
+  bool isAchieved = false;
+  /// Amount of uses of formulas before the target is achieved, 0 if it is achieved before inference
+  size_t formulasUsesAmount = 0;
 };
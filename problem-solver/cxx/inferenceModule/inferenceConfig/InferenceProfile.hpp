@@ -0,0 +1,55 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/// Statistics of inference runs of an inference manager
+struct InferenceProfile
+{
+  /// Amount of allocations of temporary containers in the arena
+  size_t arenaAllocationsAmount = 0;
+  /// Bytes allocated for temporary containers in the arena
+  size_t arenaBytesAllocated = 0;
+  /// The largest size of the arena
+  size_t arenaPeakSize = 0;
+
+  /// Amount of memory contexts in the pool of workers
+  size_t contextPoolSize = 0;
+  size_t contextCheckoutsAmount = 0;
+  /// Amount of checkouts which waited for a free context
+  size_t contextWaitsAmount = 0;
+  /// The largest amount of contexts used at once
+  size_t contextsPeakInUse = 0;
+  /// Part of time when contexts of the pool were used
+  double contextPoolUtilization = 0;
+
+  /// Amount of worker threads of the scheduler
+  size_t schedulerThreadsAmount = 0;
+  /// Amount of formulas, join and search tasks
+  size_t schedulerTasksAmount = 0;
+  /// Amount of tasks stolen from queues of other threads
+  size_t schedulerStealsAmount = 0;
+  /// Seconds when workers of the scheduler had no task to run
+  double schedulerIdleTime = 0;
+
+  /// Amount of formulas which premises were searched speculatively in ordered commit mode
+  size_t speculativeFormulasAmount = 0;
+  /// Amount of speculative formulas used again on commit because formulas committed before changed their premises
+  size_t reexecutedFormulasAmount = 0;
+
+  /// Amount of uses of formulas by the last inference, a formula used again is counted again
+  size_t formulasUsesAmount = 0;
+  /**
+   * Amount of formulas of levels used by the last inference which best-first inference has never used or which are
+   * not in derivations materialized by bidirectional inference. The target manager uses every formula of a level at
+   * least once, so for best-first inference it is the amount of uses saved
+   */
+  size_t skippedFormulasAmount = 0;
+  /// Amount of searches of templates with a row of params
+  size_t templateSearchesAmount = 0;
+};
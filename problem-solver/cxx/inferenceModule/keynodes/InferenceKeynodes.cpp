@@ -24,5 +24,11 @@ ScAddr InferenceKeynodes::nrel_equivalence;
 ScAddr InferenceKeynodes::rrel_if;
 ScAddr InferenceKeynodes::rrel_then;
 ScAddr InferenceKeynodes::nrel_output_structure;
+ScAddr InferenceKeynodes::rrel_less;
+ScAddr InferenceKeynodes::rrel_less_or_equal;
+ScAddr InferenceKeynodes::rrel_greater;
+ScAddr InferenceKeynodes::rrel_greater_or_equal;
+ScAddr InferenceKeynodes::rrel_range;
+ScAddr InferenceKeynodes::nrel_identity;
 
 }  // namespace inference
@@ -60,6 +60,24 @@ public:
 
   SC_PROPERTY(Keynode("nrel_output_structure"), ForceCreate)
   static ScAddr nrel_output_structure;
+
+  SC_PROPERTY(Keynode("rrel_less"), ForceCreate)
+  static ScAddr rrel_less;
+
+  SC_PROPERTY(Keynode("rrel_less_or_equal"), ForceCreate)
+  static ScAddr rrel_less_or_equal;
+
+  SC_PROPERTY(Keynode("rrel_greater"), ForceCreate)
+  static ScAddr rrel_greater;
+
+  SC_PROPERTY(Keynode("rrel_greater_or_equal"), ForceCreate)
+  static ScAddr rrel_greater_or_equal;
+
+  SC_PROPERTY(Keynode("rrel_range"), ForceCreate)
+  static ScAddr rrel_range;
+
+  SC_PROPERTY(Keynode("nrel_identity"), ForceCreate)
+  static ScAddr nrel_identity;
 };
 
 }  // namespace inference
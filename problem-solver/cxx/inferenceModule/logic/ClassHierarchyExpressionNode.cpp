@@ -0,0 +1,89 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "ClassHierarchyExpressionNode.hpp"
+
+#include <utility>
+
+ClassHierarchyExpressionNode::ClassHierarchyExpressionNode(
+    ScMemoryContext * context,
+    std::shared_ptr<TemplateSearcherAbstract> templateSearcher,
+    std::shared_ptr<ClassHierarchy const> classHierarchy,
+    ScAddr const & outputStructure,
+    FormulaClassifier::MembershipRule const & rule)
+  : context(context)
+  , templateSearcher(std::move(templateSearcher))
+  , classHierarchy(std::move(classHierarchy))
+  , outputStructure(outputStructure)
+  , rule(rule)
+  , elementVariableName(context->HelperGetSystemIdtf(rule.elementVariable))
+{
+}
+
+/**
+ * @brief Generate memberships of the superclass for elements of the subclass and its subclasses
+ * @param result is a LogicFormulaResult{bool: value, value: isGenerated, Replacements: replacements}, replacements
+ * are elements of generated memberships
+ */
+void ClassHierarchyExpressionNode::compute(LogicFormulaResult & result) const
+{
+  ScAddrVector superclassElements;
+  std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> existingElements;
+  addClassElements(rule.superclass, superclassElements, existingElements);
+
+  ScAddrVector missingElements;
+  for (ScAddr const & subclass : classHierarchy->getSubclasses(rule.subclass))
+    addClassElements(subclass, missingElements, existingElements);
+
+  std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> structureElements = outputStructureElements;
+  Replacements replacements;
+  ScAddrVector generatedElements;
+  ScAddrVector createdElements;
+  for (ScAddr const & element : missingElements)
+  {
+    ScAddr const & membershipArc = context->CreateEdge(ScType::EdgeAccessConstPosPerm, rule.superclass, element);
+    if (collectsGeneratedElements)
+      createdElements.push_back(membershipArc);
+    for (ScAddr const & structureElement : {rule.superclass, membershipArc, element})
+    {
+      if (collectsGeneratedElements)
+        generatedElements.push_back(structureElement);
+      if (structureElements.insert(structureElement).second)
+        context->CreateEdge(ScType::EdgeAccessConstPosPerm, outputStructure, structureElement);
+    }
+
+    if (!elementVariableName.empty())
+      replacements[elementVariableName].push_back(element);
+  }
+
+  // The rule is true for every found element, so its value doesn't depend on generated memberships
+  result.value = true;
+  result.isGenerated = !missingElements.empty();
+  result.replacements = std::move(replacements);
+  result.generatedElements = std::move(generatedElements);
+  result.createdElements = std::move(createdElements);
+  SC_LOG_DEBUG(
+      "Memberships of " << context->HelperGetSystemIdtf(rule.superclass) << " are generated for "
+                        << missingElements.size() << " elements");
+}
+
+void ClassHierarchyExpressionNode::addClassElements(
+    ScAddr const & classAddr,
+    ScAddrVector & elements,
+    std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> & addedElements) const
+{
+  if (!templateSearcher->isSearchable(context, classAddr))
+    return;
+
+  ScIterator3Ptr const elementsIterator = context->Iterator3(classAddr, ScType::EdgeAccessConstPosPerm, ScType::Node);
+  while (elementsIterator->Next())
+  {
+    ScAddr const & element = elementsIterator->Get(2);
+    if (templateSearcher->isSearchable(context, elementsIterator->Get(1)) &&
+        templateSearcher->isSearchable(context, element) && addedElements.insert(element).second)
+      elements.push_back(element);
+  }
+}
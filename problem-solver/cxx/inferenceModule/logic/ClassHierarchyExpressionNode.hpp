@@ -0,0 +1,60 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "LogicExpressionNode.hpp"
+
+#include "classifier/FormulaClassifier.hpp"
+#include "searcher/templateSearcher/TemplateSearcherAbstract.hpp"
+#include "utils/ClassHierarchy.hpp"
+
+using namespace inference;
+
+/**
+ * Operator of a membership rule. Elements of the subclass of the rule and of all its subclasses by the class hierarchy
+ * of the inference run are found at once and become elements of the superclass, so memberships are not propagated
+ * through the hierarchy by using rules again
+ */
+class ClassHierarchyExpressionNode : public LogicExpressionNode
+{
+public:
+  ClassHierarchyExpressionNode(
+      ScMemoryContext * context,
+      std::shared_ptr<TemplateSearcherAbstract> templateSearcher,
+      std::shared_ptr<ClassHierarchy const> classHierarchy,
+      ScAddr const & outputStructure,
+      FormulaClassifier::MembershipRule const & rule);
+
+  void compute(LogicFormulaResult & result) const override;
+
+  LogicFormulaResult generate(Replacements & replacements) override
+  {
+    return {false, false, {}};
+  }
+
+  ScAddr getFormula() const override
+  {
+    return {};
+  }
+
+private:
+  /// Add elements of `classAddr` found by the searcher which are not in `elements` yet
+  void addClassElements(
+      ScAddr const & classAddr,
+      ScAddrVector & elements,
+      std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> & addedElements) const;
+
+  ScMemoryContext * context;
+  std::shared_ptr<TemplateSearcherAbstract> templateSearcher;
+  std::shared_ptr<ClassHierarchy const> classHierarchy;
+  ScAddr outputStructure;
+  FormulaClassifier::MembershipRule rule;
+  std::string elementVariableName;
+};
@@ -8,8 +8,10 @@
 
 ConjunctionExpressionNode::ConjunctionExpressionNode(
     ScMemoryContext * context,
-    OperatorLogicExpressionNode::OperandsVector & operands)
+    OperatorLogicExpressionNode::OperandsVector & operands,
+    JoinSettings joinSettings)
   : context(context)
+  , joinSettings(std::move(joinSettings))
 {
   for (auto & operand : operands)
     this->operands.emplace_back(std::move(operand));
@@ -53,7 +55,8 @@ void ConjunctionExpressionNode::compute(LogicFormulaResult & result) const
       result = lastResult;
     else
     {
-      result.replacements = ReplacementsUtils::intersectReplacements(result.replacements, lastResult.replacements);
+      result.replacements =
+          ReplacementsUtils::intersectReplacements(result.replacements, lastResult.replacements, joinSettings);
       if (result.replacements.empty())
       {
         result.value = false;
@@ -73,7 +76,8 @@ void ConjunctionExpressionNode::compute(LogicFormulaResult & result) const
       result.replacements = {};
       return;
     }
-    result.replacements = ReplacementsUtils::intersectReplacements(result.replacements, lastResult.replacements);
+    result.replacements =
+        ReplacementsUtils::intersectReplacements(result.replacements, lastResult.replacements, joinSettings);
     if (result.replacements.empty())
     {
       result.value = false;
@@ -92,7 +96,12 @@ void ConjunctionExpressionNode::compute(LogicFormulaResult & result) const
       result.replacements = {};
       return;
     }
-    result.replacements = ReplacementsUtils::intersectReplacements(result.replacements, lastResult.replacements);
+    result.replacements =
+        ReplacementsUtils::intersectReplacements(result.replacements, lastResult.replacements, joinSettings);
+    result.generatedElements.insert(
+        result.generatedElements.cend(), lastResult.generatedElements.cbegin(), lastResult.generatedElements.cend());
+    result.createdElements.insert(
+        result.createdElements.cend(), lastResult.createdElements.cbegin(), lastResult.createdElements.cend());
     if (result.replacements.empty())
     {
       result.value = false;
@@ -113,8 +122,14 @@ LogicFormulaResult ConjunctionExpressionNode::generate(Replacements & replacemen
     if (!lastResult.value)
       return fail;
     globalResult.isGenerated |= lastResult.isGenerated;
+    globalResult.generatedElements.insert(
+        globalResult.generatedElements.cend(),
+        lastResult.generatedElements.cbegin(),
+        lastResult.generatedElements.cend());
+    globalResult.createdElements.insert(
+        globalResult.createdElements.cend(), lastResult.createdElements.cbegin(), lastResult.createdElements.cend());
     globalResult.replacements =
-        ReplacementsUtils::intersectReplacements(globalResult.replacements, lastResult.replacements);
+        ReplacementsUtils::intersectReplacements(globalResult.replacements, lastResult.replacements, joinSettings);
     if (ReplacementsUtils::getColumnsAmount(globalResult.replacements) == 0)
       return fail;
   }
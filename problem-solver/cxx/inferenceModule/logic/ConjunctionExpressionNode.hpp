@@ -13,7 +13,7 @@ using namespace inference;
 class ConjunctionExpressionNode : public OperatorLogicExpressionNode
 {
 public:
-  explicit ConjunctionExpressionNode(ScMemoryContext * context, OperandsVector & operands);
+  ConjunctionExpressionNode(ScMemoryContext * context, OperandsVector & operands, JoinSettings joinSettings);
 
   void compute(LogicFormulaResult & result) const override;
 
@@ -26,4 +26,5 @@ public:
 
 private:
   ScMemoryContext * context;
+  JoinSettings joinSettings;
 };
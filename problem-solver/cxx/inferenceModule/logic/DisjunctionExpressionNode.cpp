@@ -6,6 +6,8 @@
 
 #include "DisjunctionExpressionNode.hpp"
 
+#include "utils/ReplacementsUnion.hpp"
+
 DisjunctionExpressionNode::DisjunctionExpressionNode(
     ScMemoryContext * context,
     OperatorLogicExpressionNode::OperandsVector & operands)
@@ -15,11 +17,17 @@ DisjunctionExpressionNode::DisjunctionExpressionNode(
     this->operands.emplace_back(std::move(operand));
 }
 
+/**
+ * @brief Compute operands one by one and unite their replacements. If only the value of the disjunction is needed,
+ * stop at the first true operand
+ * @param result is a LogicFormulaResult{bool: value, value: isGenerated, Replacements: replacements}
+ */
 void DisjunctionExpressionNode::compute(LogicFormulaResult & result) const
 {
   result.value = false;
   vector<TemplateExpressionNode *> formulasWithoutConstants;
   vector<TemplateExpressionNode *> formulasToGenerate;
+  ReplacementsUnion replacementsUnion;
 
   for (auto const & operand : operands)
   {
@@ -43,25 +51,38 @@ void DisjunctionExpressionNode::compute(LogicFormulaResult & result) const
     LogicFormulaResult lastResult;
     operand->compute(lastResult);
     result.value |= lastResult.value;
-    result.replacements = ReplacementsUtils::uniteReplacements(result.replacements, lastResult.replacements);
+    replacementsUnion.add(lastResult.replacements);
+    if (valueOnly && result.value)
+    {
+      SC_LOG_DEBUG("Disjunction is true, other operands are skipped");
+      result.replacements = replacementsUnion.getReplacements();
+      return;
+    }
   }
-  if (result.replacements.empty())
+  if (replacementsUnion.getColumnsAmount() == 0)
   {
     result.value = false;
     result.isGenerated = false;
     result.replacements = {};
     return;
   }
+  result.replacements = replacementsUnion.getReplacements();
   for (auto const & atom : formulasWithoutConstants)
   {
     LogicFormulaResult lastResult = atom->find(result.replacements);
     result.value |= lastResult.value;
-    result.replacements = ReplacementsUtils::uniteReplacements(result.replacements, lastResult.replacements);
+    replacementsUnion.add(lastResult.replacements);
+    result.replacements = replacementsUnion.getReplacements();
   }
   for (auto const & formulaToGenerate : formulasToGenerate)
   {
     LogicFormulaResult lastResult = formulaToGenerate->generate(result.replacements);
     result.value |= lastResult.value;
-    result.replacements = ReplacementsUtils::uniteReplacements(result.replacements, lastResult.replacements);
+    result.generatedElements.insert(
+        result.generatedElements.cend(), lastResult.generatedElements.cbegin(), lastResult.generatedElements.cend());
+    result.createdElements.insert(
+        result.createdElements.cend(), lastResult.createdElements.cbegin(), lastResult.createdElements.cend());
+    replacementsUnion.add(lastResult.replacements);
+    result.replacements = replacementsUnion.getReplacements();
   }
 }
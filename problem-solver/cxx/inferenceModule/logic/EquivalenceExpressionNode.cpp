@@ -8,8 +8,10 @@
 
 EquivalenceExpressionNode::EquivalenceExpressionNode(
     ScMemoryContext * context,
-    OperatorLogicExpressionNode::OperandsVector & operands)
+    OperatorLogicExpressionNode::OperandsVector & operands,
+    JoinSettings joinSettings)
   : context(context)
+  , joinSettings(std::move(joinSettings))
 {
   for (auto & operand : operands)
     this->operands.emplace_back(std::move(operand));
@@ -63,11 +65,13 @@ void EquivalenceExpressionNode::compute(LogicFormulaResult & result) const
     SC_LOG_DEBUG("Processing formula to generate");
     auto formulaToGenerate = formulasToGenerate[0];
     subFormulaResults.push_back(formulaToGenerate->generate(subFormulaResults[0].replacements));
+    result.generatedElements = subFormulaResults.back().generatedElements;
+    result.createdElements = subFormulaResults.back().createdElements;
   }
   result.value = subFormulaResults[0].value == subFormulaResults[1].value;
   if (result.value)
-    result.replacements =
-        ReplacementsUtils::intersectReplacements(subFormulaResults[0].replacements, subFormulaResults[1].replacements);
+    result.replacements = ReplacementsUtils::intersectReplacements(
+        subFormulaResults[0].replacements, subFormulaResults[1].replacements, joinSettings);
   return;
 
   auto leftAtom = dynamic_cast<TemplateExpressionNode *>(operands[0].get());
@@ -115,5 +119,6 @@ void EquivalenceExpressionNode::compute(LogicFormulaResult & result) const
 
   result.value = leftResult.value == rightResult.value;
   if (rightResult.value)
-    result.replacements = ReplacementsUtils::intersectReplacements(leftResult.replacements, rightResult.replacements);
+    result.replacements =
+        ReplacementsUtils::intersectReplacements(leftResult.replacements, rightResult.replacements, joinSettings);
 }
@@ -13,7 +13,7 @@ using namespace inference;
 class EquivalenceExpressionNode : public OperatorLogicExpressionNode
 {
 public:
-  explicit EquivalenceExpressionNode(ScMemoryContext * context, OperandsVector & operands);
+  EquivalenceExpressionNode(ScMemoryContext * context, OperandsVector & operands, JoinSettings joinSettings);
 
   void compute(LogicFormulaResult & result) const override;
 
@@ -29,4 +29,5 @@ public:
 
 private:
   ScMemoryContext * context;
+  JoinSettings joinSettings;
 };
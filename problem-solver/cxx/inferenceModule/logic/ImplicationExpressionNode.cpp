@@ -8,8 +8,10 @@
 
 ImplicationExpressionNode::ImplicationExpressionNode(
     ScMemoryContext * context,
-    OperatorLogicExpressionNode::OperandsVector & operands)
+    OperatorLogicExpressionNode::OperandsVector & operands,
+    JoinSettings joinSettings)
   : context(context)
+  , joinSettings(std::move(joinSettings))
 {
   for (auto & operand : operands)
     this->operands.emplace_back(std::move(operand));
@@ -21,26 +23,39 @@ ImplicationExpressionNode::ImplicationExpressionNode(
  * @return result from param
  */
 void ImplicationExpressionNode::compute(LogicFormulaResult & result) const
+{
+  // Compute premise formula, get replacements with found constructions
+  LogicFormulaResult premiseResult = computePremise();
+
+  // Generate conclusion using computed premise replacements
+  computeByPremise(premiseResult, result);
+}
+
+LogicFormulaResult ImplicationExpressionNode::computePremise() const
 {
   LogicExpressionNode * premiseAtom = operands[0].get();
   premiseAtom->setArgumentVector(argumentVector);
 
-  LogicExpressionNode * conclusionAtom = operands[1].get();
-  conclusionAtom->setArgumentVector(argumentVector);
-
-  // Compute premise formula, get replacements with found constructions
   LogicFormulaResult premiseResult;
   premiseAtom->compute(premiseResult);
+  return premiseResult;
+}
+
+void ImplicationExpressionNode::computeByPremise(LogicFormulaResult & premiseResult, LogicFormulaResult & result) const
+{
+  LogicExpressionNode * conclusionAtom = operands[1].get();
+  conclusionAtom->setArgumentVector(argumentVector);
 
-  // Generate conclusion using computed premise replacements
   LogicFormulaResult conclusionResult = conclusionAtom->generate(premiseResult.replacements);
 
   // Implication value (a -> b) is equal to ((!a) || b)
   result.value = !premiseResult.value || conclusionResult.value;
   result.isGenerated = conclusionResult.isGenerated;
+  result.generatedElements = std::move(conclusionResult.generatedElements);
+  result.createdElements = std::move(conclusionResult.createdElements);
   if (conclusionResult.value)
   {
-    result.replacements =
-        ReplacementsUtils::intersectReplacements(premiseResult.replacements, conclusionResult.replacements);
+    result.replacements = ReplacementsUtils::intersectReplacements(
+        premiseResult.replacements, conclusionResult.replacements, joinSettings);
   }
 }
@@ -13,10 +13,16 @@ using namespace inference;
 class ImplicationExpressionNode : public OperatorLogicExpressionNode
 {
 public:
-  explicit ImplicationExpressionNode(ScMemoryContext * context, OperandsVector & operands);
+  ImplicationExpressionNode(ScMemoryContext * context, OperandsVector & operands, JoinSettings joinSettings);
 
   void compute(LogicFormulaResult & result) const override;
 
+  /// Search premise, it doesn't change knowledge base, so it may be computed before formulas used earlier
+  LogicFormulaResult computePremise() const;
+
+  /// Generate conclusion with replacements of the premise computed by `computePremise`
+  void computeByPremise(LogicFormulaResult & premiseResult, LogicFormulaResult & result) const;
+
   LogicFormulaResult generate(Replacements & replacements) override
   {
     return {false, false, {}};
@@ -29,4 +35,5 @@ public:
 
 private:
   ScMemoryContext * context;
+  JoinSettings joinSettings;
 };
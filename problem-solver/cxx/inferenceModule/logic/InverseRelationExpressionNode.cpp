@@ -0,0 +1,79 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "InverseRelationExpressionNode.hpp"
+
+#include <map>
+#include <utility>
+
+InverseRelationExpressionNode::InverseRelationExpressionNode(
+    ScMemoryContext * context,
+    std::shared_ptr<TemplateSearcherAbstract> templateSearcher,
+    ScAddr const & outputStructure,
+    FormulaClassifier::InverseRule const & rule)
+  : context(context)
+  , templateSearcher(std::move(templateSearcher))
+  , outputStructure(outputStructure)
+  , rule(rule)
+  , beginVariableName(context->HelperGetSystemIdtf(rule.beginVariable))
+  , endVariableName(context->HelperGetSystemIdtf(rule.endVariable))
+{
+}
+
+/**
+ * @brief Generate inverse pairs of pairs of the relation which are not found
+ * @param result is a LogicFormulaResult{bool: value, value: isGenerated, Replacements: replacements}, replacements
+ * are ends of pairs of the relation which inverse pairs are generated
+ */
+void InverseRelationExpressionNode::compute(LogicFormulaResult & result) const
+{
+  // Inverse pairs are found by begins, generated pairs are added too, so a pair is not reversed twice
+  std::map<ScAddr, std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>>, ScAddLessFunc> inversePairs;
+  for (std::pair<ScAddr, ScAddr> const & pair : templateSearcher->findRelationPairs(context, rule.inverseRelation))
+    inversePairs[pair.first].insert(pair.second);
+
+  std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> structureElements = outputStructureElements;
+  Replacements replacements;
+  ScAddrVector generatedElements;
+  ScAddrVector createdElements;
+  size_t generatedPairsAmount = 0;
+  for (std::pair<ScAddr, ScAddr> const & pair : templateSearcher->findRelationPairs(context, rule.relation))
+  {
+    if (!inversePairs[pair.second].insert(pair.first).second)
+      continue;
+
+    ScAddr const & pairArc = context->CreateEdge(ScType::EdgeDCommonConst, pair.second, pair.first);
+    ScAddr const & relationArc = context->CreateEdge(ScType::EdgeAccessConstPosPerm, rule.inverseRelation, pairArc);
+    if (collectsGeneratedElements)
+    {
+      createdElements.push_back(pairArc);
+      createdElements.push_back(relationArc);
+    }
+    for (ScAddr const & element : {pair.second, pair.first, rule.inverseRelation, pairArc, relationArc})
+    {
+      if (collectsGeneratedElements)
+        generatedElements.push_back(element);
+      if (structureElements.insert(element).second)
+        context->CreateEdge(ScType::EdgeAccessConstPosPerm, outputStructure, element);
+    }
+
+    if (!beginVariableName.empty())
+      replacements[beginVariableName].push_back(pair.first);
+    if (!endVariableName.empty())
+      replacements[endVariableName].push_back(pair.second);
+    ++generatedPairsAmount;
+  }
+
+  // The rule is true for every pair, so its value doesn't depend on generated pairs
+  result.value = true;
+  result.isGenerated = generatedPairsAmount > 0;
+  result.replacements = std::move(replacements);
+  result.generatedElements = std::move(generatedElements);
+  result.createdElements = std::move(createdElements);
+  SC_LOG_DEBUG(
+      "Inverse pairs of " << context->HelperGetSystemIdtf(rule.relation) << " are generated by "
+                          << generatedPairsAmount << " pairs");
+}
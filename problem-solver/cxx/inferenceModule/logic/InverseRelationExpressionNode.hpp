@@ -0,0 +1,52 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "LogicExpressionNode.hpp"
+
+#include "classifier/FormulaClassifier.hpp"
+#include "searcher/templateSearcher/TemplateSearcherAbstract.hpp"
+
+using namespace inference;
+
+/**
+ * Operator of a symmetric or inverse relation rule. Pairs of both relations are read once and every pair of the
+ * relation without the inverse pair is reversed, so the rule is used by one pass over the relation instead of search
+ * of the premise and of every conclusion
+ */
+class InverseRelationExpressionNode : public LogicExpressionNode
+{
+public:
+  InverseRelationExpressionNode(
+      ScMemoryContext * context,
+      std::shared_ptr<TemplateSearcherAbstract> templateSearcher,
+      ScAddr const & outputStructure,
+      FormulaClassifier::InverseRule const & rule);
+
+  void compute(LogicFormulaResult & result) const override;
+
+  LogicFormulaResult generate(Replacements & replacements) override
+  {
+    return {false, false, {}};
+  }
+
+  ScAddr getFormula() const override
+  {
+    return {};
+  }
+
+private:
+  ScMemoryContext * context;
+  std::shared_ptr<TemplateSearcherAbstract> templateSearcher;
+  ScAddr outputStructure;
+  FormulaClassifier::InverseRule rule;
+  std::string beginVariableName;
+  std::string endVariableName;
+};
@@ -15,6 +15,11 @@
 #include "ImplicationExpressionNode.hpp"
 #include "EquivalenceExpressionNode.hpp"
 #include "TemplateExpressionNode.hpp"
+#include "TransitiveClosureExpressionNode.hpp"
+#include "ClassHierarchyExpressionNode.hpp"
+#include "InverseRelationExpressionNode.hpp"
+
+#include "inferenceConfig/InferenceConfig.hpp"
 
 LogicExpression::LogicExpression(
     ScMemoryContext * context,
@@ -128,8 +133,10 @@ std::shared_ptr<LogicExpressionNode> LogicExpression::buildAtomicFormula(ScAddr
     }
   }
 
-  return std::make_shared<TemplateExpressionNode>(
+  std::shared_ptr<LogicExpressionNode> atomicFormula = std::make_shared<TemplateExpressionNode>(
       context, templateSearcher, templateManager, solutionTreeManager, outputStructure, formula);
+  atomicFormula->setCollectsGeneratedElements(collectsGeneratedElements);
+  return atomicFormula;
 }
 
 std::shared_ptr<LogicExpressionNode> LogicExpression::buildConjunctionFormula(ScAddr const & formula)
@@ -137,7 +144,7 @@ std::shared_ptr<LogicExpressionNode> LogicExpression::buildConjunctionFormula(Sc
   SC_LOG_DEBUG(context->HelperGetSystemIdtf(formula) << " is a conjunction tuple");
   OperatorLogicExpressionNode::OperandsVector operands = resolveTupleOperands(formula);
   if (!operands.empty())
-    return std::make_unique<ConjunctionExpressionNode>(context, operands);
+    return std::make_unique<ConjunctionExpressionNode>(context, operands, joinSettings);
   else
     SC_THROW_EXCEPTION(utils::ExceptionItemNotFound, "Conjunction must have operands");
 }
@@ -166,9 +173,13 @@ std::shared_ptr<LogicExpressionNode> LogicExpression::buildNegationFormula(ScAdd
 std::shared_ptr<LogicExpressionNode> LogicExpression::buildImplicationEdgeFormula(ScAddr const & formula)
 {
   SC_LOG_DEBUG(context->HelperGetSystemIdtf(formula) << " is an implication edge");
+  std::shared_ptr<LogicExpressionNode> ruleOperator = buildRuleOperator(formula);
+  if (ruleOperator != nullptr)
+    return ruleOperator;
+
   OperatorLogicExpressionNode::OperandsVector operands = resolveEdgeOperands(formula);
   if (operands.size() == 2)
-    return std::make_unique<ImplicationExpressionNode>(context, operands);
+    return std::make_unique<ImplicationExpressionNode>(context, operands, joinSettings);
   else
     SC_THROW_EXCEPTION(
         utils::ExceptionItemNotFound,
@@ -178,21 +189,83 @@ std::shared_ptr<LogicExpressionNode> LogicExpression::buildImplicationEdgeFormul
 std::shared_ptr<LogicExpressionNode> LogicExpression::buildImplicationTupleFormula(ScAddr const & formula)
 {
   SC_LOG_DEBUG(context->HelperGetSystemIdtf(formula) << " is an implication tuple");
+  std::shared_ptr<LogicExpressionNode> ruleOperator = buildRuleOperator(formula);
+  if (ruleOperator != nullptr)
+    return ruleOperator;
+
   OperatorLogicExpressionNode::OperandsVector operands = resolveOperandsForImplicationTuple(formula);
   if (operands.size() == 2)
-    return std::make_unique<ImplicationExpressionNode>(context, operands);
+    return std::make_unique<ImplicationExpressionNode>(context, operands, joinSettings);
   else
     SC_THROW_EXCEPTION(
         utils::ExceptionItemNotFound,
         "There is " << operands.size() << " operands in implication tuple, but should be two");
 }
 
+std::shared_ptr<LogicExpressionNode> LogicExpression::buildRuleOperator(ScAddr const & implication)
+{
+  // Operators generate the same constructions as repeated use of the rule only if every replacement is used, every
+  // construction is generated once and no variable is fixed by arguments
+  if (!templateManager->getArguments().empty() || templateManager->getGenerationType() != GENERATE_UNIQUE_FORMULAS ||
+      templateManager->getReplacementsUsingType() != REPLACEMENTS_ALL)
+    return nullptr;
+
+  ScAddr premise;
+  ScAddr conclusion;
+  if (!FormulaClassifier::getImplicationOperands(context, implication, premise, conclusion))
+    return nullptr;
+
+  std::shared_ptr<LogicExpressionNode> ruleOperator;
+  FormulaClassifier::TransitivityRule transitivityRule;
+  FormulaClassifier::InverseRule inverseRule;
+  FormulaClassifier::MembershipRule membershipRule;
+  if (FormulaClassifier::isTransitivityRule(context, premise, conclusion, transitivityRule))
+  {
+    SC_LOG_DEBUG("Implication is a transitivity rule of " << context->HelperGetSystemIdtf(transitivityRule.relation));
+    ruleOperator = std::make_shared<TransitiveClosureExpressionNode>(
+        context, templateSearcher, outputStructure, transitivityRule);
+  }
+  else if (FormulaClassifier::isInverseRule(context, premise, conclusion, inverseRule))
+  {
+    SC_LOG_DEBUG("Implication is an inverse relation rule of " << context->HelperGetSystemIdtf(inverseRule.relation));
+    ruleOperator =
+        std::make_shared<InverseRelationExpressionNode>(context, templateSearcher, outputStructure, inverseRule);
+  }
+  else if (
+      classHierarchy != nullptr && FormulaClassifier::isMembershipRule(context, premise, conclusion, membershipRule) &&
+      classHierarchy->contains(membershipRule.subclass))
+  {
+    SC_LOG_DEBUG("Implication is a membership rule of " << context->HelperGetSystemIdtf(membershipRule.superclass));
+    ruleOperator = std::make_shared<ClassHierarchyExpressionNode>(
+        context, templateSearcher, classHierarchy, outputStructure, membershipRule);
+  }
+
+  if (ruleOperator != nullptr)
+    ruleOperator->setCollectsGeneratedElements(collectsGeneratedElements);
+  return ruleOperator;
+}
+
+void LogicExpression::setClassHierarchy(std::shared_ptr<ClassHierarchy const> otherClassHierarchy)
+{
+  classHierarchy = std::move(otherClassHierarchy);
+}
+
+void LogicExpression::setJoinSettings(JoinSettings otherJoinSettings)
+{
+  joinSettings = std::move(otherJoinSettings);
+}
+
+void LogicExpression::setCollectsGeneratedElements(bool otherCollectsGeneratedElements)
+{
+  collectsGeneratedElements = otherCollectsGeneratedElements;
+}
+
 std::shared_ptr<LogicExpressionNode> LogicExpression::buildEquivalenceEdgeFormula(ScAddr const & formula)
 {
   SC_LOG_DEBUG(context->HelperGetSystemIdtf(formula) << " is an equivalence edge");
   OperatorLogicExpressionNode::OperandsVector operands = resolveEdgeOperands(formula);
   if (operands.size() == 2)
-    return std::make_unique<EquivalenceExpressionNode>(context, operands);
+    return std::make_unique<EquivalenceExpressionNode>(context, operands, joinSettings);
   else
     SC_THROW_EXCEPTION(
         utils::ExceptionItemNotFound,
@@ -204,7 +277,7 @@ std::shared_ptr<LogicExpressionNode> LogicExpression::buildEquivalenceTupleFormu
   SC_LOG_DEBUG(context->HelperGetSystemIdtf(formula) << " is an equivalence tuple");
   OperatorLogicExpressionNode::OperandsVector operands = resolveTupleOperands(formula);
   if (operands.size() == 2)
-    return std::make_unique<EquivalenceExpressionNode>(context, operands);
+    return std::make_unique<EquivalenceExpressionNode>(context, operands, joinSettings);
   else
     SC_THROW_EXCEPTION(
         utils::ExceptionItemNotFound,
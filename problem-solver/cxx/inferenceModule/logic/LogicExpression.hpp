@@ -21,6 +21,7 @@
 #include "manager/templateManager/TemplateManager.hpp"
 #include "searcher/templateSearcher/TemplateSearcherAbstract.hpp"
 #include "classifier/FormulaClassifier.hpp"
+#include "utils/ClassHierarchy.hpp"
 
 using namespace inference;
 
@@ -49,6 +50,21 @@ public:
   OperatorLogicExpressionNode::OperandsVector resolveEdgeOperands(ScAddr const & edge);
   OperatorLogicExpressionNode::OperandsVector resolveOperandsForImplicationTuple(ScAddr const & tuple);
 
+  /**
+   * @returns closure operator if the implication is a transitivity rule, inverse relation operator if it is a
+   * symmetric or inverse relation rule, class hierarchy operator if it is a membership rule of the class hierarchy,
+   * else nullptr
+   */
+  std::shared_ptr<LogicExpressionNode> buildRuleOperator(ScAddr const & implication);
+
+  void setClassHierarchy(std::shared_ptr<ClassHierarchy const> otherClassHierarchy);
+
+  /// Set config and scheduler of joins of conjunctions, implications and equivalences
+  void setJoinSettings(JoinSettings otherJoinSettings);
+
+  /// Set if atomic formulas and rule operators collect generated elements to their results
+  void setCollectsGeneratedElements(bool otherCollectsGeneratedElements);
+
 private:
   ScMemoryContext * context;
   std::vector<ScTemplateParams> paramsSet;
@@ -56,6 +72,10 @@ private:
   std::shared_ptr<TemplateSearcherAbstract> templateSearcher;
   std::shared_ptr<TemplateManagerAbstract> templateManager;
   std::shared_ptr<SolutionTreeManagerAbstract> solutionTreeManager;
+  /// Subsumption graph of membership rules of the inference run, nullptr if there is no hierarchy
+  std::shared_ptr<ClassHierarchy const> classHierarchy;
+  JoinSettings joinSettings;
+  bool collectsGeneratedElements = false;
 
   ScAddr outputStructure;
 };
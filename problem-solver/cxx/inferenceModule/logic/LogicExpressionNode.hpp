@@ -13,6 +13,10 @@ struct LogicFormulaResult
   bool value = false;
   bool isGenerated = false;
   Replacements replacements{};
+  /// Elements of constructions generated while the formula is computed, they are collected only for inference sinks
+  ScAddrVector generatedElements{};
+  /// Elements of generated constructions which are created by the formula, they are collected with generated elements
+  ScAddrVector createdElements{};
 };
 
 class LogicExpressionNode
@@ -37,7 +41,21 @@ public:
     outputStructureElements = otherOutputStructureElements;
   }
 
+  /// Mark that only the value of the formula is used, so replacements may be incomplete
+  void setValueOnly(bool otherValueOnly)
+  {
+    valueOnly = otherValueOnly;
+  }
+
+  /// Mark that generated elements are collected to results, they are needed only if the manager has sinks
+  void setCollectsGeneratedElements(bool otherCollectsGeneratedElements)
+  {
+    collectsGeneratedElements = otherCollectsGeneratedElements;
+  }
+
 protected:
+  bool valueOnly = false;
+  bool collectsGeneratedElements = false;
   ScAddrVector argumentVector;
   std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> outputStructureElements;
 };
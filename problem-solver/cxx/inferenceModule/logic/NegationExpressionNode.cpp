@@ -8,6 +8,8 @@
 
 NegationExpressionNode::NegationExpressionNode(std::shared_ptr<LogicExpressionNode> operand)
 {
+  // Negation inverts only the value of its operand
+  operand->setValueOnly(true);
   operands.emplace_back(std::move(operand));
 }
 
@@ -7,6 +7,7 @@
 #include "TemplateExpressionNode.hpp"
 
 #include "inferenceConfig/InferenceConfig.hpp"
+#include "utils/ReplacementsUnion.hpp"
 
 #include "sc-agents-common/utils/GenerationUtils.hpp"
 
@@ -29,7 +30,7 @@ TemplateExpressionNode::TemplateExpressionNode(
 void TemplateExpressionNode::compute(LogicFormulaResult & result) const
 {
   Replacements replacements;
-  std::set<std::string> varNames;
+  VarNames varNames;
   templateSearcher->getVarNames(formula, varNames);
   // Template params should be created only if argument vector is not empty. Else search with any possible replacements
   if (!argumentVector.empty())
@@ -54,7 +55,7 @@ LogicFormulaResult TemplateExpressionNode::find(Replacements & replacements) con
   LogicFormulaResult result;
   std::vector<ScTemplateParams> paramsVector = ReplacementsUtils::getReplacementsToScTemplateParams(replacements);
   Replacements resultReplacements;
-  std::set<std::string> varNames;
+  VarNames varNames;
   templateSearcher->getVarNames(formula, varNames);
   templateSearcher->searchTemplate(formula, paramsVector, varNames, resultReplacements);
   result.replacements = resultReplacements;
@@ -66,6 +67,17 @@ LogicFormulaResult TemplateExpressionNode::find(Replacements & replacements) con
   return result;
 }
 
+/// @returns true if the variable has an empty replacement in the column, it is padded by union and stays unbound
+bool TemplateExpressionNode::isPadded(
+    Replacements const & replacements,
+    std::string const & varName,
+    size_t columnIndex)
+{
+  auto const & varReplacements = replacements.find(varName);
+  return varReplacements != replacements.cend() && columnIndex < varReplacements->second.size() &&
+         !varReplacements->second[columnIndex].IsValid();
+}
+
 /**
  * @brief Generate atomic logical formula using replacements
  * @param replacements variables and ScAddrs to use in generation
@@ -83,14 +95,18 @@ LogicFormulaResult TemplateExpressionNode::generate(Replacements & replacements)
     return result;
   }
 
-  std::set<std::string> varNames;
+  VarNames varNames;
   ReplacementsUtils::getKeySet(replacements, varNames);
   templateSearcher->getVarNames(formula, varNames);
 
   size_t count = 0;
   Replacements searchResult;
-  for (ScTemplateParams const & scTemplateParams : paramsVector)
+  ReplacementsUnion generatedReplacements;
+  // Replacements of a generated column, they are reused by every column instead of being allocated again
+  Replacements columnReplacements;
+  for (size_t columnIndex = 0; columnIndex < paramsVector.size(); ++columnIndex)
   {
+    ScTemplateParams const & scTemplateParams = paramsVector[columnIndex];
     if (templateManager->getReplacementsUsingType() == REPLACEMENTS_FIRST && result.isGenerated)
       break;
 
@@ -111,10 +127,10 @@ LogicFormulaResult TemplateExpressionNode::generate(Replacements & replacements)
         ++count;
         result.isGenerated = true;
         result.value = true;
-        Replacements temporalReplacements;
         for (std::string const & name : varNames)
         {
-          ScAddrVector replacementsVector;
+          ScAddrVector & replacementsVector = columnReplacements[name];
+          replacementsVector.clear();
           ScAddr outAddr;
           generationResult.Get(name, outAddr);
           bool const generationHasVar = outAddr.IsValid();
@@ -124,18 +140,40 @@ LogicFormulaResult TemplateExpressionNode::generate(Replacements & replacements)
             replacementsVector.push_back(generationResult[name]);
           else if (paramsHaveVar)
             replacementsVector.push_back(outResult);
+          else if (isPadded(replacements, name, columnIndex))
+          {
+            // Variable is not in the formula and its replacement was padded by union, so keep it padded
+            replacementsVector.emplace_back();
+          }
           else
             SC_THROW_EXCEPTION(
                 utils::ExceptionInvalidState,
                 "generation result and template params do not have replacement for " << name);
-          temporalReplacements[name] = replacementsVector;
         }
-        result.replacements = ReplacementsUtils::uniteReplacements(result.replacements, temporalReplacements);
+        generatedReplacements.add(columnReplacements);
       }
 
+      // Elements of params and constants of the formula are in memory already, other generated elements are created
+      std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> paramsElements;
+      if (collectsGeneratedElements)
+      {
+        for (std::string const & name : varNames)
+        {
+          ScAddr paramsElement;
+          if (scTemplateParams.Get(name, paramsElement))
+            paramsElements.insert(paramsElement);
+        }
+      }
       for (size_t i = 0; i < generationResult.Size(); ++i)
       {
         ScAddr const & generatedElement = generationResult[i];
+        if (collectsGeneratedElements)
+        {
+          result.generatedElements.push_back(generatedElement);
+          if (paramsElements.count(generatedElement) == 0 &&
+              !context->HelperCheckEdge(formula, generatedElement, ScType::EdgeAccessConstPosPerm))
+            result.createdElements.push_back(generatedElement);
+        }
         if (outputStructureElements.find(generatedElement) == outputStructureElements.cend())
         {
           context->CreateEdge(ScType::EdgeAccessConstPosPerm, outputStructure, generatedElement);
@@ -145,6 +183,7 @@ LogicFormulaResult TemplateExpressionNode::generate(Replacements & replacements)
     }
   }
 
+  result.replacements = generatedReplacements.getReplacements();
   SC_LOG_DEBUG(
       "Atomic logical formula " << context->HelperGetSystemIdtf(formula) << " is generated " << count << " times");
 
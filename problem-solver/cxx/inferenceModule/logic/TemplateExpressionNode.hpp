@@ -38,6 +38,8 @@ public:
   }
 
 private:
+  static bool isPadded(Replacements const & replacements, std::string const & varName, size_t columnIndex);
+
   ScMemoryContext * context;
 
   std::shared_ptr<TemplateSearcherAbstract> templateSearcher;
@@ -0,0 +1,111 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "TransitiveClosureExpressionNode.hpp"
+
+#include <queue>
+#include <utility>
+
+TransitiveClosureExpressionNode::TransitiveClosureExpressionNode(
+    ScMemoryContext * context,
+    std::shared_ptr<TemplateSearcherAbstract> templateSearcher,
+    ScAddr const & outputStructure,
+    FormulaClassifier::TransitivityRule const & rule)
+  : context(context)
+  , templateSearcher(std::move(templateSearcher))
+  , outputStructure(outputStructure)
+  , rule(rule)
+  , sourceVariableName(context->HelperGetSystemIdtf(rule.sourceVariable))
+  , targetVariableName(context->HelperGetSystemIdtf(rule.targetVariable))
+{
+}
+
+/**
+ * @brief Generate every pair of the transitive closure of the relation which is not found
+ * @param result is a LogicFormulaResult{bool: value, value: isGenerated, Replacements: replacements}, replacements
+ * are ends of generated pairs
+ */
+void TransitiveClosureExpressionNode::compute(LogicFormulaResult & result) const
+{
+  ScAddrSuccessors const successors = findSuccessors();
+
+  std::vector<std::pair<ScAddr, ScAddr>> missingPairs;
+  for (auto const & elementSuccessors : successors)
+  {
+    ScAddr const & source = elementSuccessors.first;
+    std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> const pairsTargets(
+        elementSuccessors.second.cbegin(), elementSuccessors.second.cend());
+    std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> reachedElements;
+    std::queue<ScAddr> elementsQueue;
+    for (ScAddr const & target : elementSuccessors.second)
+    {
+      if (reachedElements.insert(target).second)
+        elementsQueue.push(target);
+    }
+
+    while (!elementsQueue.empty())
+    {
+      ScAddr const element = elementsQueue.front();
+      elementsQueue.pop();
+      if (pairsTargets.find(element) == pairsTargets.cend())
+        missingPairs.emplace_back(source, element);
+
+      auto const & nextSuccessors = successors.find(element);
+      if (nextSuccessors == successors.cend())
+        continue;
+      for (ScAddr const & target : nextSuccessors->second)
+      {
+        if (reachedElements.insert(target).second)
+          elementsQueue.push(target);
+      }
+    }
+  }
+
+  std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> structureElements = outputStructureElements;
+  Replacements replacements;
+  ScAddrVector generatedElements;
+  ScAddrVector createdElements;
+  for (std::pair<ScAddr, ScAddr> const & missingPair : missingPairs)
+  {
+    ScAddr const & pairArc = context->CreateEdge(ScType::EdgeDCommonConst, missingPair.first, missingPair.second);
+    ScAddr const & relationArc = context->CreateEdge(ScType::EdgeAccessConstPosPerm, rule.relation, pairArc);
+    if (collectsGeneratedElements)
+    {
+      createdElements.push_back(pairArc);
+      createdElements.push_back(relationArc);
+    }
+    for (ScAddr const & element : {missingPair.first, missingPair.second, rule.relation, pairArc, relationArc})
+    {
+      if (collectsGeneratedElements)
+        generatedElements.push_back(element);
+      if (structureElements.insert(element).second)
+        context->CreateEdge(ScType::EdgeAccessConstPosPerm, outputStructure, element);
+    }
+
+    if (!sourceVariableName.empty())
+      replacements[sourceVariableName].push_back(missingPair.first);
+    if (!targetVariableName.empty())
+      replacements[targetVariableName].push_back(missingPair.second);
+  }
+
+  // The rule is true for the closure, so its value doesn't depend on generated pairs
+  result.value = true;
+  result.isGenerated = !missingPairs.empty();
+  result.replacements = std::move(replacements);
+  result.generatedElements = std::move(generatedElements);
+  result.createdElements = std::move(createdElements);
+  SC_LOG_DEBUG(
+      "Transitive closure of " << context->HelperGetSystemIdtf(rule.relation) << " is generated by "
+                               << missingPairs.size() << " pairs");
+}
+
+TransitiveClosureExpressionNode::ScAddrSuccessors TransitiveClosureExpressionNode::findSuccessors() const
+{
+  ScAddrSuccessors successors;
+  for (std::pair<ScAddr, ScAddr> const & pair : templateSearcher->findRelationPairs(context, rule.relation))
+    successors[pair.first].push_back(pair.second);
+  return successors;
+}
@@ -0,0 +1,57 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "LogicExpressionNode.hpp"
+
+#include "classifier/FormulaClassifier.hpp"
+#include "searcher/templateSearcher/TemplateSearcherAbstract.hpp"
+
+using namespace inference;
+
+/**
+ * Operator of a transitivity rule. Instead of using the rule again after every generated pair, pairs of the relation
+ * are read once, closure is found by breadth-first search from every element and missing pairs are generated together
+ */
+class TransitiveClosureExpressionNode : public LogicExpressionNode
+{
+public:
+  TransitiveClosureExpressionNode(
+      ScMemoryContext * context,
+      std::shared_ptr<TemplateSearcherAbstract> templateSearcher,
+      ScAddr const & outputStructure,
+      FormulaClassifier::TransitivityRule const & rule);
+
+  void compute(LogicFormulaResult & result) const override;
+
+  LogicFormulaResult generate(Replacements & replacements) override
+  {
+    return {false, false, {}};
+  }
+
+  ScAddr getFormula() const override
+  {
+    return {};
+  }
+
+private:
+  using ScAddrSuccessors = std::map<ScAddr, ScAddrVector, ScAddLessFunc>;
+
+  /// Pairs of the relation found by the searcher, elements are ordered to generate pairs in the same order
+  ScAddrSuccessors findSuccessors() const;
+
+  ScMemoryContext * context;
+  std::shared_ptr<TemplateSearcherAbstract> templateSearcher;
+  ScAddr outputStructure;
+  FormulaClassifier::TransitivityRule rule;
+  std::string sourceVariableName;
+  std::string targetVariableName;
+};
@@ -6,7 +6,10 @@
 
 #include "DirectInferenceManagerAll.hpp"
 
+#include <numeric>
+
 #include "keynodes/InferenceKeynodes.hpp"
+#include "utils/ReplacementsUtils.hpp"
 
 using namespace inference;
 
@@ -17,26 +20,37 @@ DirectInferenceManagerAll::DirectInferenceManagerAll(ScMemoryContext * context)
 
 bool DirectInferenceManagerAll::applyInference(InferenceParams const & inferenceParamsConfig)
 {
+  MonotonicArena::Scope const arenaScope(arena);
+  startInference();
+
   bool result = false;
 
   templateManager->setArguments(inferenceParamsConfig.arguments);
   templateSearcher->setInputStructures(inferenceParamsConfig.inputStructures);
+  buildIdentityClasses(inferenceParamsConfig.inputStructures);
 
   vector<ScAddrQueue> formulasQueuesByPriority = createFormulasQueuesListByPriority(inferenceParamsConfig.formulasSet);
   if (formulasQueuesByPriority.empty())
   {
     SC_THROW_EXCEPTION(utils::ExceptionItemNotFound, "No formulas sets found.");
   }
-
   ScAddrQueue uncheckedFormulas;
   ScAddr formula;
   LogicFormulaResult formulaResult;
   SC_LOG_DEBUG("Start formulas applying. There is " << formulasQueuesByPriority.size() << " formulas sets");
-  for (size_t formulasQueueIndex = 0; formulasQueueIndex < formulasQueuesByPriority.size(); formulasQueueIndex++)
+  for (size_t formulasQueueIndex = 0; formulasQueueIndex < formulasQueuesByPriority.size() && !isCancelled();
+       formulasQueueIndex++)
   {
     uncheckedFormulas = formulasQueuesByPriority[formulasQueueIndex];
+    buildClassHierarchy(uncheckedFormulas);
     SC_LOG_DEBUG("There is " << uncheckedFormulas.size() << " formulas in " << (formulasQueueIndex + 1) << " set");
-    while (!uncheckedFormulas.empty())
+    if (isConcurrent())
+    {
+      result = applyFormulasConcurrently(uncheckedFormulas, inferenceParamsConfig.outputStructure) || result;
+      continue;
+    }
+
+    while (!uncheckedFormulas.empty() && !isCancelled())
     {
       formula = uncheckedFormulas.front();
       SC_LOG_DEBUG("Trying to generate by formula: " << context->HelperGetSystemIdtf(formula));
@@ -45,7 +59,7 @@ bool DirectInferenceManagerAll::applyInference(InferenceParams const & inference
       if (formulaResult.isGenerated)
       {
         result = true;
-        solutionTreeManager->addNode(formula, formulaResult.replacements);
+        commitFiring(formula, formulaResult);
       }
 
       uncheckedFormulas.pop();
@@ -54,3 +68,48 @@ bool DirectInferenceManagerAll::applyInference(InferenceParams const & inference
 
   return result;
 }
+
+/**
+ * Formulas of a level are used concurrently, generated formulas are added to the solution tree in order of the level.
+ * In ordered commit mode formulas are committed in order of the level, so knowledge base is the same as after
+ * sequential inference
+ */
+bool DirectInferenceManagerAll::applyFormulasConcurrently(ScAddrQueue formulasQueue, ScAddr const & outputStructure)
+{
+  ScAddrVector formulas;
+  formulas.reserve(formulasQueue.size());
+  for (; !formulasQueue.empty(); formulasQueue.pop())
+    formulas.push_back(formulasQueue.front());
+
+  bool result = false;
+  if (orderedCommit)
+  {
+    std::vector<size_t> formulasIndices(formulas.size());
+    std::iota(formulasIndices.begin(), formulasIndices.end(), 0);
+    useFormulasInOrder(
+        FormulasDependencyGraph(context, formulas),
+        formulas,
+        formulasIndices,
+        outputStructure,
+        [this, &formulas, &result](size_t formulaIndex, LogicFormulaResult & formulaResult) {
+          if (formulaResult.isGenerated)
+          {
+            result = true;
+            commitFiring(formulas[formulaIndex], formulaResult);
+          }
+          return !isCancelled();
+        });
+    return result;
+  }
+
+  std::vector<LogicFormulaResult> const formulasResults = useFormulasConcurrently(formulas, outputStructure);
+  for (size_t formulaIndex = 0; formulaIndex < formulas.size(); ++formulaIndex)
+  {
+    if (formulasResults[formulaIndex].isGenerated)
+    {
+      result = true;
+      commitFiring(formulas[formulaIndex], formulasResults[formulaIndex]);
+    }
+  }
+  return result;
+}
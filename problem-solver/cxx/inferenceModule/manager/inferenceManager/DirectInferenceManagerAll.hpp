@@ -30,5 +30,8 @@ public:
   explicit DirectInferenceManagerAll(ScMemoryContext * context);
 
   bool applyInference(InferenceParams const & inferenceParamsConfig) override;
+
+private:
+  bool applyFormulasConcurrently(ScAddrQueue formulasQueue, ScAddr const & outputStructure);
 };
 }  // namespace inference
@@ -0,0 +1,149 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "DirectInferenceManagerBestFirst.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+#include "utils/ReplacementsUtils.hpp"
+
+using namespace inference;
+
+DirectInferenceManagerBestFirst::DirectInferenceManagerBestFirst(ScMemoryContext * context)
+  : DirectInferenceManagerTarget(context)
+{
+}
+
+void DirectInferenceManagerBestFirst::setFrontierSize(size_t otherFrontierSize)
+{
+  frontierSize = std::max<size_t>(otherFrontierSize, 1);
+}
+
+bool DirectInferenceManagerBestFirst::Estimation::operator<(Estimation const & other) const
+{
+  return std::make_tuple(isBlocked, distance, other.uncoveredPredicatesAmount, formulaIndex) <
+         std::make_tuple(other.isBlocked, other.distance, uncoveredPredicatesAmount, other.formulaIndex);
+}
+
+/**
+ * @brief Use the most promising formula of the frontier until the target is achieved or the frontier and the backlog
+ * are empty. A formula which has generated adds formulas depending on it to the frontier, the least promising formula
+ * is moved to the backlog if the frontier is full. The empty frontier is refilled by the most promising formulas of the
+ * backlog
+ * @returns true if the target is achieved
+ */
+bool DirectInferenceManagerBestFirst::applyFormulasLevel(ScAddrVector const & formulas, ScAddr const & outputStructure)
+{
+  FormulasDependencyGraph const dependencyGraph(context, formulas);
+  FormulasDependencyGraph::Predicates const targetPredicates = getTargetsPredicates(dependencyGraph);
+  std::vector<size_t> const distances = dependencyGraph.findDistances(targetPredicates);
+  std::set<ScAddr, ScAddLessFunc> uncoveredPredicates = targetPredicates.searched;
+
+  std::vector<Estimation> frontier;
+  std::vector<bool> isInFrontier(formulas.size(), false);
+  // Formulas which don't fit into the full frontier, they are estimated again when the frontier is refilled
+  std::set<size_t> backlog;
+  std::vector<bool> isUsed(formulas.size(), false);
+  auto const addToFrontier = [&](size_t formulaIndex) {
+    if (distances[formulaIndex] == FormulasDependencyGraph::INFINITE_DISTANCE || isInFrontier[formulaIndex])
+      return;
+
+    Estimation const estimation = estimate(dependencyGraph, distances, uncoveredPredicates, formulaIndex);
+    if (frontier.size() == frontierSize)
+    {
+      auto const leastPromisingFormula = std::max_element(frontier.begin(), frontier.end());
+      if (*leastPromisingFormula < estimation)
+      {
+        backlog.insert(formulaIndex);
+        return;
+      }
+      backlog.insert(leastPromisingFormula->formulaIndex);
+      isInFrontier[leastPromisingFormula->formulaIndex] = false;
+      frontier.erase(leastPromisingFormula);
+    }
+    backlog.erase(formulaIndex);
+    frontier.push_back(estimation);
+    isInFrontier[formulaIndex] = true;
+  };
+
+  for (size_t formulaIndex = 0; formulaIndex < formulas.size(); ++formulaIndex)
+    addToFrontier(formulaIndex);
+
+  bool targetAchieved = false;
+  while (!targetAchieved && !isCancelled())
+  {
+    if (frontier.empty())
+    {
+      if (backlog.empty())
+        break;
+      std::set<size_t> const backlogFormulas = std::move(backlog);
+      backlog.clear();
+      for (size_t formulaIndex : backlogFormulas)
+        addToFrontier(formulaIndex);
+    }
+
+    auto const mostPromisingFormula = std::min_element(frontier.begin(), frontier.end());
+    size_t const formulaIndex = mostPromisingFormula->formulaIndex;
+    frontier.erase(mostPromisingFormula);
+    isInFrontier[formulaIndex] = false;
+    isUsed[formulaIndex] = true;
+
+    ScAddr const & formula = formulas[formulaIndex];
+    SC_LOG_DEBUG(
+        "Trying to generate by formula: " << context->HelperGetSystemIdtf(formula) << " with distance "
+                                          << distances[formulaIndex]);
+    LogicFormulaResult formulaResult;
+    {
+      MonotonicArena::Scope const formulaArenaScope(arena);
+      formulaResult = useFormulaInContext(context, formula, outputStructure);
+    }
+    SC_LOG_DEBUG("Logical formula is " << (formulaResult.isGenerated ? "generated" : "not generated"));
+    if (!formulaResult.isGenerated)
+      continue;
+
+    commitFiring(formula, formulaResult);
+    targetAchieved =
+        isTargetAchieved(ReplacementsUtils::getReplacementsToScTemplateParams(formulaResult.replacements));
+    for (ScAddr const & predicate : dependencyGraph.getFormulaPredicates(formulaIndex).generated)
+      uncoveredPredicates.erase(predicate);
+    // Generated knowledge may unblock formulas and cover predicates, so the frontier is estimated once per expansion
+    for (Estimation & estimation : frontier)
+      estimation = estimate(dependencyGraph, distances, uncoveredPredicates, estimation.formulaIndex);
+    for (size_t dependentFormulaIndex : dependencyGraph.getDependentFormulas(formulaIndex))
+      addToFrontier(dependentFormulaIndex);
+  }
+
+  // Skipped formulas can't lead to the target or were not used before the target was achieved
+  size_t const skippedAmount = std::count(isUsed.cbegin(), isUsed.cend(), false);
+  skippedFormulasAmount += skippedAmount;
+  SC_LOG_DEBUG("Best-first inference has not used " << skippedAmount << " of " << formulas.size() << " formulas");
+  if (targetAchieved)
+    SC_LOG_DEBUG("Target is achieved");
+  return targetAchieved;
+}
+
+DirectInferenceManagerBestFirst::Estimation DirectInferenceManagerBestFirst::estimate(
+    FormulasDependencyGraph const & dependencyGraph,
+    std::vector<size_t> const & distances,
+    std::set<ScAddr, ScAddLessFunc> const & uncoveredPredicates,
+    size_t formulaIndex) const
+{
+  FormulasDependencyGraph::Predicates const & predicates = dependencyGraph.getFormulaPredicates(formulaIndex);
+  size_t const uncoveredPredicatesAmount = std::count_if(
+      predicates.generated.cbegin(), predicates.generated.cend(), [&uncoveredPredicates](ScAddr const & predicate) {
+        return uncoveredPredicates.count(predicate) > 0;
+      });
+  return {isBlocked(predicates), distances[formulaIndex], uncoveredPredicatesAmount, formulaIndex};
+}
+
+bool DirectInferenceManagerBestFirst::isBlocked(FormulasDependencyGraph::Predicates const & formulaPredicates) const
+{
+  return std::any_of(
+      formulaPredicates.searched.cbegin(), formulaPredicates.searched.cend(), [this](ScAddr const & predicate) {
+        return !context->Iterator3(predicate, ScType::EdgeAccessConstPosPerm, ScType::Unknown)->Next();
+      });
+}
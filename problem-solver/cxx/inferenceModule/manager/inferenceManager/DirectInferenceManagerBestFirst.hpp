@@ -0,0 +1,58 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "DirectInferenceManagerTarget.hpp"
+
+namespace inference
+{
+/**
+ * Inference manager that uses formulas of a level in order of their estimated distance to the target instead of order
+ * of the level. Distance of a formula is the least amount of dependencies from it to a formula which generates
+ * predicates of the target (see FormulasDependencyGraph), formulas which can't lead to the target are not used.
+ * Formulas waiting to be used are a bounded frontier, a formula is added to it again when a formula it depends on has
+ * generated. Formulas which don't fit into the frontier wait in a backlog and refill the frontier when it is empty, so
+ * every formula which can lead to the target is used before inference stops. Formulas are used sequentially by the
+ * context of the manager
+ */
+class DirectInferenceManagerBestFirst : public DirectInferenceManagerTarget
+{
+public:
+  explicit DirectInferenceManagerBestFirst(ScMemoryContext * context);
+
+  void setFrontierSize(size_t otherFrontierSize);
+
+protected:
+  bool applyFormulasLevel(ScAddrVector const & formulas, ScAddr const & outputStructure) override;
+
+private:
+  /// Estimation of a formula of the frontier, the least one is the most promising. It is stored in the frontier and
+  /// computed again only after a formula has generated
+  struct Estimation
+  {
+    /// Premise of the formula has no constructions to be found
+    bool isBlocked;
+    size_t distance;
+    /// Predicates of the target generated by the formula and not generated yet, more is better
+    size_t uncoveredPredicatesAmount;
+    size_t formulaIndex;
+
+    bool operator<(Estimation const & other) const;
+  };
+
+  Estimation estimate(
+      FormulasDependencyGraph const & dependencyGraph,
+      std::vector<size_t> const & distances,
+      std::set<ScAddr, ScAddLessFunc> const & uncoveredPredicates,
+      size_t formulaIndex) const;
+
+  /// @returns true if some searched predicate of the formula has no arcs from it, so its premise can't be found
+  bool isBlocked(FormulasDependencyGraph::Predicates const & formulaPredicates) const;
+
+  size_t frontierSize = 64;
+};
+}  // namespace inference
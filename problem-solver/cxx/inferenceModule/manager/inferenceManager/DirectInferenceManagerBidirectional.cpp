@@ -0,0 +1,306 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "DirectInferenceManagerBidirectional.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "utils/ReplacementsUtils.hpp"
+
+using namespace inference;
+
+DirectInferenceManagerBidirectional::DirectInferenceManagerBidirectional(ScMemoryContext * context)
+  : DirectInferenceManagerTarget(context)
+{
+  // Constructions of firings which don't connect facts with the target are erased by created elements
+  collectsGeneratedElements = true;
+}
+
+/**
+ * @brief Search derivations of the level between facts and the target and materialize them until the target is
+ * achieved or the searches don't meet. Formulas are used sequentially by the context of the manager
+ * @returns true if the target is achieved
+ */
+bool DirectInferenceManagerBidirectional::applyFormulasLevel(
+    ScAddrVector const & formulas,
+    ScAddr const & outputStructure)
+{
+  FormulasDependencyGraph const dependencyGraph(context, formulas);
+  ScAddrVector const knowledgeStructures = templateSearcher->getInputStructures();
+  std::set<size_t> materializedFormulasIndices;
+  bool targetAchieved = false;
+  while (!targetAchieved && !isCancelled())
+  {
+    std::vector<size_t> const distances = dependencyGraph.findDistances(getTargetsPredicates(dependencyGraph));
+    ScAddr const & scratchStructure = context->CreateNode(ScType::NodeConstStruct);
+    ScAddrVector searchStructures = knowledgeStructures;
+    searchStructures.push_back(scratchStructure);
+    templateSearcher->setInputStructures(searchStructures);
+
+    std::vector<Firing> firings;
+    size_t meetingFiringIndex = 0;
+    bool const isMet = searchDerivation(
+        formulas,
+        dependencyGraph,
+        distances,
+        materializedFormulasIndices,
+        scratchStructure,
+        firings,
+        meetingFiringIndex);
+    templateSearcher->setInputStructures(knowledgeStructures);
+    if (isMet)
+    {
+      targetAchieved = materializeDerivation(
+          formulas,
+          dependencyGraph,
+          distances,
+          firings,
+          meetingFiringIndex,
+          outputStructure,
+          materializedFormulasIndices);
+    }
+    else
+    {
+      // Searches haven't met, so none of their constructions connects facts with the target
+      for (Firing const & firing : firings)
+      {
+        for (ScAddr const & element : firing.result.createdElements)
+        {
+          if (context->IsElement(element))
+            context->EraseElement(element);
+        }
+      }
+    }
+    context->EraseElement(scratchStructure);
+    if (!isMet)
+      break;
+  }
+
+  skippedFormulasAmount += formulas.size() - materializedFormulasIndices.size();
+  SC_LOG_DEBUG("There is " << materializedFormulasIndices.size() << " formulas of the level in derivations");
+  return targetAchieved;
+}
+
+bool DirectInferenceManagerBidirectional::searchDerivation(
+    ScAddrVector const & formulas,
+    FormulasDependencyGraph const & dependencyGraph,
+    std::vector<size_t> const & distances,
+    std::set<size_t> const & materializedFormulasIndices,
+    ScAddr const & scratchStructure,
+    std::vector<Firing> & firings,
+    size_t & meetingFiringIndex)
+{
+  // The forward search starts from formulas which premises may be found in facts
+  std::set<size_t> factsFormulasIndices;
+  size_t maxDistance = 0;
+  for (size_t formulaIndex = 0; formulaIndex < formulas.size(); ++formulaIndex)
+  {
+    if (materializedFormulasIndices.count(formulaIndex) != 0)
+      continue;
+    if (hasFacts(dependencyGraph.getFormulaPredicates(formulaIndex)))
+      factsFormulasIndices.insert(formulaIndex);
+    if (distances[formulaIndex] != FormulasDependencyGraph::INFINITE_DISTANCE)
+      maxDistance = std::max(maxDistance, distances[formulaIndex]);
+  }
+
+  // A formula which has generated is not used again by the search, as by the target manager
+  std::vector<bool> isFired(formulas.size(), false);
+  std::vector<size_t> formulasFirings(formulas.size(), 0);
+  auto const fire = [this, &formulas, &scratchStructure, &firings, &isFired, &formulasFirings](size_t formulaIndex) {
+    SC_LOG_DEBUG("Trying to generate by formula: " << context->HelperGetSystemIdtf(formulas[formulaIndex]));
+    LogicFormulaResult formulaResult;
+    {
+      MonotonicArena::Scope const formulaArenaScope(arena);
+      formulaResult = useFormulaInContext(context, formulas[formulaIndex], scratchStructure);
+    }
+    if (!formulaResult.isGenerated)
+      return false;
+    isFired[formulaIndex] = true;
+    formulasFirings[formulaIndex] = firings.size();
+    firings.push_back({formulaIndex, std::move(formulaResult)});
+    return true;
+  };
+
+  std::set<size_t> forwardFrontier = factsFormulasIndices;
+  // Formulas which distances are less than the depth are in the backward search
+  size_t backwardDepth = 0;
+  while (!isCancelled())
+  {
+    std::vector<size_t> backwardLayer;
+    for (size_t formulaIndex = 0; formulaIndex < formulas.size(); ++formulaIndex)
+    {
+      if (distances[formulaIndex] == backwardDepth && materializedFormulasIndices.count(formulaIndex) == 0)
+        backwardLayer.push_back(formulaIndex);
+    }
+    bool const isBackwardExhausted = backwardDepth > maxDistance;
+    if (forwardFrontier.empty() && isBackwardExhausted)
+      return false;
+
+    if (!forwardFrontier.empty() && (isBackwardExhausted || forwardFrontier.size() <= backwardLayer.size()))
+    {
+      std::set<size_t> nextForwardFrontier;
+      for (size_t formulaIndex : forwardFrontier)
+      {
+        if (isFired[formulaIndex] || !fire(formulaIndex))
+          continue;
+        // A forward fact is found by a subgoal of the backward search
+        if (distances[formulaIndex] < backwardDepth)
+        {
+          meetingFiringIndex = formulasFirings[formulaIndex];
+          SC_LOG_DEBUG("Searches meet forward at " << context->HelperGetSystemIdtf(formulas[formulaIndex]));
+          return true;
+        }
+        for (size_t dependentFormulaIndex : dependencyGraph.getDependentFormulas(formulaIndex))
+        {
+          if (!isFired[dependentFormulaIndex] && materializedFormulasIndices.count(dependentFormulaIndex) == 0)
+            nextForwardFrontier.insert(dependentFormulaIndex);
+        }
+      }
+      forwardFrontier = std::move(nextForwardFrontier);
+      continue;
+    }
+
+    for (size_t formulaIndex : backwardLayer)
+    {
+      // The formula may be fired forward before the backward search has reached it
+      if (isFired[formulaIndex])
+      {
+        meetingFiringIndex = formulasFirings[formulaIndex];
+        SC_LOG_DEBUG("Searches meet at fired " << context->HelperGetSystemIdtf(formulas[formulaIndex]));
+        return true;
+      }
+
+      // Subgoals of the formula are searched only if facts or forward firings may have constructions for them
+      auto const isDependency = [&dependencyGraph, formulaIndex](Firing const & firing) {
+        return dependencyGraph.dependsOn(formulaIndex, firing.formulaIndex);
+      };
+      bool const isReached = factsFormulasIndices.count(formulaIndex) != 0 ||
+                             std::any_of(firings.cbegin(), firings.cend(), isDependency);
+      if (isReached && fire(formulaIndex))
+      {
+        meetingFiringIndex = firings.size() - 1;
+        SC_LOG_DEBUG("Searches meet backward at " << context->HelperGetSystemIdtf(formulas[formulaIndex]));
+        return true;
+      }
+    }
+    ++backwardDepth;
+  }
+  return false;
+}
+
+bool DirectInferenceManagerBidirectional::materializeDerivation(
+    ScAddrVector const & formulas,
+    FormulasDependencyGraph const & dependencyGraph,
+    std::vector<size_t> const & distances,
+    std::vector<Firing> const & firings,
+    size_t meetingFiringIndex,
+    ScAddr const & outputStructure,
+    std::set<size_t> & materializedFormulasIndices)
+{
+  // Firings depend only on firings before them, so the connecting derivation is found from the meeting firing back
+  std::vector<bool> isConnecting(firings.size(), false);
+  isConnecting[meetingFiringIndex] = true;
+  for (size_t firingIndex = meetingFiringIndex + 1; firingIndex-- > 0;)
+  {
+    if (!isConnecting[firingIndex])
+      continue;
+    for (size_t otherFiringIndex = 0; otherFiringIndex < firingIndex; ++otherFiringIndex)
+    {
+      if (dependencyGraph.dependsOn(firings[firingIndex].formulaIndex, firings[otherFiringIndex].formulaIndex))
+        isConnecting[otherFiringIndex] = true;
+    }
+  }
+
+  // Connecting constructions may contain elements created by other firings, so they are kept
+  std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> connectingElements;
+  for (size_t firingIndex = 0; firingIndex < firings.size(); ++firingIndex)
+  {
+    if (isConnecting[firingIndex])
+      connectingElements.insert(
+          firings[firingIndex].result.generatedElements.cbegin(), firings[firingIndex].result.generatedElements.cend());
+  }
+  for (size_t firingIndex = 0; firingIndex < firings.size(); ++firingIndex)
+  {
+    if (isConnecting[firingIndex])
+      continue;
+    for (ScAddr const & element : firings[firingIndex].result.createdElements)
+    {
+      if (connectingElements.count(element) == 0 && context->IsElement(element))
+        context->EraseElement(element);
+    }
+  }
+
+  bool targetAchieved = false;
+  for (size_t firingIndex = 0; firingIndex < firings.size(); ++firingIndex)
+  {
+    if (!isConnecting[firingIndex])
+      continue;
+    Firing const & firing = firings[firingIndex];
+    for (ScAddr const & element : firing.result.generatedElements)
+    {
+      if (!context->HelperCheckEdge(outputStructure, element, ScType::EdgeAccessConstPosPerm))
+        context->CreateEdge(ScType::EdgeAccessConstPosPerm, outputStructure, element);
+    }
+    commitFiring(formulas[firing.formulaIndex], firing.result);
+    materializedFormulasIndices.insert(firing.formulaIndex);
+    targetAchieved =
+        isTargetAchieved(ReplacementsUtils::getReplacementsToScTemplateParams(firing.result.replacements)) ||
+        targetAchieved;
+  }
+  if (targetAchieved)
+  {
+    SC_LOG_DEBUG("Target is achieved");
+    return true;
+  }
+
+  // Formulas from the meeting formula to the target, every next formula depends on a formula one dependency further
+  std::set<size_t> chainFormulasIndices;
+  std::set<size_t> chainLayer = {firings[meetingFiringIndex].formulaIndex};
+  while (!chainLayer.empty())
+  {
+    std::set<size_t> nextChainLayer;
+    for (size_t formulaIndex : chainLayer)
+    {
+      if (distances[formulaIndex] == 0)
+        continue;
+      for (size_t dependentFormulaIndex : dependencyGraph.getDependentFormulas(formulaIndex))
+      {
+        if (distances[dependentFormulaIndex] == distances[formulaIndex] - 1 &&
+            materializedFormulasIndices.count(dependentFormulaIndex) == 0)
+          nextChainLayer.insert(dependentFormulaIndex);
+      }
+    }
+    chainFormulasIndices.insert(nextChainLayer.cbegin(), nextChainLayer.cend());
+    chainLayer = std::move(nextChainLayer);
+  }
+  if (chainFormulasIndices.empty())
+    return false;
+
+  ScAddrVector chainFormulas;
+  for (size_t formulaIndex : chainFormulasIndices)
+    chainFormulas.push_back(formulas[formulaIndex]);
+  materializedFormulasIndices.insert(chainFormulasIndices.cbegin(), chainFormulasIndices.cend());
+  return DirectInferenceManagerTarget::applyFormulasLevel(chainFormulas, outputStructure);
+}
+
+bool DirectInferenceManagerBidirectional::hasFacts(FormulasDependencyGraph::Predicates const & formulaPredicates) const
+{
+  if (formulaPredicates.isAnySearched)
+    return true;
+  return std::all_of(
+      formulaPredicates.searched.cbegin(), formulaPredicates.searched.cend(), [this](ScAddr const & predicate) {
+        // Arcs of the knowledge base out of input structures are not facts if search is in structures
+        ScIterator3Ptr const arcsIterator =
+            context->Iterator3(predicate, ScType::EdgeAccessConstPosPerm, ScType::Unknown);
+        while (arcsIterator->Next())
+        {
+          if (templateSearcher->isSearchable(context, arcsIterator->Get(1)))
+            return true;
+        }
+        return false;
+      });
+}
@@ -0,0 +1,74 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <set>
+
+#include "DirectInferenceManagerTarget.hpp"
+
+namespace inference
+{
+/**
+ * Inference manager that searches a derivation of a level from facts and from the target at once. The forward search
+ * uses formulas in layers from facts of input structures, constructions of its firings are generated in a scratch
+ * structure. The backward search goes from predicates of the target against dependencies of formulas (see
+ * FormulasDependencyGraph), a layer of it is formulas one dependency further from the target, their premises are
+ * subgoals. The search with the smaller frontier is expanded. Searches meet when the premise of a formula of the
+ * backward search is found in facts and constructions of the forward search. Then only the connecting derivation is
+ * materialized: forward firings the meeting firing depends on are committed to the output structure and the solution
+ * tree, constructions of other firings are erased, and formulas of the backward search from the meeting formula to the
+ * target are used as the target manager uses a level. If the target is not achieved, the search starts again with the
+ * materialized knowledge, a materialized formula is not used again in the level
+ */
+class DirectInferenceManagerBidirectional : public DirectInferenceManagerTarget
+{
+public:
+  explicit DirectInferenceManagerBidirectional(ScMemoryContext * context);
+
+protected:
+  bool applyFormulasLevel(ScAddrVector const & formulas, ScAddr const & outputStructure) override;
+
+private:
+  /// Use of a formula by the forward or the backward search which has generated in the scratch structure
+  struct Firing
+  {
+    size_t formulaIndex;
+    LogicFormulaResult result;
+  };
+
+  /**
+   * @brief Expand the forward and the backward searches until they meet, `firings` are firings of the searches in
+   * order of use
+   * @returns true if the searches have met, `meetingFiringIndex` is the index of the firing they have met at
+   */
+  bool searchDerivation(
+      ScAddrVector const & formulas,
+      FormulasDependencyGraph const & dependencyGraph,
+      std::vector<size_t> const & distances,
+      std::set<size_t> const & materializedFormulasIndices,
+      ScAddr const & scratchStructure,
+      std::vector<Firing> & firings,
+      size_t & meetingFiringIndex);
+
+  /**
+   * @brief Commit firings of the connecting derivation, erase constructions of other firings and use formulas from the
+   * meeting formula to the target
+   * @returns true if the target is achieved
+   */
+  bool materializeDerivation(
+      ScAddrVector const & formulas,
+      FormulasDependencyGraph const & dependencyGraph,
+      std::vector<size_t> const & distances,
+      std::vector<Firing> const & firings,
+      size_t meetingFiringIndex,
+      ScAddr const & outputStructure,
+      std::set<size_t> & materializedFormulasIndices);
+
+  /// @returns true if every predicate searched by the formula has searchable constructions, so its premise may be found
+  bool hasFacts(FormulasDependencyGraph::Predicates const & formulaPredicates) const;
+};
+}  // namespace inference
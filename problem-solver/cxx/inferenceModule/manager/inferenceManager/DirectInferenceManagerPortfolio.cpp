@@ -0,0 +1,262 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "DirectInferenceManagerPortfolio.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <thread>
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "searcher/templateSearcher/TemplateSearcherGeneral.hpp"
+#include "searcher/templateSearcher/TemplateSearcherInStructures.hpp"
+
+using namespace inference;
+
+namespace
+{
+/**
+ * Sink that keeps firings of a strategy until the winner is known, so sinks of the portfolio get firings of the winner
+ * and elements created by strategies which have lost are known
+ */
+class InferenceSinkRecorder : public InferenceSinkAbstract
+{
+public:
+  void onFiring(InferenceFiring const & firing) override
+  {
+    firings.push_back(firing);
+  }
+
+  std::vector<InferenceFiring> firings;
+};
+}  // namespace
+
+DirectInferenceManagerPortfolio::DirectInferenceManagerPortfolio(
+    ScMemoryContext * context,
+    InferenceConfig const & strategiesConfig)
+  : InferenceManagerAbstract(context)
+  , strategiesConfig(strategiesConfig)
+{
+  // Strategies are already concurrent
+  this->strategiesConfig.solutionTreeType = TREE_ONLY_OUTPUT_STRUCTURE;
+  this->strategiesConfig.workersAmount = 1;
+}
+
+/**
+ * @brief Run every strategy of the config in a thread of its own, the first strategy which achieves the target with
+ * its scratch structure cancels other strategies. Then the scratch structure of the winner is committed to the output
+ * structure, elements created by other strategies are erased if strategies search in structures, and scratch
+ * structures are erased
+ * @returns true if some strategy has achieved the target
+ * @throws utils::ExceptionInvalidParams Thrown if there are no strategies or portfolio is a strategy of itself
+ * @throws utils::ExceptionItemNotFound Thrown if `formulasSet` is an empty set
+ */
+bool DirectInferenceManagerPortfolio::applyInference(InferenceParams const & inferenceParamsConfig)
+{
+  MonotonicArena::Scope const arenaScope(arena);
+  startInference();
+
+  size_t const strategiesAmount = strategiesConfig.portfolioStrategies.size();
+  winnerIndex = strategiesAmount;
+  targetsResults.clear();
+  if (strategiesAmount == 0)
+  {
+    SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "No strategies of portfolio inference.");
+  }
+  if (std::find(
+          strategiesConfig.portfolioStrategies.cbegin(),
+          strategiesConfig.portfolioStrategies.cend(),
+          STRATEGY_PORTFOLIO) != strategiesConfig.portfolioStrategies.cend())
+  {
+    SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Portfolio inference can't be a strategy of itself.");
+  }
+  if (createFormulasQueuesListByPriority(inferenceParamsConfig.formulasSet).empty())
+  {
+    SC_THROW_EXCEPTION(utils::ExceptionItemNotFound, "No formulas sets found.");
+  }
+  if (isTargetAchieved(context, inferenceParamsConfig))
+  {
+    SC_LOG_DEBUG("Target is already achieved");
+    return false;
+  }
+
+  std::vector<std::unique_ptr<ScMemoryContext>> strategiesContexts;
+  std::vector<std::unique_ptr<InferenceManagerAbstract>> strategies;
+  std::vector<std::shared_ptr<InferenceSinkRecorder>> strategiesRecorders;
+  ScAddrVector scratchStructures;
+  for (size_t strategyIndex = 0; strategyIndex < strategiesAmount; ++strategyIndex)
+  {
+    strategiesContexts.push_back(std::make_unique<ScMemoryContext>(
+        sc_access_lvl_make_min, "portfolio_strategy_" + std::to_string(strategyIndex)));
+    strategies.push_back(InferenceManagerFactory::constructInferenceManager(
+        strategiesContexts.back().get(), strategiesConfig.portfolioStrategies[strategyIndex], strategiesConfig));
+    scratchStructures.push_back(context->CreateNode(ScType::NodeConstStruct));
+    strategiesRecorders.push_back(std::make_shared<InferenceSinkRecorder>());
+    strategies.back()->addSink(strategiesRecorders.back());
+  }
+  {
+    std::lock_guard<std::mutex> lock(runningStrategiesMutex);
+    for (std::unique_ptr<InferenceManagerAbstract> const & strategy : strategies)
+    {
+      runningStrategies.push_back(strategy.get());
+      // The portfolio may be cancelled before strategies are running
+      if (isCancelled())
+        strategy->cancel();
+    }
+  }
+
+  std::atomic<size_t> winner{strategiesAmount};
+  std::vector<std::exception_ptr> strategiesExceptions(strategiesAmount);
+  std::vector<std::thread> strategiesThreads;
+  strategiesThreads.reserve(strategiesAmount);
+  for (size_t strategyIndex = 0; strategyIndex < strategiesAmount; ++strategyIndex)
+  {
+    strategiesThreads.emplace_back([&, strategyIndex]() {
+      try
+      {
+        InferenceParams strategyParams = inferenceParamsConfig;
+        strategyParams.outputStructure = scratchStructures[strategyIndex];
+        strategies[strategyIndex]->applyInference(strategyParams);
+
+        size_t noWinner = strategiesAmount;
+        if (winner != strategiesAmount || !isTargetAchieved(strategiesContexts[strategyIndex].get(), strategyParams) ||
+            !winner.compare_exchange_strong(noWinner, strategyIndex))
+          return;
+        for (size_t otherStrategyIndex = 0; otherStrategyIndex < strategiesAmount; ++otherStrategyIndex)
+        {
+          if (otherStrategyIndex != strategyIndex)
+            strategies[otherStrategyIndex]->cancel();
+        }
+      }
+      catch (...)
+      {
+        strategiesExceptions[strategyIndex] = std::current_exception();
+      }
+    });
+  }
+  for (std::thread & strategyThread : strategiesThreads)
+    strategyThread.join();
+  {
+    std::lock_guard<std::mutex> lock(runningStrategiesMutex);
+    runningStrategies.clear();
+  }
+
+  winnerIndex = winner;
+  for (std::unique_ptr<InferenceManagerAbstract> const & strategy : strategies)
+    formulasUsesAmount += strategy->getProfile().formulasUsesAmount;
+  if (winnerIndex < strategiesAmount)
+  {
+    SC_LOG_DEBUG("Target is achieved by strategy " << winnerIndex);
+    skippedFormulasAmount += strategies[winnerIndex]->getProfile().skippedFormulasAmount;
+    targetsResults = strategies[winnerIndex]->getTargetsResults();
+    commitScratchStructure(scratchStructures[winnerIndex], inferenceParamsConfig.outputStructure);
+    // Sinks get firings of the winner only after its constructions are in the output structure
+    for (InferenceFiring const & firing : strategiesRecorders[winnerIndex]->firings)
+    {
+      for (std::shared_ptr<InferenceSinkAbstract> const & sink : sinks)
+        sink->onFiring(firing);
+    }
+  }
+  if (strategiesConfig.searchType == SEARCH_IN_STRUCTURES)
+  {
+    for (size_t strategyIndex = 0; strategyIndex < strategiesAmount; ++strategyIndex)
+    {
+      if (strategyIndex != winnerIndex)
+        eraseCreatedElements(strategiesRecorders[strategyIndex]->firings);
+    }
+  }
+  for (ScAddr const & scratchStructure : scratchStructures)
+    context->EraseElement(scratchStructure);
+
+  // Errors of strategies are reported only if no strategy has achieved the target
+  if (winnerIndex == strategiesAmount)
+  {
+    for (std::exception_ptr const & exception : strategiesExceptions)
+    {
+      if (exception)
+        std::rethrow_exception(exception);
+    }
+  }
+  return winnerIndex < strategiesAmount;
+}
+
+void DirectInferenceManagerPortfolio::cancel()
+{
+  std::lock_guard<std::mutex> lock(runningStrategiesMutex);
+  InferenceManagerAbstract::cancel();
+  for (InferenceManagerAbstract * strategy : runningStrategies)
+    strategy->cancel();
+}
+
+size_t DirectInferenceManagerPortfolio::getWinnerIndex() const
+{
+  return winnerIndex;
+}
+
+bool DirectInferenceManagerPortfolio::isTargetAchieved(
+    ScMemoryContext * strategyContext,
+    InferenceParams const & strategyParams) const
+{
+  std::unique_ptr<TemplateSearcherAbstract> targetSearcher;
+  if (strategiesConfig.searchType == SEARCH_IN_STRUCTURES)
+  {
+    ScAddrVector inputStructures = strategyParams.inputStructures;
+    inputStructures.push_back(strategyParams.outputStructure);
+    targetSearcher = std::make_unique<TemplateSearcherInStructures>(strategyContext, inputStructures);
+  }
+  else
+    targetSearcher = std::make_unique<TemplateSearcherGeneral>(strategyContext);
+  TemplateManager targetTemplateManager(strategyContext);
+  targetTemplateManager.setArguments(strategyParams.arguments);
+
+  auto const isAchieved = [&targetSearcher, &targetTemplateManager](ScAddr const & targetStructure) {
+    VarNames varNames;
+    targetSearcher->getVarNames(targetStructure, varNames);
+    std::vector<ScTemplateParams> const templateParamsVector =
+        targetTemplateManager.createTemplateParams(targetStructure);
+    return std::any_of(
+        templateParamsVector.cbegin(),
+        templateParamsVector.cend(),
+        [&targetSearcher, &targetStructure, &varNames](ScTemplateParams const & templateParams) {
+          Replacements result;
+          targetSearcher->searchTemplate(targetStructure, templateParams, varNames, result);
+          return !result.empty();
+        });
+  };
+
+  ScAddrVector const targetStructures = strategyParams.getTargetStructures();
+  if (strategyParams.targetsType == TARGETS_ALL)
+    return !targetStructures.empty() && std::all_of(targetStructures.cbegin(), targetStructures.cend(), isAchieved);
+  return std::any_of(targetStructures.cbegin(), targetStructures.cend(), isAchieved);
+}
+
+void DirectInferenceManagerPortfolio::commitScratchStructure(
+    ScAddr const & scratchStructure,
+    ScAddr const & outputStructure)
+{
+  ScIterator3Ptr const elementsIterator =
+      context->Iterator3(scratchStructure, ScType::EdgeAccessConstPosPerm, ScType::Unknown);
+  while (elementsIterator->Next())
+  {
+    ScAddr const & element = elementsIterator->Get(2);
+    if (!context->HelperCheckEdge(outputStructure, element, ScType::EdgeAccessConstPosPerm))
+      context->CreateEdge(ScType::EdgeAccessConstPosPerm, outputStructure, element);
+  }
+}
+
+void DirectInferenceManagerPortfolio::eraseCreatedElements(std::vector<InferenceFiring> const & firings)
+{
+  for (InferenceFiring const & firing : firings)
+  {
+    for (ScAddr const & element : firing.createdElements)
+    {
+      // An arc is erased with its ends, so it may be erased already
+      if (context->IsElement(element))
+        context->EraseElement(element);
+    }
+  }
+}
@@ -0,0 +1,53 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include "InferenceManagerAbstract.hpp"
+
+namespace inference
+{
+/**
+ * Inference manager that races strategies of the config concurrently (see InferenceConfig::portfolioStrategies). Every
+ * strategy has its own memory context and writes to its own scratch output structure. If strategies search in
+ * structures, they search in input structures and their scratch structures only, so they don't see constructions of
+ * each other. The first strategy to achieve the target wins: other strategies are cancelled, elements of the winner
+ * scratch structure are added to the output structure and elements created by other strategies are erased. If
+ * strategies search in all knowledge base, the winner may have found constructions of other strategies, so elements
+ * created by them are kept. Sinks of the portfolio are notified of firings of the winner after its elements are
+ * committed
+ */
+class DirectInferenceManagerPortfolio : public InferenceManagerAbstract
+{
+public:
+  DirectInferenceManagerPortfolio(ScMemoryContext * context, InferenceConfig const & strategiesConfig);
+
+  bool applyInference(InferenceParams const & inferenceParamsConfig) override;
+
+  /// Cancel strategies which are running
+  void cancel() override;
+
+  /// @returns index of the strategy which has achieved the target by the last inference, amount of strategies if none
+  size_t getWinnerIndex() const;
+
+private:
+  bool isTargetAchieved(ScMemoryContext * strategyContext, InferenceParams const & strategyParams) const;
+
+  void commitScratchStructure(ScAddr const & scratchStructure, ScAddr const & outputStructure);
+
+  /// Erase elements created by firings of strategies, elements of generated constructions found in memory are kept
+  void eraseCreatedElements(std::vector<InferenceFiring> const & firings);
+
+  InferenceConfig strategiesConfig;
+  size_t winnerIndex = 0;
+
+  /// Strategies of the running inference, they are cancelled with the portfolio
+  std::vector<InferenceManagerAbstract *> runningStrategies;
+  std::mutex runningStrategiesMutex;
+};
+}  // namespace inference
@@ -6,9 +6,10 @@
 
 #include "DirectInferenceManagerTarget.hpp"
 
+#include <atomic>
+
 #include "sc-agents-common/utils/IteratorUtils.hpp"
 
-#include "utils/ContainersUtils.hpp"
 #include "utils/ReplacementsUtils.hpp"
 
 using namespace inference;
@@ -20,12 +21,15 @@ DirectInferenceManagerTarget::DirectInferenceManagerTarget(ScMemoryContext * con
 
 bool DirectInferenceManagerTarget::applyInference(InferenceParams const & inferenceParamsConfig)
 {
+  MonotonicArena::Scope const arenaScope(arena);
+  startInference();
+
   templateManager->setArguments(inferenceParamsConfig.arguments);
   templateSearcher->setInputStructures(inferenceParamsConfig.inputStructures);
-  setTargetStructure(inferenceParamsConfig.targetStructure);
+  buildIdentityClasses(inferenceParamsConfig.inputStructures);
+  setTargets(inferenceParamsConfig);
 
-  std::vector<ScTemplateParams> const templateParamsVector = templateManager->createTemplateParams(targetStructure);
-  bool targetAchieved = isTargetAchieved(templateParamsVector);
+  bool targetAchieved = isTargetAchievedBeforeInference();
   if (targetAchieved)
   {
     SC_LOG_DEBUG("Target is already achieved");
@@ -37,74 +41,236 @@ bool DirectInferenceManagerTarget::applyInference(InferenceParams const & infere
   {
     SC_THROW_EXCEPTION(utils::ExceptionItemNotFound, "No formulas sets found.");
   }
-
   // Extend input structures vector with outputStructure to find target with generated elements
   ScAddrVector inputStructures = templateSearcher->getInputStructures();
   inputStructures.push_back(inferenceParamsConfig.outputStructure);
   templateSearcher->setInputStructures(inputStructures);
 
-  ScAddrVector checkedFormulas;
-  ScAddrQueue uncheckedFormulas;
-
-  ScAddr formula;
-  LogicFormulaResult formulaResult;
+  ScAddrVector formulas;
   SC_LOG_DEBUG("Start formulas applying. There is " << formulasQueuesByPriority.size() << " formulas sets");
-  for (size_t formulasQueueIndex = 0; formulasQueueIndex < formulasQueuesByPriority.size() && !targetAchieved;
+  for (size_t formulasQueueIndex = 0;
+       formulasQueueIndex < formulasQueuesByPriority.size() && !targetAchieved && !isCancelled();
        formulasQueueIndex++)
   {
-    uncheckedFormulas = formulasQueuesByPriority[formulasQueueIndex];
-    SC_LOG_DEBUG("There is " << uncheckedFormulas.size() << " formulas in " << (formulasQueueIndex + 1) << " set");
-    while (!uncheckedFormulas.empty())
+    buildClassHierarchy(formulasQueuesByPriority[formulasQueueIndex]);
+    formulas.clear();
+    for (ScAddrQueue & uncheckedFormulas = formulasQueuesByPriority[formulasQueueIndex]; !uncheckedFormulas.empty();
+         uncheckedFormulas.pop())
+      formulas.push_back(uncheckedFormulas.front());
+    SC_LOG_DEBUG("There is " << formulas.size() << " formulas in " << (formulasQueueIndex + 1) << " set");
+    targetAchieved = applyFormulasLevel(formulas, inferenceParamsConfig.outputStructure);
+  }
+
+  return targetAchieved;
+}
+
+bool DirectInferenceManagerTarget::applyFormulasLevel(ScAddrVector const & formulas, ScAddr const & outputStructure)
+{
+  return orderedCommit ? applyFormulasInOrder(formulas, outputStructure)
+                       : applyFormulasByComponents(formulas, outputStructure);
+}
+
+/**
+ * @brief Use formulas of a level by strongly connected components of their dependency graph in topological order, so
+ * a formula is used after all formulas which generate what it searches (see FormulasDependencyGraph). Formulas of a
+ * recursive component are used again while some of them generate, a formula which has generated is not used again in
+ * the level. Independent partitions of the level are used concurrently if inference is concurrent, generated formulas
+ * are added to the solution tree in order of partitions after the level
+ * @returns true if the target is achieved
+ */
+bool DirectInferenceManagerTarget::applyFormulasByComponents(
+    ScAddrVector const & formulas,
+    ScAddr const & outputStructure)
+{
+  FormulasDependencyGraph const dependencyGraph(context, formulas);
+  std::vector<FormulasDependencyGraph::Partition> const & partitions = dependencyGraph.getPartitions();
+  std::vector<std::vector<std::pair<size_t, LogicFormulaResult>>> partitionsGeneratedFormulas(partitions.size());
+  std::atomic<bool> targetAchieved{false};
+  usePartitions(
+      partitions.size(),
+      [this, &formulas, &outputStructure, &partitions, &partitionsGeneratedFormulas, &targetAchieved](
+          ScMemoryContext * formulaContext, MonotonicArena & formulaArena, size_t partitionIndex) {
+        for (FormulasDependencyGraph::Component const & component : partitions[partitionIndex].components)
+        {
+          std::vector<size_t> formulasIndices = component.formulasIndices;
+          while (!formulasIndices.empty())
+          {
+            std::vector<size_t> checkedFormulasIndices;
+            for (size_t formulaIndex : formulasIndices)
+            {
+              if (targetAchieved || isCancelled())
+                return;
+
+              ScAddr const & formula = formulas[formulaIndex];
+              SC_LOG_DEBUG("Trying to generate by formula: " << formulaContext->HelperGetSystemIdtf(formula));
+              LogicFormulaResult formulaResult;
+              {
+                MonotonicArena::Scope const formulaArenaScope(formulaArena);
+                formulaResult = useFormulaInContext(formulaContext, formula, outputStructure);
+              }
+              SC_LOG_DEBUG("Logical formula is " << (formulaResult.isGenerated ? "generated" : "not generated"));
+              if (!formulaResult.isGenerated)
+              {
+                checkedFormulasIndices.push_back(formulaIndex);
+                continue;
+              }
+
+              // We need to check target with result generated replacements, not with input
+              if (isTargetAchieved(ReplacementsUtils::getReplacementsToScTemplateParams(formulaResult.replacements)))
+              {
+                SC_LOG_DEBUG("Target is achieved");
+                targetAchieved = true;
+              }
+              partitionsGeneratedFormulas[partitionIndex].emplace_back(formulaIndex, std::move(formulaResult));
+            }
+
+            // Checked formulas are used again only if some formula of the recursive component has generated
+            if (!component.isRecursive || checkedFormulasIndices.size() == formulasIndices.size())
+              break;
+            formulasIndices = std::move(checkedFormulasIndices);
+          }
+        }
+      });
+
+  for (auto const & generatedFormulas : partitionsGeneratedFormulas)
+  {
+    for (auto const & generatedFormula : generatedFormulas)
+      commitFiring(formulas[generatedFormula.first], generatedFormula.second);
+  }
+  return targetAchieved;
+}
+
+/**
+ * @brief Use formulas of a level by components as sequential `applyFormulasByComponents` does, but premises of
+ * formulas of every pass over a component are searched concurrently and formulas are committed in order (see
+ * useFormulasInOrder). Inference stops at the same formula and with the same solution tree as sequential inference
+ * @returns true if the target is achieved
+ */
+bool DirectInferenceManagerTarget::applyFormulasInOrder(ScAddrVector const & formulas, ScAddr const & outputStructure)
+{
+  FormulasDependencyGraph const dependencyGraph(context, formulas);
+  bool targetAchieved = false;
+  for (FormulasDependencyGraph::Partition const & partition : dependencyGraph.getPartitions())
+  {
+    for (FormulasDependencyGraph::Component const & component : partition.components)
     {
-      formula = uncheckedFormulas.front();
-      SC_LOG_DEBUG("Trying to generate by formula: " << context->HelperGetSystemIdtf(formula));
-      formulaResult = useFormula(formula, inferenceParamsConfig.outputStructure);
-      SC_LOG_DEBUG("Logical formula is " << (formulaResult.isGenerated ? "generated" : "not generated"));
-      if (formulaResult.isGenerated)
+      std::vector<size_t> formulasIndices = component.formulasIndices;
+      while (!formulasIndices.empty())
       {
-        solutionTreeManager->addNode(formula, formulaResult.replacements);
-        // We need to check target with result generated replacements, not with input
-        targetAchieved =
-            isTargetAchieved(ReplacementsUtils::getReplacementsToScTemplateParams(formulaResult.replacements));
+        std::vector<size_t> checkedFormulasIndices;
+        useFormulasInOrder(
+            dependencyGraph,
+            formulas,
+            formulasIndices,
+            outputStructure,
+            [this, &formulas, &checkedFormulasIndices, &targetAchieved](
+                size_t formulaIndex, LogicFormulaResult & formulaResult) {
+              if (!formulaResult.isGenerated)
+              {
+                checkedFormulasIndices.push_back(formulaIndex);
+                return true;
+              }
+
+              targetAchieved =
+                  isTargetAchieved(ReplacementsUtils::getReplacementsToScTemplateParams(formulaResult.replacements));
+              commitFiring(formulas[formulaIndex], formulaResult);
+              return !targetAchieved && !isCancelled();
+            });
         if (targetAchieved)
         {
           SC_LOG_DEBUG("Target is achieved");
-          break;
-        }
-        else
-        {
-          ContainersUtils::addToQueue(checkedFormulas, uncheckedFormulas);
-          formulasQueueIndex = 0;
-          checkedFormulas.clear();
+          return true;
         }
-      }
-      else
-      {
-        checkedFormulas.push_back(formula);
-      }
+        if (isCancelled())
+          return false;
 
-      uncheckedFormulas.pop();
+        if (!component.isRecursive || checkedFormulasIndices.size() == formulasIndices.size())
+          break;
+        formulasIndices = std::move(checkedFormulasIndices);
+      }
     }
   }
+  return false;
+}
 
-  return targetAchieved;
+void DirectInferenceManagerTarget::setTargets(InferenceParams const & inferenceParamsConfig)
+{
+  targets.clear();
+  targetsResults.clear();
+  targetsType = inferenceParamsConfig.targetsType;
+  for (ScAddr const & targetStructure : inferenceParamsConfig.getTargetStructures())
+  {
+    Target target;
+    target.structure = targetStructure;
+    templateSearcher->getVarNames(targetStructure, target.varNames);
+    targets.push_back(std::move(target));
+    targetsResults.push_back({targetStructure, false, 0});
+  }
 }
 
-void DirectInferenceManagerTarget::setTargetStructure(ScAddr const & otherTargetStructure)
+bool DirectInferenceManagerTarget::isTargetAchievedBeforeInference()
 {
-  targetStructure = otherTargetStructure;
+  for (size_t targetIndex = 0; targetIndex < targets.size(); ++targetIndex)
+    checkTarget(targetIndex, templateManager->createTemplateParams(targets[targetIndex].structure));
+  return areTargetsAchieved();
 }
 
 bool DirectInferenceManagerTarget::isTargetAchieved(std::vector<ScTemplateParams> const & templateParamsVector)
 {
-  std::set<std::string> varNames;
-  templateSearcher->getVarNames(targetStructure, varNames);
-  return std::any_of(
+  std::lock_guard<std::mutex> const lock(targetsMutex);
+  for (size_t targetIndex = 0; targetIndex < targets.size(); ++targetIndex)
+    checkTarget(targetIndex, templateParamsVector);
+  return areTargetsAchieved();
+}
+
+void DirectInferenceManagerTarget::checkTarget(
+    size_t targetIndex,
+    std::vector<ScTemplateParams> const & templateParamsVector)
+{
+  TargetResult & targetResult = targetsResults[targetIndex];
+  if (targetResult.isAchieved)
+    return;
+
+  Target const & target = targets[targetIndex];
+  targetResult.isAchieved = std::any_of(
       templateParamsVector.cbegin(),
       templateParamsVector.cend(),
-      [this, &varNames](ScTemplateParams const & templateParams) -> bool {
+      [this, &target](ScTemplateParams const & templateParams) -> bool {
         Replacements result;
-        templateSearcher->searchTemplate(targetStructure, templateParams, varNames, result);
+        templateSearcher->searchTemplate(target.structure, templateParams, target.varNames, result);
         return !result.empty();
       });
+  if (targetResult.isAchieved)
+  {
+    targetResult.formulasUsesAmount = formulasUsesAmount;
+    SC_LOG_DEBUG(
+        "Target " << context->HelperGetSystemIdtf(target.structure) << " is achieved after "
+                  << targetResult.formulasUsesAmount << " uses of formulas");
+  }
+}
+
+bool DirectInferenceManagerTarget::areTargetsAchieved() const
+{
+  auto const isAchieved = [](TargetResult const & targetResult) {
+    return targetResult.isAchieved;
+  };
+  if (targetsType == TARGETS_ALL)
+    return !targetsResults.empty() && std::all_of(targetsResults.cbegin(), targetsResults.cend(), isAchieved);
+  return std::any_of(targetsResults.cbegin(), targetsResults.cend(), isAchieved);
+}
+
+FormulasDependencyGraph::Predicates DirectInferenceManagerTarget::getTargetsPredicates(
+    FormulasDependencyGraph const & dependencyGraph) const
+{
+  FormulasDependencyGraph::Predicates targetsPredicates;
+  for (size_t targetIndex = 0; targetIndex < targets.size(); ++targetIndex)
+  {
+    if (targetsResults[targetIndex].isAchieved)
+      continue;
+    FormulasDependencyGraph::Predicates const targetPredicates =
+        dependencyGraph.getStructurePredicates(targets[targetIndex].structure);
+    targetsPredicates.searched.insert(targetPredicates.searched.cbegin(), targetPredicates.searched.cend());
+    targetsPredicates.isAnySearched = targetsPredicates.isAnySearched || targetPredicates.isAnySearched;
+  }
+  return targetsPredicates;
 }
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "InferenceManagerAbstract.hpp"
 
 #include "sc-memory/sc_memory.hpp"
@@ -15,7 +17,10 @@
 
 namespace inference
 {
-/// Inference manager that stops iteration if the target is achieved
+/**
+ * Inference manager that stops iteration if targets are achieved: any of them or all of them by the targets type.
+ * Targets are checked after every generated formula, achieved targets are not checked again
+ */
 class DirectInferenceManagerTarget : public InferenceManagerAbstract
 {
 public:
@@ -24,10 +29,40 @@ public:
   bool applyInference(InferenceParams const & inferenceParamsConfig) override;
 
 protected:
-  ScAddr targetStructure;
+  /// Target with variables names found once before inference
+  struct Target
+  {
+    ScAddr structure;
+    /// Targets are kept after the run, so names are allocated in heap instead of the arena of the run
+    VarNames varNames{ArenaAllocator<std::string>(nullptr)};
+  };
+
+  std::vector<Target> targets;
+  TargetsType targetsType = TARGETS_ANY;
+  /// Targets are checked by formulas of concurrent partitions
+  std::mutex targetsMutex;
 
-  void setTargetStructure(ScAddr const & otherTargetStructure);
+  void setTargets(InferenceParams const & inferenceParamsConfig);
 
+  /// Check targets with their own template params before inference, @returns true if targets are achieved
+  bool isTargetAchievedBeforeInference();
+
+  /// Check targets which are not achieved yet with replacements of a formula, @returns true if targets are achieved
   bool isTargetAchieved(std::vector<ScTemplateParams> const & templateParamsVector);
+
+  /// @returns predicates searched by targets which are not achieved yet
+  FormulasDependencyGraph::Predicates getTargetsPredicates(FormulasDependencyGraph const & dependencyGraph) const;
+
+  /// Use formulas of a priority level, @returns true if the target is achieved
+  virtual bool applyFormulasLevel(ScAddrVector const & formulas, ScAddr const & outputStructure);
+
+  bool applyFormulasByComponents(ScAddrVector const & formulas, ScAddr const & outputStructure);
+
+  bool applyFormulasInOrder(ScAddrVector const & formulas, ScAddr const & outputStructure);
+
+private:
+  void checkTarget(size_t targetIndex, std::vector<ScTemplateParams> const & templateParamsVector);
+
+  bool areTargetsAchieved() const;
 };
 }  // namespace inference
@@ -0,0 +1,393 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "FormulasDependencyGraph.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <queue>
+
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+#include "sc-agents-common/utils/IteratorUtils.hpp"
+
+#include "classifier/FormulaClassifier.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+
+namespace inference
+{
+namespace
+{
+size_t const NOT_VISITED = std::numeric_limits<size_t>::max();
+}  // namespace
+
+size_t const FormulasDependencyGraph::INFINITE_DISTANCE = std::numeric_limits<size_t>::max();
+
+FormulasDependencyGraph::FormulasDependencyGraph(ScMemoryContext * context, ScAddrVector const & formulas)
+  : context(context)
+  , formulasPredicates(formulas.size())
+  , dependentFormulas(formulas.size())
+{
+  for (size_t formulaIndex = 0; formulaIndex < formulas.size(); ++formulaIndex)
+  {
+    ScAddr const & formulaRoot = utils::IteratorUtils::getAnyByOutRelation(
+        context, formulas[formulaIndex], scAgentsCommon::CoreKeynodes::rrel_main_key_sc_element);
+    if (formulaRoot.IsValid())
+      addPredicates(formulaRoot, true, false, formulasPredicates[formulaIndex]);
+  }
+
+  addDependencies();
+  findComponents();
+}
+
+std::vector<FormulasDependencyGraph::Partition> const & FormulasDependencyGraph::getPartitions() const
+{
+  return partitions;
+}
+
+bool FormulasDependencyGraph::dependsOn(size_t formulaIndex, size_t otherFormulaIndex) const
+{
+  return dependentFormulas[otherFormulaIndex].count(formulaIndex) > 0;
+}
+
+std::set<size_t> const & FormulasDependencyGraph::getDependentFormulas(size_t formulaIndex) const
+{
+  return dependentFormulas[formulaIndex];
+}
+
+FormulasDependencyGraph::Predicates const & FormulasDependencyGraph::getFormulaPredicates(size_t formulaIndex) const
+{
+  return formulasPredicates[formulaIndex];
+}
+
+FormulasDependencyGraph::Predicates FormulasDependencyGraph::getStructurePredicates(ScAddr const & structure) const
+{
+  Predicates predicates;
+  addAtomicFormulaPredicates(structure, true, false, predicates);
+  return predicates;
+}
+
+std::vector<size_t> FormulasDependencyGraph::findDistances(Predicates const & targetPredicates) const
+{
+  bool const isTargetSearching = targetPredicates.isAnySearched || !targetPredicates.searched.empty();
+  std::vector<size_t> distances(formulasPredicates.size(), INFINITE_DISTANCE);
+  std::vector<std::vector<size_t>> dependenciesFormulas(formulasPredicates.size());
+  std::queue<size_t> formulasQueue;
+  for (size_t formulaIndex = 0; formulaIndex < formulasPredicates.size(); ++formulaIndex)
+  {
+    for (size_t dependentFormulaIndex : dependentFormulas[formulaIndex])
+      dependenciesFormulas[dependentFormulaIndex].push_back(formulaIndex);
+
+    Predicates const & predicates = formulasPredicates[formulaIndex];
+    bool const isGenerating = predicates.isAnyGenerated || !predicates.generated.empty();
+    bool const isTargetGenerated =
+        (predicates.isAnyGenerated && isTargetSearching) || (targetPredicates.isAnySearched && isGenerating) ||
+        std::any_of(
+            predicates.generated.cbegin(), predicates.generated.cend(), [&targetPredicates](ScAddr const & predicate) {
+              return targetPredicates.searched.count(predicate) > 0;
+            });
+    if (isTargetGenerated)
+    {
+      distances[formulaIndex] = 0;
+      formulasQueue.push(formulaIndex);
+    }
+  }
+
+  for (; !formulasQueue.empty(); formulasQueue.pop())
+  {
+    size_t const formulaIndex = formulasQueue.front();
+    for (size_t dependencyFormulaIndex : dependenciesFormulas[formulaIndex])
+    {
+      if (distances[dependencyFormulaIndex] != INFINITE_DISTANCE)
+        continue;
+      distances[dependencyFormulaIndex] = distances[formulaIndex] + 1;
+      formulasQueue.push(dependencyFormulaIndex);
+    }
+  }
+  return distances;
+}
+
+void FormulasDependencyGraph::addPredicates(
+    ScAddr const & formula,
+    bool isSearched,
+    bool isGenerated,
+    Predicates & predicates) const
+{
+  ScAddr begin;
+  ScAddr end;
+  switch (FormulaClassifier::typeOfFormula(context, formula))
+  {
+  case FormulaClassifier::ATOMIC:
+    addAtomicFormulaPredicates(formula, isSearched, isGenerated, predicates);
+    break;
+  case FormulaClassifier::CONJUNCTION:
+  case FormulaClassifier::DISJUNCTION:
+  case FormulaClassifier::NEGATION:
+  {
+    ScIterator3Ptr const operandsIterator =
+        context->Iterator3(formula, ScType::EdgeAccessConstPosPerm, ScType::Unknown);
+    while (operandsIterator->Next())
+      addPredicates(operandsIterator->Get(2), isSearched, isGenerated, predicates);
+    break;
+  }
+  // Conclusion is searched by generation of unique formulas too, but only to skip generated constructions
+  case FormulaClassifier::IMPLICATION_EDGE:
+    context->GetEdgeInfo(formula, begin, end);
+    addPredicates(begin, true, false, predicates);
+    addPredicates(end, false, true, predicates);
+    break;
+  case FormulaClassifier::IMPLICATION_TUPLE:
+    begin = utils::IteratorUtils::getAnyByOutRelation(context, formula, InferenceKeynodes::rrel_if);
+    end = utils::IteratorUtils::getAnyByOutRelation(context, formula, InferenceKeynodes::rrel_then);
+    if (begin.IsValid())
+      addPredicates(begin, true, false, predicates);
+    if (end.IsValid())
+      addPredicates(end, false, true, predicates);
+    break;
+  case FormulaClassifier::EQUIVALENCE_EDGE:
+    context->GetEdgeInfo(formula, begin, end);
+    addPredicates(begin, true, true, predicates);
+    addPredicates(end, true, true, predicates);
+    break;
+  case FormulaClassifier::EQUIVALENCE_TUPLE:
+  {
+    ScIterator3Ptr const operandsIterator =
+        context->Iterator3(formula, ScType::EdgeAccessConstPosPerm, ScType::Unknown);
+    while (operandsIterator->Next())
+      addPredicates(operandsIterator->Get(2), true, true, predicates);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+void FormulasDependencyGraph::addAtomicFormulaPredicates(
+    ScAddr const & formula,
+    bool isSearched,
+    bool isGenerated,
+    Predicates & predicates) const
+{
+  ScIterator3Ptr const elementsIterator = context->Iterator3(formula, ScType::EdgeAccessConstPosPerm, ScType::Unknown);
+  ScAddr begin;
+  ScAddr end;
+  bool hasAccessArcs = false;
+  ScAddrVector commonArcs;
+  std::set<ScAddr, ScAddLessFunc> relationArcs;
+  while (elementsIterator->Next())
+  {
+    ScAddr const & element = elementsIterator->Get(2);
+    ScType const & elementType = context->GetElementType(element);
+    if (!elementType.IsEdge())
+      continue;
+    if (!elementType.BitAnd(*ScType::EdgeAccess))
+    {
+      commonArcs.push_back(element);
+      continue;
+    }
+
+    hasAccessArcs = true;
+    context->GetEdgeInfo(element, begin, end);
+    ScType const & beginType = context->GetElementType(begin);
+    if (beginType.IsConst())
+    {
+      relationArcs.insert(end);
+      if (isSearched)
+        predicates.searched.insert(begin);
+      if (isGenerated)
+        predicates.generated.insert(begin);
+    }
+    else
+    {
+      predicates.isAnySearched = predicates.isAnySearched || isSearched;
+      predicates.isAnyGenerated = predicates.isAnyGenerated || isGenerated;
+    }
+  }
+
+  // Constructions without access arcs or common arcs without a relation have no predicates to be found by, so the
+  // formula may search or generate anything as a formula with a variable predicate
+  bool const hasArcsWithoutRelation =
+      std::any_of(commonArcs.cbegin(), commonArcs.cend(), [&relationArcs](ScAddr const & commonArc) {
+        return relationArcs.count(commonArc) == 0;
+      });
+  if (!hasAccessArcs || hasArcsWithoutRelation)
+  {
+    predicates.isAnySearched = predicates.isAnySearched || isSearched;
+    predicates.isAnyGenerated = predicates.isAnyGenerated || isGenerated;
+  }
+}
+
+void FormulasDependencyGraph::addDependencies()
+{
+  std::map<ScAddr, std::vector<size_t>, ScAddLessFunc> searchingFormulas;
+  for (size_t formulaIndex = 0; formulaIndex < formulasPredicates.size(); ++formulaIndex)
+  {
+    for (ScAddr const & predicate : formulasPredicates[formulaIndex].searched)
+      searchingFormulas[predicate].push_back(formulaIndex);
+  }
+
+  for (size_t formulaIndex = 0; formulaIndex < formulasPredicates.size(); ++formulaIndex)
+  {
+    Predicates const & predicates = formulasPredicates[formulaIndex];
+    for (ScAddr const & predicate : predicates.generated)
+    {
+      auto const & formulasIndices = searchingFormulas.find(predicate);
+      if (formulasIndices != searchingFormulas.cend())
+        dependentFormulas[formulaIndex].insert(formulasIndices->second.cbegin(), formulasIndices->second.cend());
+    }
+
+    bool const isGenerating = predicates.isAnyGenerated || !predicates.generated.empty();
+    for (size_t otherFormulaIndex = 0; otherFormulaIndex < formulasPredicates.size(); ++otherFormulaIndex)
+    {
+      Predicates const & otherPredicates = formulasPredicates[otherFormulaIndex];
+      bool const isOtherSearching = otherPredicates.isAnySearched || !otherPredicates.searched.empty();
+      if ((predicates.isAnyGenerated && isOtherSearching) || (isGenerating && otherPredicates.isAnySearched))
+        dependentFormulas[formulaIndex].insert(otherFormulaIndex);
+    }
+  }
+}
+
+void FormulasDependencyGraph::findComponents()
+{
+  size_t const formulasAmount = dependentFormulas.size();
+  visitIndices.assign(formulasAmount, NOT_VISITED);
+  lowLinks.assign(formulasAmount, 0);
+  isOnStack.assign(formulasAmount, false);
+
+  std::vector<std::vector<size_t>> components;
+  for (size_t formulaIndex = 0; formulaIndex < formulasAmount; ++formulaIndex)
+  {
+    if (visitIndices[formulaIndex] == NOT_VISITED)
+      visit(formulaIndex, components);
+  }
+
+  findPartitions(orderComponents(components));
+}
+
+std::vector<std::vector<size_t>> FormulasDependencyGraph::orderComponents(
+    std::vector<std::vector<size_t>> const & components) const
+{
+  std::vector<size_t> formulasComponents(dependentFormulas.size());
+  for (size_t componentIndex = 0; componentIndex < components.size(); ++componentIndex)
+  {
+    for (size_t formulaIndex : components[componentIndex])
+      formulasComponents[formulaIndex] = componentIndex;
+  }
+
+  std::vector<std::set<size_t>> dependentComponents(components.size());
+  std::vector<size_t> dependenciesAmounts(components.size(), 0);
+  for (size_t formulaIndex = 0; formulaIndex < dependentFormulas.size(); ++formulaIndex)
+  {
+    size_t const componentIndex = formulasComponents[formulaIndex];
+    for (size_t dependentFormulaIndex : dependentFormulas[formulaIndex])
+    {
+      size_t const dependentComponentIndex = formulasComponents[dependentFormulaIndex];
+      if (dependentComponentIndex != componentIndex &&
+          dependentComponents[componentIndex].insert(dependentComponentIndex).second)
+        ++dependenciesAmounts[dependentComponentIndex];
+    }
+  }
+
+  // Components without unordered dependencies are ordered by their least formulas, formulas are sorted in components
+  using ComponentKey = std::pair<size_t, size_t>;
+  std::priority_queue<ComponentKey, std::vector<ComponentKey>, std::greater<ComponentKey>> readyComponents;
+  for (size_t componentIndex = 0; componentIndex < components.size(); ++componentIndex)
+  {
+    if (dependenciesAmounts[componentIndex] == 0)
+      readyComponents.emplace(components[componentIndex].front(), componentIndex);
+  }
+
+  std::vector<std::vector<size_t>> orderedComponents;
+  orderedComponents.reserve(components.size());
+  while (!readyComponents.empty())
+  {
+    size_t const componentIndex = readyComponents.top().second;
+    readyComponents.pop();
+    orderedComponents.push_back(components[componentIndex]);
+    for (size_t dependentComponentIndex : dependentComponents[componentIndex])
+    {
+      if (--dependenciesAmounts[dependentComponentIndex] == 0)
+        readyComponents.emplace(components[dependentComponentIndex].front(), dependentComponentIndex);
+    }
+  }
+  return orderedComponents;
+}
+
+void FormulasDependencyGraph::visit(size_t formulaIndex, std::vector<std::vector<size_t>> & components)
+{
+  visitIndices[formulaIndex] = visitedAmount;
+  lowLinks[formulaIndex] = visitedAmount;
+  ++visitedAmount;
+  stack.push_back(formulaIndex);
+  isOnStack[formulaIndex] = true;
+
+  for (size_t dependentFormulaIndex : dependentFormulas[formulaIndex])
+  {
+    if (visitIndices[dependentFormulaIndex] == NOT_VISITED)
+    {
+      visit(dependentFormulaIndex, components);
+      lowLinks[formulaIndex] = std::min(lowLinks[formulaIndex], lowLinks[dependentFormulaIndex]);
+    }
+    else if (isOnStack[dependentFormulaIndex])
+      lowLinks[formulaIndex] = std::min(lowLinks[formulaIndex], visitIndices[dependentFormulaIndex]);
+  }
+
+  if (lowLinks[formulaIndex] != visitIndices[formulaIndex])
+    return;
+
+  std::vector<size_t> component;
+  size_t componentFormulaIndex;
+  do
+  {
+    componentFormulaIndex = stack.back();
+    stack.pop_back();
+    isOnStack[componentFormulaIndex] = false;
+    component.push_back(componentFormulaIndex);
+  } while (componentFormulaIndex != formulaIndex);
+  std::sort(component.begin(), component.end());
+  components.push_back(std::move(component));
+}
+
+void FormulasDependencyGraph::findPartitions(std::vector<std::vector<size_t>> const & components)
+{
+  // Formulas are partitioned by dependencies in both directions, a partition is named by its least formula
+  std::vector<size_t> partitionsRoots(dependentFormulas.size());
+  std::iota(partitionsRoots.begin(), partitionsRoots.end(), 0);
+  auto const findRoot = [&partitionsRoots](size_t formulaIndex) {
+    while (partitionsRoots[formulaIndex] != formulaIndex)
+    {
+      partitionsRoots[formulaIndex] = partitionsRoots[partitionsRoots[formulaIndex]];
+      formulaIndex = partitionsRoots[formulaIndex];
+    }
+    return formulaIndex;
+  };
+  for (size_t formulaIndex = 0; formulaIndex < dependentFormulas.size(); ++formulaIndex)
+  {
+    for (size_t dependentFormulaIndex : dependentFormulas[formulaIndex])
+    {
+      size_t const firstRoot = findRoot(formulaIndex);
+      size_t const secondRoot = findRoot(dependentFormulaIndex);
+      partitionsRoots[std::max(firstRoot, secondRoot)] = std::min(firstRoot, secondRoot);
+    }
+  }
+
+  std::map<size_t, Partition> rootsPartitions;
+  for (size_t formulaIndex = 0; formulaIndex < dependentFormulas.size(); ++formulaIndex)
+    rootsPartitions[findRoot(formulaIndex)].formulasIndices.push_back(formulaIndex);
+  for (std::vector<size_t> const & component : components)
+  {
+    bool const isRecursive =
+        component.size() > 1 || dependentFormulas[component.front()].count(component.front()) > 0;
+    rootsPartitions[findRoot(component.front())].components.push_back({component, isRecursive});
+  }
+
+  for (auto & rootPartition : rootsPartitions)
+    partitions.push_back(std::move(rootPartition.second));
+}
+
+}  // namespace inference
@@ -0,0 +1,113 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include "sc-memory/sc_memory.hpp"
+#include "sc-memory/sc_addr.hpp"
+
+namespace inference
+{
+/**
+ * Graph of dependencies between formulas. A formula depends on another one if the other formula generates
+ * constructions with predicates which the formula searches. Predicates of an atomic formula are its constant elements
+ * with access arcs from them (classes and relations). An atomic formula with a variable predicate, without access arcs
+ * or with common arcs without a relation may search or generate anything, so it is connected with all formulas.
+ * Strongly connected components are recursive formulas, they are ordered topologically: a component goes after all
+ * components it depends on, independent components go in order of their least formulas. Weakly connected components
+ * are independent partitions of formulas, they share no predicates, so they can be used concurrently.
+ */
+class FormulasDependencyGraph
+{
+public:
+  struct Component
+  {
+    /// Indices of formulas in ascending order
+    std::vector<size_t> formulasIndices;
+    /// Formulas of the component depend on each other or the formula depends on itself
+    bool isRecursive = false;
+  };
+
+  struct Partition
+  {
+    /// Indices of formulas in ascending order
+    std::vector<size_t> formulasIndices;
+    /// Components of the partition in topological order
+    std::vector<Component> components;
+  };
+
+  /// Predicates of a formula or a structure, a variable predicate is any predicate
+  struct Predicates
+  {
+    std::set<ScAddr, ScAddLessFunc> searched;
+    std::set<ScAddr, ScAddLessFunc> generated;
+    bool isAnySearched = false;
+    bool isAnyGenerated = false;
+  };
+
+  /// Distance of a formula which can't lead to predicates
+  static size_t const INFINITE_DISTANCE;
+
+  FormulasDependencyGraph(ScMemoryContext * context, ScAddrVector const & formulas);
+
+  /// @returns partitions in order of their first formulas
+  std::vector<Partition> const & getPartitions() const;
+
+  /// @returns true if formula `formulaIndex` searches predicates generated by formula `otherFormulaIndex`
+  bool dependsOn(size_t formulaIndex, size_t otherFormulaIndex) const;
+
+  /// @returns indices of formulas which search predicates generated by formula `formulaIndex`
+  std::set<size_t> const & getDependentFormulas(size_t formulaIndex) const;
+
+  Predicates const & getFormulaPredicates(size_t formulaIndex) const;
+
+  /// @returns predicates searched by a structure of constructions, for example by a target structure
+  Predicates getStructurePredicates(ScAddr const & structure) const;
+
+  /**
+   * @returns distances of formulas to `targetPredicates`: the least amount of dependencies from a formula to a formula
+   * which generates some of them. Distances are found by breadth-first search against dependencies
+   */
+  std::vector<size_t> findDistances(Predicates const & targetPredicates) const;
+
+private:
+  /// Add predicates of the formula and its operands, premises are searched, conclusions are generated
+  void addPredicates(ScAddr const & formula, bool isSearched, bool isGenerated, Predicates & predicates) const;
+
+  void addAtomicFormulaPredicates(ScAddr const & formula, bool isSearched, bool isGenerated, Predicates & predicates)
+      const;
+
+  void addDependencies();
+
+  void findComponents();
+
+  /// Tarjan's algorithm, components are found after all components which depend on them
+  void visit(size_t formulaIndex, std::vector<std::vector<size_t>> & components);
+
+  /// @returns components in topological order, a component is taken by its least formula of all ready components
+  std::vector<std::vector<size_t>> orderComponents(std::vector<std::vector<size_t>> const & components) const;
+
+  void findPartitions(std::vector<std::vector<size_t>> const & components);
+
+  ScMemoryContext * context;
+
+  std::vector<Predicates> formulasPredicates;
+  /// Indices of formulas which depend on a formula
+  std::vector<std::set<size_t>> dependentFormulas;
+  std::vector<Partition> partitions;
+
+  // State of Tarjan's algorithm
+  std::vector<size_t> visitIndices;
+  std::vector<size_t> lowLinks;
+  std::vector<bool> isOnStack;
+  std::vector<size_t> stack;
+  size_t visitedAmount = 0;
+};
+
+}  // namespace inference
@@ -6,6 +6,10 @@
 
 #include "InferenceManagerAbstract.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
 #include <utility>
 
 #include "sc-agents-common/utils/IteratorUtils.hpp"
@@ -13,6 +17,7 @@
 #include "manager/templateManager/TemplateManagerFixedArguments.hpp"
 #include "utils/ContainersUtils.hpp"
 #include "logic/LogicExpression.hpp"
+#include "logic/ImplicationExpressionNode.hpp"
 
 using namespace inference;
 
@@ -36,11 +41,108 @@ void InferenceManagerAbstract::setSolutionTreeManager(std::shared_ptr<SolutionTr
   solutionTreeManager = std::move(manager);
 }
 
+void InferenceManagerAbstract::setJoinConfig(JoinConfig const & config)
+{
+  joinConfig = config;
+}
+
+void InferenceManagerAbstract::setContextPool(std::shared_ptr<ScMemoryContextPool> pool)
+{
+  contextPool = std::move(pool);
+}
+
+void InferenceManagerAbstract::setScheduler(std::shared_ptr<WorkStealingScheduler> otherScheduler)
+{
+  scheduler = std::move(otherScheduler);
+}
+
+void InferenceManagerAbstract::setOrderedCommit(bool otherOrderedCommit)
+{
+  orderedCommit = otherOrderedCommit;
+}
+
+void InferenceManagerAbstract::setIdentityType(IdentityType otherIdentityType)
+{
+  identityType = otherIdentityType;
+}
+
+void InferenceManagerAbstract::addSink(std::shared_ptr<InferenceSinkAbstract> sink)
+{
+  sinks.push_back(std::move(sink));
+}
+
 std::shared_ptr<SolutionTreeManagerAbstract> InferenceManagerAbstract::getSolutionTreeManager()
 {
   return solutionTreeManager;
 }
 
+InferenceProfile InferenceManagerAbstract::getProfile() const
+{
+  InferenceProfile profile;
+  profile.arenaAllocationsAmount = arena.getAllocationsAmount();
+  profile.arenaBytesAllocated = arena.getBytesAllocated();
+  profile.arenaPeakSize = arena.getPeakSize();
+  if (contextPool != nullptr)
+  {
+    profile.contextPoolSize = contextPool->getSize();
+    profile.contextCheckoutsAmount = contextPool->getCheckoutsAmount();
+    profile.contextWaitsAmount = contextPool->getWaitsAmount();
+    profile.contextsPeakInUse = contextPool->getPeakInUse();
+    profile.contextPoolUtilization = contextPool->getUtilization();
+  }
+  if (scheduler != nullptr)
+  {
+    profile.schedulerThreadsAmount = scheduler->getThreadsAmount();
+    profile.schedulerTasksAmount = scheduler->getTasksAmount();
+    profile.schedulerStealsAmount = scheduler->getStealsAmount();
+    profile.schedulerIdleTime = std::chrono::duration<double>(scheduler->getIdleTime()).count();
+  }
+  profile.speculativeFormulasAmount = speculativeFormulasAmount;
+  profile.reexecutedFormulasAmount = reexecutedFormulasAmount;
+  profile.formulasUsesAmount = formulasUsesAmount;
+  profile.skippedFormulasAmount = skippedFormulasAmount;
+  if (templateSearcher != nullptr)
+    profile.templateSearchesAmount = templateSearcher->getSearchesAmount();
+  return profile;
+}
+
+std::vector<TargetResult> InferenceManagerAbstract::getTargetsResults() const
+{
+  return targetsResults;
+}
+
+void InferenceManagerAbstract::cancel()
+{
+  cancelled = true;
+}
+
+bool InferenceManagerAbstract::isCancelled() const
+{
+  return cancelled;
+}
+
+void InferenceManagerAbstract::startInference()
+{
+  cancelled = false;
+  formulasUsesAmount = 0;
+  skippedFormulasAmount = 0;
+}
+
+void InferenceManagerAbstract::commitFiring(ScAddr const & formula, LogicFormulaResult const & formulaResult)
+{
+  solutionTreeManager->addNode(formula, formulaResult.replacements);
+  if (sinks.empty())
+    return;
+
+  InferenceFiring firing;
+  firing.formula = formula;
+  firing.replacements = formulaResult.replacements;
+  firing.generatedElements = formulaResult.generatedElements;
+  firing.createdElements = formulaResult.createdElements;
+  for (std::shared_ptr<InferenceSinkAbstract> const & sink : sinks)
+    sink->onFiring(firing);
+}
+
 vector<ScAddrQueue> InferenceManagerAbstract::createFormulasQueuesListByPriority(ScAddr const & formulasSet)
 {
   vector<ScAddrQueue> formulasQueuesList;
@@ -73,6 +175,8 @@ ScAddrQueue InferenceManagerAbstract::createQueue(ScAddr const & set)
  */
 LogicFormulaResult InferenceManagerAbstract::useFormula(ScAddr const & formula, ScAddr const & outputStructure)
 {
+  MonotonicArena::Scope const formulaArenaScope(arena);
+
   ScAddr const & formulaRoot = utils::IteratorUtils::getAnyByOutRelation(
       context, formula, scAgentsCommon::CoreKeynodes::rrel_main_key_sc_element);
   if (!formulaRoot.IsValid())
@@ -92,11 +196,251 @@ LogicFormulaResult InferenceManagerAbstract::useFormula(ScAddr const & formula,
     resetTemplateManager(std::make_shared<TemplateManager>(context));
   }
 
-  LogicExpression logicExpression(context, templateSearcher, templateManager, solutionTreeManager, outputStructure);
+  return computeFormula(context, templateManager, formulaRoot, outputStructure);
+}
 
-  std::shared_ptr<LogicExpressionNode> expressionRoot = logicExpression.build(formulaRoot);
-  expressionRoot->setArgumentVector(templateManager->getArguments());
-  expressionRoot->setOutputStructureElements(outputStructureElements);
+std::vector<LogicFormulaResult> InferenceManagerAbstract::useFormulasConcurrently(
+    ScAddrVector const & formulas,
+    ScAddr const & outputStructure)
+{
+  FormulasDependencyGraph const dependencyGraph(context, formulas);
+  std::vector<FormulasDependencyGraph::Partition> const & partitions = dependencyGraph.getPartitions();
+  std::vector<LogicFormulaResult> formulasResults(formulas.size());
+  usePartitions(
+      partitions.size(),
+      [this, &formulas, &outputStructure, &partitions, &formulasResults](
+          ScMemoryContext * formulaContext, MonotonicArena & formulaArena, size_t partitionIndex) {
+        for (size_t formulaIndex : partitions[partitionIndex].formulasIndices)
+        {
+          MonotonicArena::Scope const formulaArenaScope(formulaArena);
+          ScAddr const & formula = formulas[formulaIndex];
+          SC_LOG_DEBUG("Trying to generate by formula: " << formulaContext->HelperGetSystemIdtf(formula));
+          formulasResults[formulaIndex] = useFormulaInContext(formulaContext, formula, outputStructure);
+        }
+      });
+
+  return formulasResults;
+}
+
+void InferenceManagerAbstract::usePartitions(size_t partitionsAmount, PartitionUser const & usePartition)
+{
+  if (!isConcurrent())
+  {
+    for (size_t partitionIndex = 0; partitionIndex < partitionsAmount; ++partitionIndex)
+      usePartition(context, arena, partitionIndex);
+    return;
+  }
+
+  WorkStealingScheduler::TaskGroup partitionsTasks(*scheduler);
+  for (size_t partitionIndex = 0; partitionIndex < partitionsAmount; ++partitionIndex)
+  {
+    partitionsTasks.run([this, &usePartition, partitionIndex]() {
+      ScMemoryContextPool::Lease const lease = contextPool->checkout();
+      TemplateSearcherAbstract::ContextScope const searchScope(lease);
+      // The arena of the manager is used by the thread waiting for tasks, so every task has an arena of its own
+      MonotonicArena partitionArena;
+      usePartition(lease.getContext(), partitionArena, partitionIndex);
+    });
+  }
+  partitionsTasks.wait();
+}
+
+bool InferenceManagerAbstract::isConcurrent() const
+{
+  return scheduler != nullptr && contextPool != nullptr;
+}
+
+void InferenceManagerAbstract::buildClassHierarchy(ScAddrQueue formulasQueue)
+{
+  std::shared_ptr<ClassHierarchy> hierarchy = std::make_shared<ClassHierarchy>();
+  for (; !formulasQueue.empty(); formulasQueue.pop())
+  {
+    ScAddr const & formulaRoot = utils::IteratorUtils::getAnyByOutRelation(
+        context, formulasQueue.front(), scAgentsCommon::CoreKeynodes::rrel_main_key_sc_element);
+    ScAddr premise;
+    ScAddr conclusion;
+    if (!formulaRoot.IsValid() ||
+        !FormulaClassifier::getImplicationOperands(context, formulaRoot, premise, conclusion))
+      continue;
+
+    FormulaClassifier::MembershipRule rule;
+    if (FormulaClassifier::isMembershipRule(context, premise, conclusion, rule))
+      hierarchy->addSubclass(rule.subclass, rule.superclass);
+  }
+
+  if (hierarchy->size() == 0)
+  {
+    classHierarchy = nullptr;
+    return;
+  }
+  hierarchy->encode();
+  SC_LOG_DEBUG("Class hierarchy has " << hierarchy->size() << " classes");
+  classHierarchy = std::move(hierarchy);
+}
+
+void InferenceManagerAbstract::buildIdentityClasses(ScAddrVector const & inputStructures)
+{
+  if (identityType == IDENTITY_NONE)
+  {
+    templateSearcher->setIdentityClasses(nullptr);
+    return;
+  }
+
+  std::shared_ptr<IdentityClasses> identityClasses = std::make_shared<IdentityClasses>();
+  for (std::pair<ScAddr, ScAddr> const & pair :
+       templateSearcher->findRelationPairs(context, InferenceKeynodes::nrel_identity))
+    identityClasses->unite(pair.first, pair.second);
+
+  if (identityType == IDENTITY_RELATION_AND_CONTENT)
+  {
+    std::map<std::string, ScAddr> contentsLinks;
+    for (ScAddr const & inputStructure : inputStructures)
+    {
+      ScIterator3Ptr const linksIterator =
+          context->Iterator3(inputStructure, ScType::EdgeAccessConstPosPerm, ScType::LinkConst);
+      while (linksIterator->Next())
+      {
+        ScAddr const & link = linksIterator->Get(2);
+        std::string content;
+        if (!context->GetLinkContent(link, content) || content.empty())
+          continue;
+        auto const & contentLink = contentsLinks.emplace(content, link);
+        if (!contentLink.second)
+          identityClasses->unite(contentLink.first->second, link);
+      }
+    }
+  }
+
+  SC_LOG_DEBUG("There are " << identityClasses->size() << " elements with identical ones");
+  if (identityClasses->size() == 0)
+    templateSearcher->setIdentityClasses(nullptr);
+  else
+    templateSearcher->setIdentityClasses(std::move(identityClasses));
+}
+
+void InferenceManagerAbstract::useFormulasInOrder(
+    FormulasDependencyGraph const & dependencyGraph,
+    ScAddrVector const & formulas,
+    std::vector<size_t> const & formulasIndices,
+    ScAddr const & outputStructure,
+    FormulaCommitter const & commitFormula)
+{
+  // Premises are searched by separate tasks, only implications generate by premises found before. A premise is
+  // nullptr if it was not searched
+  std::vector<std::unique_ptr<LogicFormulaResult>> premisesResults(formulasIndices.size());
+  if (isConcurrent())
+  {
+    usePartitions(
+        formulasIndices.size(),
+        [this, &formulas, &formulasIndices, &outputStructure, &premisesResults](
+            ScMemoryContext * formulaContext, MonotonicArena & formulaArena, size_t position) {
+          MonotonicArena::Scope const formulaArenaScope(formulaArena);
+          ScAddr const & formula = formulas[formulasIndices[position]];
+          ScAddr const & formulaRoot = utils::IteratorUtils::getAnyByOutRelation(
+              formulaContext, formula, scAgentsCommon::CoreKeynodes::rrel_main_key_sc_element);
+          if (!formulaRoot.IsValid())
+            return;
+
+          std::shared_ptr<LogicExpressionNode> const expressionRoot = buildFormula(
+              formulaContext, createFormulaTemplateManager(formulaContext, formula), formulaRoot, outputStructure);
+          auto const * implication = dynamic_cast<ImplicationExpressionNode const *>(expressionRoot.get());
+          if (implication == nullptr)
+            return;
+
+          premisesResults[position] = std::make_unique<LogicFormulaResult>(implication->computePremise());
+        });
+  }
+
+  std::vector<size_t> generatedFormulasIndices;
+  for (size_t position = 0; position < formulasIndices.size(); ++position)
+  {
+    MonotonicArena::Scope const formulaArenaScope(arena);
+    size_t const formulaIndex = formulasIndices[position];
+    ScAddr const & formula = formulas[formulaIndex];
+    SC_LOG_DEBUG("Trying to generate by formula: " << context->HelperGetSystemIdtf(formula));
+
+    bool const isPremiseChanged = std::any_of(
+        generatedFormulasIndices.cbegin(),
+        generatedFormulasIndices.cend(),
+        [&dependencyGraph, formulaIndex](size_t generatedFormulaIndex) {
+          return dependencyGraph.dependsOn(formulaIndex, generatedFormulaIndex);
+        });
+    bool const isPremiseSearched = premisesResults[position] != nullptr;
+    if (isPremiseSearched)
+    {
+      ++speculativeFormulasAmount;
+      if (isPremiseChanged)
+        ++reexecutedFormulasAmount;
+    }
+
+    LogicFormulaResult formulaResult;
+    if (isPremiseSearched && !isPremiseChanged)
+    {
+      ScAddr const & formulaRoot = utils::IteratorUtils::getAnyByOutRelation(
+          context, formula, scAgentsCommon::CoreKeynodes::rrel_main_key_sc_element);
+      std::shared_ptr<LogicExpressionNode> const expressionRoot =
+          buildFormula(context, createFormulaTemplateManager(context, formula), formulaRoot, outputStructure);
+      auto const * implication = dynamic_cast<ImplicationExpressionNode const *>(expressionRoot.get());
+      implication->computeByPremise(*premisesResults[position], formulaResult);
+    }
+    else
+      formulaResult = useFormulaInContext(context, formula, outputStructure);
+    SC_LOG_DEBUG("Logical formula is " << (formulaResult.isGenerated ? "generated" : "not generated"));
+
+    if (formulaResult.isGenerated)
+      generatedFormulasIndices.push_back(formulaIndex);
+    if (!commitFormula(formulaIndex, formulaResult))
+      break;
+  }
+}
+
+/// Use formula by `formulaContext` with a new template manager, members of the manager are only read
+LogicFormulaResult InferenceManagerAbstract::useFormulaInContext(
+    ScMemoryContext * formulaContext,
+    ScAddr const & formula,
+    ScAddr const & outputStructure) const
+{
+  ScAddr const & formulaRoot = utils::IteratorUtils::getAnyByOutRelation(
+      formulaContext, formula, scAgentsCommon::CoreKeynodes::rrel_main_key_sc_element);
+  if (!formulaRoot.IsValid())
+  {
+    return {false, false, {}};
+  }
+
+  return computeFormula(
+      formulaContext, createFormulaTemplateManager(formulaContext, formula), formulaRoot, outputStructure);
+}
+
+/// Create a template manager of `formula` with arguments and types of the template manager of the manager
+std::shared_ptr<TemplateManagerAbstract> InferenceManagerAbstract::createFormulaTemplateManager(
+    ScMemoryContext * formulaContext,
+    ScAddr const & formula) const
+{
+  std::shared_ptr<TemplateManagerAbstract> formulaTemplateManager;
+  ScAddr const & firstFixedArgument =
+      utils::IteratorUtils::getAnyByOutRelation(formulaContext, formula, scAgentsCommon::CoreKeynodes::rrel_1);
+  if (firstFixedArgument.IsValid())
+    formulaTemplateManager = std::make_shared<TemplateManagerFixedArguments>(formulaContext);
+  else
+    formulaTemplateManager = std::make_shared<TemplateManager>(formulaContext);
+  formulaTemplateManager->setArguments(templateManager->getArguments());
+  formulaTemplateManager->setGenerationType(templateManager->getGenerationType());
+  formulaTemplateManager->setReplacementsUsingType(templateManager->getReplacementsUsingType());
+  if (firstFixedArgument.IsValid())
+    addFixedArgumentsIdentifiers(formulaContext, *formulaTemplateManager, formula, firstFixedArgument);
+
+  return formulaTemplateManager;
+}
+
+LogicFormulaResult InferenceManagerAbstract::computeFormula(
+    ScMemoryContext * formulaContext,
+    std::shared_ptr<TemplateManagerAbstract> const & formulaTemplateManager,
+    ScAddr const & formulaRoot,
+    ScAddr const & outputStructure) const
+{
+  ++formulasUsesAmount;
+  std::shared_ptr<LogicExpressionNode> const expressionRoot =
+      buildFormula(formulaContext, formulaTemplateManager, formulaRoot, outputStructure);
 
   LogicFormulaResult formulaResult;
   expressionRoot->compute(formulaResult);
@@ -104,16 +448,44 @@ LogicFormulaResult InferenceManagerAbstract::useFormula(ScAddr const & formula,
   return formulaResult;
 }
 
+std::shared_ptr<LogicExpressionNode> InferenceManagerAbstract::buildFormula(
+    ScMemoryContext * formulaContext,
+    std::shared_ptr<TemplateManagerAbstract> const & formulaTemplateManager,
+    ScAddr const & formulaRoot,
+    ScAddr const & outputStructure) const
+{
+  LogicExpression logicExpression(
+      formulaContext, templateSearcher, formulaTemplateManager, solutionTreeManager, outputStructure);
+  logicExpression.setClassHierarchy(classHierarchy);
+  logicExpression.setJoinSettings({joinConfig, scheduler});
+  // Generated elements are reported to sinks or erased by the manager, otherwise they aren't collected
+  logicExpression.setCollectsGeneratedElements(collectsGeneratedElements || !sinks.empty());
+
+  std::shared_ptr<LogicExpressionNode> expressionRoot = logicExpression.build(formulaRoot);
+  expressionRoot->setArgumentVector(formulaTemplateManager->getArguments());
+  expressionRoot->setOutputStructureElements(outputStructureElements);
+  return expressionRoot;
+}
+
 /// Form formula fixed arguments from rrel_1, rrel_2 etc. to create template params. Used only in
 /// 'TemplateManagerFixedArguments'
 void InferenceManagerAbstract::fillFormulaFixedArgumentsIdentifiers(
     ScAddr const & formula,
     ScAddr const & firstFixedArgument) const
 {
-  std::string const firstFixedArgumentIdentifier = context->HelperGetSystemIdtf(firstFixedArgument);
+  addFixedArgumentsIdentifiers(context, *templateManager, formula, firstFixedArgument);
+}
+
+void InferenceManagerAbstract::addFixedArgumentsIdentifiers(
+    ScMemoryContext * formulaContext,
+    TemplateManagerAbstract & formulaTemplateManager,
+    ScAddr const & formula,
+    ScAddr const & firstFixedArgument) const
+{
+  std::string const firstFixedArgumentIdentifier = formulaContext->HelperGetSystemIdtf(firstFixedArgument);
   if (!firstFixedArgumentIdentifier.empty())
   {
-    templateManager->addFixedArgumentIdentifier(firstFixedArgumentIdentifier);
+    formulaTemplateManager.addFixedArgumentIdentifier(firstFixedArgumentIdentifier);
   }
 
   // TODO(MksmOrlov): make nrel_basic_sequence oriented set processing
@@ -123,16 +495,16 @@ void InferenceManagerAbstract::fillFormulaFixedArgumentsIdentifiers(
   std::string currentFixedArgumentIdentifier;
   for (size_t i = 2; i <= maxFixedArgumentsCount; i++)
   {
-    currentRoleRelation = utils::IteratorUtils::getRoleRelation(context, i);
-    currentFixedArgument = utils::IteratorUtils::getAnyByOutRelation(context, formula, currentRoleRelation);
+    currentRoleRelation = utils::IteratorUtils::getRoleRelation(formulaContext, i);
+    currentFixedArgument = utils::IteratorUtils::getAnyByOutRelation(formulaContext, formula, currentRoleRelation);
     if (!currentFixedArgument.IsValid())
     {
       break;
     }
-    currentFixedArgumentIdentifier = context->HelperGetSystemIdtf(currentFixedArgument);
+    currentFixedArgumentIdentifier = formulaContext->HelperGetSystemIdtf(currentFixedArgument);
     if (!currentFixedArgumentIdentifier.empty())
     {
-      templateManager->addFixedArgumentIdentifier(currentFixedArgumentIdentifier);
+      formulaTemplateManager.addFixedArgumentIdentifier(currentFixedArgumentIdentifier);
     }
   }
 }
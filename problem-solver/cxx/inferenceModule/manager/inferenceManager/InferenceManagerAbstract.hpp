@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "sc-memory/sc_memory.hpp"
 #include "sc-memory/sc_addr.hpp"
 
@@ -13,7 +15,15 @@
 #include "manager/solutionTreeManager/SolutionTreeManager.hpp"
 #include "manager/templateManager/TemplateManager.hpp"
 #include "logic/LogicExpressionNode.hpp"
+#include "sink/InferenceSinkAbstract.hpp"
 #include "inferenceConfig/InferenceConfig.hpp"
+#include "inferenceConfig/InferenceProfile.hpp"
+#include "utils/ClassHierarchy.hpp"
+#include "utils/MonotonicArena.hpp"
+#include "utils/ScMemoryContextPool.hpp"
+#include "utils/WorkStealingScheduler.hpp"
+
+#include "FormulasDependencyGraph.hpp"
 
 namespace inference
 {
@@ -30,9 +40,28 @@ public:
   void setTemplateSearcher(std::shared_ptr<TemplateSearcherAbstract> searcher);
   void setTemplateManager(std::shared_ptr<TemplateManagerAbstract> manager);
   void setSolutionTreeManager(std::shared_ptr<SolutionTreeManagerAbstract> manager);
+  void setJoinConfig(JoinConfig const & config);
+  void setContextPool(std::shared_ptr<ScMemoryContextPool> pool);
+  void setScheduler(std::shared_ptr<WorkStealingScheduler> otherScheduler);
+  void setOrderedCommit(bool otherOrderedCommit);
+  void setIdentityType(IdentityType otherIdentityType);
+
+  /// Notify the sink of every firing of next inferences, sinks are notified in order of adding
+  void addSink(std::shared_ptr<InferenceSinkAbstract> sink);
 
   std::shared_ptr<SolutionTreeManagerAbstract> getSolutionTreeManager();
 
+  InferenceProfile getProfile() const;
+
+  /// @returns results of targets of the last inference in order of InferenceParams::getTargetStructures
+  std::vector<TargetResult> getTargetsResults() const;
+
+  /**
+   * Stop inference running in another thread before the next formula, applyInference returns what is achieved. Every
+   * applyInference starts not cancelled
+   */
+  virtual void cancel();
+
   /**
    * @brief Iterate over formulas set and use formulas to generate knowledge
    * @param formulasSet is an oriented set of formulas sets to apply
@@ -45,6 +74,16 @@ public:
   // TODO: Need to implement common logic of inference rules (e.g. modus ponens)
   LogicFormulaResult useFormula(ScAddr const & formula, ScAddr const & outputStructure);
 
+  /**
+   * @brief Use independent partitions of formulas of one priority level concurrently (see FormulasDependencyGraph).
+   * Formulas of a partition are used one by one in order of `formulas`, so they see knowledge generated by previous
+   * formulas of the level as in sequential inference
+   * @returns results of formulas in order of `formulas`
+   */
+  std::vector<LogicFormulaResult> useFormulasConcurrently(
+      ScAddrVector const & formulas,
+      ScAddr const & outputStructure);
+
   void fillFormulaFixedArgumentsIdentifiers(ScAddr const & formula, ScAddr const & firstFixedArgument) const;
 
   void formTemplateManagerFixedArguments(ScAddr const & formula, ScAddr const & firstFixedArgument);
@@ -55,11 +94,117 @@ public:
   ScAddrQueue createQueue(ScAddr const & set);
 
 protected:
+  /// Use formulas of a partition with the context and the arena of a worker
+  using PartitionUser =
+      std::function<void(ScMemoryContext * formulaContext, MonotonicArena & formulaArena, size_t partitionIndex)>;
+
+  /// Commit the result of a formula used in order, @returns false to stop using formulas
+  using FormulaCommitter = std::function<bool(size_t formulaIndex, LogicFormulaResult & formulaResult)>;
+
+  /// @returns true if formulas of a level are used concurrently
+  bool isConcurrent() const;
+
+  bool isCancelled() const;
+
+  /// Reset the state of the previous inference run, every applyInference starts with it
+  void startInference();
+
+  /// Add the firing of a generated formula to the solution tree and notify sinks of it
+  void commitFiring(ScAddr const & formula, LogicFormulaResult const & formulaResult);
+
+  /**
+   * @brief Build the class hierarchy of a level from its membership rules, a rule `subclass _-> _element`
+   * => `superclass _-> _element` makes its subclass a subclass of its superclass. Membership rules of the level are
+   * used by the hierarchy (see ClassHierarchyExpressionNode), rules of other levels are not applied through it, so
+   * priorities of levels are kept
+   */
+  void buildClassHierarchy(ScAddrQueue formulasQueue);
+
+  /**
+   * @brief Unite identical elements of the run by the identity type and set them to the searcher. Pairs of
+   * nrel_identity are found by the searcher, links with the same content are found in `inputStructures`
+   */
+  void buildIdentityClasses(ScAddrVector const & inputStructures);
+
+  /**
+   * @brief Use formulas `formulasIndices` of `formulas` in this order with deterministic result. If inference is
+   * concurrent, premises of implications are searched speculatively as tasks of the scheduler. Then formulas are
+   * committed one by one by the context of the manager: a conclusion is generated with the speculative premise if no
+   * formula committed before has generated predicates which the formula searches (see FormulasDependencyGraph),
+   * otherwise the formula is used again. So output structure and solution tree are the same as after sequential use
+   */
+  void useFormulasInOrder(
+      FormulasDependencyGraph const & dependencyGraph,
+      ScAddrVector const & formulas,
+      std::vector<size_t> const & formulasIndices,
+      ScAddr const & outputStructure,
+      FormulaCommitter const & commitFormula);
+
+  /**
+   * @brief Use partitions as tasks of the scheduler if inference is concurrent, every task uses its own context of the
+   * pool and its own arena. Otherwise partitions are used one by one with the context and the arena of the manager.
+   * Waiting for the tasks is a barrier between levels
+   */
+  void usePartitions(size_t partitionsAmount, PartitionUser const & usePartition);
+
+  LogicFormulaResult useFormulaInContext(
+      ScMemoryContext * formulaContext,
+      ScAddr const & formula,
+      ScAddr const & outputStructure) const;
+
+  LogicFormulaResult computeFormula(
+      ScMemoryContext * formulaContext,
+      std::shared_ptr<TemplateManagerAbstract> const & formulaTemplateManager,
+      ScAddr const & formulaRoot,
+      ScAddr const & outputStructure) const;
+
+  std::shared_ptr<TemplateManagerAbstract> createFormulaTemplateManager(
+      ScMemoryContext * formulaContext,
+      ScAddr const & formula) const;
+
+  std::shared_ptr<LogicExpressionNode> buildFormula(
+      ScMemoryContext * formulaContext,
+      std::shared_ptr<TemplateManagerAbstract> const & formulaTemplateManager,
+      ScAddr const & formulaRoot,
+      ScAddr const & outputStructure) const;
+
+  void addFixedArgumentsIdentifiers(
+      ScMemoryContext * formulaContext,
+      TemplateManagerAbstract & formulaTemplateManager,
+      ScAddr const & formula,
+      ScAddr const & firstFixedArgument) const;
+
   ScMemoryContext * context;
 
   std::shared_ptr<TemplateManagerAbstract> templateManager;
   std::shared_ptr<TemplateSearcherAbstract> templateSearcher;
   std::shared_ptr<SolutionTreeManagerAbstract> solutionTreeManager;
+  std::vector<std::shared_ptr<InferenceSinkAbstract>> sinks;
+
+  JoinConfig joinConfig;
+
+  /// Memory contexts of workers, nullptr if inference is sequential
+  std::shared_ptr<ScMemoryContextPool> contextPool;
+  /// Scheduler of formulas tasks and join tasks, nullptr if inference is sequential
+  std::shared_ptr<WorkStealingScheduler> scheduler;
+  /// Formulas of a level are committed in sequential order (see useFormulasInOrder)
+  bool orderedCommit = false;
+  IdentityType identityType = IDENTITY_NONE;
+  /// Elements generated by formulas are collected even if there are no sinks, for example to erase them
+  bool collectsGeneratedElements = false;
+  size_t speculativeFormulasAmount = 0;
+  size_t reexecutedFormulasAmount = 0;
+  /// Formulas are computed concurrently by workers, so uses are counted atomically
+  mutable std::atomic<size_t> formulasUsesAmount{0};
+  size_t skippedFormulasAmount = 0;
+  std::atomic<bool> cancelled{false};
+  std::vector<TargetResult> targetsResults;
+
+  /// Subsumption graph of membership rules of the inference run, nullptr if there are no membership rules
+  std::shared_ptr<ClassHierarchy const> classHierarchy;
+
+  /// Arena for temporary containers of inference run, it is released after every formula and at the end of the run
+  MonotonicArena arena;
 
   std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> outputStructureElements;
 };
@@ -17,11 +17,21 @@ bool SolutionTreeManager::addNode(ScAddr const & formula, Replacements const & r
 {
   std::vector<ScTemplateParams> const & templateParamsVector =
       ReplacementsUtils::getReplacementsToScTemplateParams(replacements);
-  std::set<std::string> varNames;
+  VarNames varNames;
   ReplacementsUtils::getKeySet(replacements, varNames);
   bool result = true;
   for (ScTemplateParams const & templateParams : templateParamsVector)
-    result &= solutionTreeGenerator->addNode(formula, templateParams, varNames);
+  {
+    // Padded replacements are not in template params, so these variables are not added to the solution node
+    VarNames paramsVarNames;
+    ScAddr replacement;
+    for (std::string const & varName : varNames)
+    {
+      if (templateParams.Get(varName, replacement))
+        paramsVarNames.insert(varName);
+    }
+    result &= solutionTreeGenerator->addNode(formula, templateParams, paramsVarNames);
+  }
   return result;
 }
 
@@ -22,7 +22,7 @@ ScAddr SolutionTreeManagerAbstract::createSolution(ScAddr const & outputStructur
 bool SolutionTreeManagerAbstract::checkIfSolutionNodeExists(
     ScAddr const & formula,
     ScTemplateParams const & templateParams,
-    std::set<std::string> const & varNames)
+    VarNames const & varNames)
 {
   return solutionTreeSearcher->checkIfSolutionNodeExists(formula, templateParams, varNames);
 }
@@ -8,6 +8,8 @@
 
 #include <algorithm>
 
+#include "utils/MonotonicArena.hpp"
+
 using namespace inference;
 
 TemplateManager::TemplateManager(ScMemoryContext * ms_context)
@@ -21,7 +23,7 @@ TemplateManager::TemplateManager(ScMemoryContext * ms_context)
  */
 std::vector<ScTemplateParams> TemplateManager::createTemplateParams(ScAddr const & scTemplate)
 {
-  std::map<std::string, std::set<ScAddr, ScAddLessFunc>> replacementsMultimap;
+  ArenaMap<std::string, ArenaSet<ScAddr, ScAddLessFunc>> replacementsMultimap;
   std::vector<ScTemplateParams> templateParamsVector;
 
   ScIterator3Ptr varIterator = context->Iterator3(scTemplate, ScType::EdgeAccessConstPosPerm, ScType::NodeVar);
@@ -47,7 +49,7 @@ std::vector<ScTemplateParams> TemplateManager::createTemplateParams(ScAddr const
     }
     if (templateParamsVector.empty())
     {
-      std::set<ScAddr, ScAddLessFunc> addresses = replacementsMultimap[varName];
+      auto const & addresses = replacementsMultimap[varName];
       templateParamsVector.reserve(replacementsMultimap[varName].size());
       for (ScAddr const & address : addresses)
       {
@@ -58,7 +60,7 @@ std::vector<ScTemplateParams> TemplateManager::createTemplateParams(ScAddr const
     }
     else
     {
-      std::set<ScAddr, ScAddLessFunc> addresses = replacementsMultimap[varName];
+      auto const & addresses = replacementsMultimap[varName];
       size_t amountOfAddressesForVar = addresses.size();
       size_t oldParamsSize = templateParamsVector.size();
 
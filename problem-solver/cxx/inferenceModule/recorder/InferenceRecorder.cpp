@@ -0,0 +1,319 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "InferenceRecorder.hpp"
+
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace inference
+{
+namespace
+{
+/// @returns scs keyword of the type of the node, empty string if the node has no keyword
+std::string getNodeTypeKeyword(ScType const & type)
+{
+  std::vector<std::pair<std::vector<ScType>, std::string>> const keywords = {
+      {{ScType::NodeConstStruct, ScType::NodeVarStruct}, "sc_node_struct"},
+      {{ScType::NodeConstTuple, ScType::NodeVarTuple}, "sc_node_tuple"},
+      {{ScType::NodeConstClass, ScType::NodeVarClass}, "sc_node_class"},
+      {{ScType::NodeConstRole, ScType::NodeVarRole}, "sc_node_role_relation"},
+      {{ScType::NodeConstNoRole, ScType::NodeVarNoRole}, "sc_node_norole_relation"},
+      {{ScType::NodeConstAbstract, ScType::NodeVarAbstract}, "sc_node_abstract"},
+      {{ScType::NodeConstMaterial, ScType::NodeVarMaterial}, "sc_node_material"}};
+  for (auto const & keyword : keywords)
+  {
+    for (ScType const & keywordType : keyword.first)
+    {
+      if (type == keywordType)
+        return keyword.second;
+    }
+  }
+  return "";
+}
+
+/// @returns scs connector of the type of the arc, connector of access arc if the type is not known
+std::string getArcConnector(ScType const & type)
+{
+  std::vector<std::pair<ScType, std::string>> const connectors = {
+      {ScType::EdgeAccessConstPosPerm, "->"},
+      {ScType::EdgeAccessVarPosPerm, "_->"},
+      {ScType::EdgeAccessConstNegPerm, "-|>"},
+      {ScType::EdgeAccessVarNegPerm, "_-|>"},
+      {ScType::EdgeAccessConstFuzPerm, "-/>"},
+      {ScType::EdgeAccessVarFuzPerm, "_-/>"},
+      {ScType::EdgeAccessConstPosTemp, "~>"},
+      {ScType::EdgeAccessVarPosTemp, "_~>"},
+      {ScType::EdgeAccessConstNegTemp, "~|>"},
+      {ScType::EdgeAccessVarNegTemp, "_~|>"},
+      {ScType::EdgeAccessConstFuzTemp, "~/>"},
+      {ScType::EdgeAccessVarFuzTemp, "_~/>"},
+      {ScType::EdgeDCommonConst, "=>"},
+      {ScType::EdgeDCommonVar, "_=>"},
+      {ScType::EdgeUCommonConst, "<=>"},
+      {ScType::EdgeUCommonVar, "_<=>"}};
+  for (auto const & connector : connectors)
+  {
+    if (type == connector.first)
+      return connector.second;
+  }
+  return "..>";
+}
+
+std::string escapeLinkContent(std::string const & content)
+{
+  std::string escapedContent;
+  for (char const symbol : content)
+  {
+    if (symbol == '[' || symbol == ']' || symbol == '\\')
+      escapedContent.push_back('\\');
+    escapedContent.push_back(symbol);
+  }
+  return escapedContent;
+}
+
+void writeManifestNames(std::ostream & manifest, std::string const & key, std::vector<std::string> const & names)
+{
+  manifest << "  \"" << key << "\": [";
+  for (size_t index = 0; index < names.size(); ++index)
+    manifest << (index == 0 ? "\"" : ", \"") << names[index] << "\"";
+  manifest << "]," << std::endl;
+}
+}  // namespace
+
+std::string const InferenceRecorder::BUNDLE_FILE_NAME = "bundle.scs";
+std::string const InferenceRecorder::MANIFEST_FILE_NAME = "manifest.json";
+size_t const InferenceRecorder::MANIFEST_VERSION = 2;
+
+InferenceRecorder::InferenceRecorder(ScMemoryContext * context, std::string const & bundleDirectory)
+  : context(context)
+  , bundleDirectory(bundleDirectory)
+{
+}
+
+void InferenceRecorder::record(
+    InferenceParams const & inferenceParams,
+    InferenceConfig const & inferenceConfig,
+    InferenceStrategy strategy)
+{
+  recordedElements.clear();
+  recordedElementsSet.clear();
+  formulasElements.clear();
+
+  addFormulaElement(inferenceParams.formulasSet);
+  for (ScAddr const & targetStructure : inferenceParams.getTargetStructures())
+    addFormulaElement(targetStructure);
+  for (ScAddr const & argument : inferenceParams.arguments)
+    addElement(argument);
+  for (ScAddr const & inputStructure : inferenceParams.inputStructures)
+    addStructure(inputStructure);
+
+  writeBundle();
+  writeManifest(inferenceParams, inferenceConfig, strategy);
+  SC_LOG_DEBUG("Inference is recorded by " << recordedElements.size() << " elements");
+}
+
+size_t InferenceRecorder::getRecordedElementsAmount() const
+{
+  return recordedElements.size();
+}
+
+void InferenceRecorder::addFormulaElement(ScAddr const & element)
+{
+  if (!element.IsValid() || !formulasElements.insert(element).second)
+    return;
+  addElement(element);
+
+  // Classes and relations of formulas, e.g. atomic_logical_formula or nrel_implication
+  ScIterator3Ptr const marksIterator = context->Iterator3(ScType::Node, ScType::EdgeAccessConstPosPerm, element);
+  while (marksIterator->Next())
+  {
+    ScType const markType = context->GetElementType(marksIterator->Get(0));
+    if (markType == ScType::NodeConstClass || markType == ScType::NodeConstNoRole)
+      addElement(marksIterator->Get(1));
+  }
+
+  ScType const type = context->GetElementType(element);
+  if (type.IsEdge())
+  {
+    ScAddr source;
+    ScAddr target;
+    context->GetEdgeInfo(element, source, target);
+    addFormulaElement(source);
+    addFormulaElement(target);
+    return;
+  }
+  if (type == ScType::NodeConstStruct || type == ScType::NodeVarStruct)
+  {
+    addStructure(element);
+    return;
+  }
+  // Only sets of formulas, formulas and their tuples are followed by their arcs
+  bool const isSet = !type.IsLink() && (getNodeTypeKeyword(type).empty() || type == ScType::NodeConstTuple);
+  if (!isSet)
+    return;
+
+  ScIterator3Ptr const arcsIterator = context->Iterator3(element, ScType::Unknown, ScType::Unknown);
+  while (arcsIterator->Next())
+  {
+    ScAddr const & arc = arcsIterator->Get(1);
+    addElement(arc);
+    ScIterator3Ptr const attributesIterator =
+        context->Iterator3(ScType::Unknown, ScType::EdgeAccessConstPosPerm, arc);
+    while (attributesIterator->Next())
+      addElement(attributesIterator->Get(1));
+    addFormulaElement(arcsIterator->Get(2));
+  }
+}
+
+void InferenceRecorder::addStructure(ScAddr const & structure)
+{
+  addElement(structure);
+  ScIterator3Ptr const membersIterator =
+      context->Iterator3(structure, ScType::EdgeAccessConstPosPerm, ScType::Unknown);
+  while (membersIterator->Next())
+  {
+    addElement(membersIterator->Get(1));
+    addElement(membersIterator->Get(2));
+  }
+}
+
+void InferenceRecorder::addElement(ScAddr const & element)
+{
+  if (!element.IsValid() || !recordedElementsSet.insert(element).second)
+    return;
+  recordedElements.push_back(element);
+
+  if (context->GetElementType(element).IsEdge())
+  {
+    ScAddr source;
+    ScAddr target;
+    context->GetEdgeInfo(element, source, target);
+    addElement(source);
+    addElement(target);
+  }
+}
+
+/// Nodes with types and links are written first, then arcs by aliases. Variable links are written as `_[content]`
+void InferenceRecorder::writeBundle() const
+{
+  std::string const bundlePath = bundleDirectory + "/" + BUNDLE_FILE_NAME;
+  std::ofstream bundle(bundlePath, std::ios::out | std::ios::trunc);
+  if (!bundle.is_open())
+  {
+    SC_THROW_EXCEPTION(utils::ExceptionInvalidState, "File " << bundlePath << " can't be opened for inference bundle.");
+  }
+
+  for (ScAddr const & element : recordedElements)
+  {
+    ScType const type = context->GetElementType(element);
+    if (type.IsLink())
+    {
+      std::string content;
+      context->GetLinkContent(element, content);
+      bundle << getElementName(element) << " = " << (type.IsVar() ? "_[" : "[") << escapeLinkContent(content) << "];;"
+             << std::endl;
+    }
+    else if (!type.IsEdge() && !getNodeTypeKeyword(type).empty())
+      bundle << getNodeTypeKeyword(type) << " -> " << getElementName(element) << ";;" << std::endl;
+  }
+
+  std::map<ScAddr, std::string, ScAddLessFunc> arcsAliases;
+  for (ScAddr const & element : recordedElements)
+  {
+    if (context->GetElementType(element).IsEdge())
+      writeArc(element, bundle, arcsAliases);
+  }
+  if (!bundle)
+  {
+    SC_THROW_EXCEPTION(utils::ExceptionInvalidState, "Inference bundle " << bundlePath << " is not written.");
+  }
+}
+
+std::string InferenceRecorder::writeArc(
+    ScAddr const & arc,
+    std::ostream & bundle,
+    std::map<ScAddr, std::string, ScAddLessFunc> & arcsAliases) const
+{
+  auto const & arcAlias = arcsAliases.find(arc);
+  if (arcAlias != arcsAliases.cend())
+    return arcAlias->second;
+
+  ScAddr source;
+  ScAddr target;
+  context->GetEdgeInfo(arc, source, target);
+  std::string const sourceName =
+      context->GetElementType(source).IsEdge() ? writeArc(source, bundle, arcsAliases) : getElementName(source);
+  std::string const targetName =
+      context->GetElementType(target).IsEdge() ? writeArc(target, bundle, arcsAliases) : getElementName(target);
+
+  std::string const alias = "@arc_" + std::to_string(arcsAliases.size());
+  arcsAliases.emplace(arc, alias);
+  bundle << alias << " = (" << sourceName << " " << getArcConnector(context->GetElementType(arc)) << " "
+         << targetName << ");;" << std::endl;
+  return alias;
+}
+
+void InferenceRecorder::writeManifest(
+    InferenceParams const & inferenceParams,
+    InferenceConfig const & inferenceConfig,
+    InferenceStrategy strategy) const
+{
+  std::string const manifestPath = bundleDirectory + "/" + MANIFEST_FILE_NAME;
+  std::ofstream manifest(manifestPath, std::ios::out | std::ios::trunc);
+  if (!manifest.is_open())
+  {
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidState, "File " << manifestPath << " can't be opened for inference manifest.");
+  }
+
+  auto const getNames = [this](ScAddrVector const & elements) {
+    std::vector<std::string> names;
+    for (ScAddr const & element : elements)
+      names.push_back(getElementName(element));
+    return names;
+  };
+
+  manifest << "{" << std::endl;
+  manifest << "  \"version\": " << MANIFEST_VERSION << "," << std::endl;
+  manifest << "  \"bundle\": \"" << BUNDLE_FILE_NAME << "\"," << std::endl;
+  manifest << "  \"formulasSet\": \"" << getElementName(inferenceParams.formulasSet) << "\"," << std::endl;
+  writeManifestNames(manifest, "arguments", getNames(inferenceParams.arguments));
+  writeManifestNames(manifest, "inputStructures", getNames(inferenceParams.inputStructures));
+  writeManifestNames(manifest, "targetStructures", getNames(inferenceParams.getTargetStructures()));
+  manifest << "  \"targetsType\": " << inferenceParams.targetsType << "," << std::endl;
+  manifest << "  \"strategy\": " << strategy << "," << std::endl;
+  manifest << "  \"generationType\": " << inferenceConfig.generationType << "," << std::endl;
+  manifest << "  \"replacementsUsingType\": " << inferenceConfig.replacementsUsingType << "," << std::endl;
+  manifest << "  \"solutionTreeType\": " << inferenceConfig.solutionTreeType << "," << std::endl;
+  manifest << "  \"searchType\": " << inferenceConfig.searchType << "," << std::endl;
+  manifest << "  \"workersAmount\": " << inferenceConfig.workersAmount << "," << std::endl;
+  manifest << "  \"orderedCommit\": " << inferenceConfig.orderedCommit << "," << std::endl;
+  manifest << "  \"identityType\": " << inferenceConfig.identityType << "," << std::endl;
+  manifest << "  \"frontierSize\": " << inferenceConfig.frontierSize << "," << std::endl;
+  manifest << "  \"joinThreadsAmount\": " << inferenceConfig.joinConfig.threadsAmount << "," << std::endl;
+  manifest << "  \"joinParallelThreshold\": " << inferenceConfig.joinConfig.parallelThreshold << "," << std::endl;
+  manifest << "  \"joinDeterministic\": " << inferenceConfig.joinConfig.deterministic << "," << std::endl;
+  manifest << "  \"joinMemoryThreshold\": " << inferenceConfig.joinConfig.memoryThreshold << "," << std::endl;
+  manifest << "  \"elementsAmount\": " << recordedElements.size() << std::endl;
+  manifest << "}" << std::endl;
+  if (!manifest)
+  {
+    SC_THROW_EXCEPTION(utils::ExceptionInvalidState, "Inference manifest " << manifestPath << " is not written.");
+  }
+}
+
+std::string InferenceRecorder::getElementName(ScAddr const & element) const
+{
+  std::string const & systemIdentifier = context->HelperGetSystemIdtf(element);
+  if (!systemIdentifier.empty())
+    return systemIdentifier;
+  return (context->GetElementType(element).IsVar() ? "_replay_element_" : "replay_element_") +
+         std::to_string(element.Hash());
+}
+
+}  // namespace inference
@@ -0,0 +1,85 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+
+#include "sc-memory/sc_memory.hpp"
+
+#include "inferenceConfig/InferenceConfig.hpp"
+
+namespace inference
+{
+/**
+ * Recorder of knowledge which inference reads, so inference can be replayed in another memory (see InferenceReplay).
+ * The bundle is a scs file with formulas of the formulas set, target structures, arguments and input structures, the
+ * manifest is a json file with identifiers of params and fields of the config. Elements without system identifiers
+ * are named by their hashes. Input structures are recorded, so inference which searches in all knowledge base is
+ * replayed with knowledge of input structures only
+ */
+class InferenceRecorder
+{
+public:
+  static std::string const BUNDLE_FILE_NAME;
+  static std::string const MANIFEST_FILE_NAME;
+  static size_t const MANIFEST_VERSION;
+
+  /// @param bundleDirectory is an existing directory to write the bundle and the manifest to
+  InferenceRecorder(ScMemoryContext * context, std::string const & bundleDirectory);
+
+  /**
+   * @brief Record knowledge of inference with the params, it is called before applyInference because inference
+   * changes memory
+   * @throws utils::ExceptionInvalidState Thrown if the bundle or the manifest can't be written
+   */
+  void record(
+      InferenceParams const & inferenceParams,
+      InferenceConfig const & inferenceConfig,
+      InferenceStrategy strategy);
+
+  size_t getRecordedElementsAmount() const;
+
+private:
+  /**
+   * Add the element of formulas and elements which inference reads with it: sets and rules are followed by their
+   * outgoing arcs, arc formulas by their ends, structures by their members, classes and relations are not followed
+   */
+  void addFormulaElement(ScAddr const & element);
+
+  void addStructure(ScAddr const & structure);
+
+  /// Add the element and ends of the element if it is an arc
+  void addElement(ScAddr const & element);
+
+  void writeBundle() const;
+
+  /// @returns alias of the arc, arcs are written after their ends
+  std::string writeArc(
+      ScAddr const & arc,
+      std::ostream & bundle,
+      std::map<ScAddr, std::string, ScAddLessFunc> & arcsAliases) const;
+
+  void writeManifest(
+      InferenceParams const & inferenceParams,
+      InferenceConfig const & inferenceConfig,
+      InferenceStrategy strategy) const;
+
+  std::string getElementName(ScAddr const & element) const;
+
+  ScMemoryContext * context;
+  std::string bundleDirectory;
+
+  /// Recorded elements in order of adding
+  ScAddrVector recordedElements;
+  std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> recordedElementsSet;
+  std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> formulasElements;
+};
+
+}  // namespace inference
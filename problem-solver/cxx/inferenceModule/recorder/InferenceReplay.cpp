@@ -0,0 +1,145 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "InferenceReplay.hpp"
+
+#include <cctype>
+#include <fstream>
+
+#include "InferenceRecorder.hpp"
+
+namespace inference
+{
+namespace
+{
+/// Append strings in quotes and numbers of `value` to `values`, identifiers of elements have no quotes to escape
+void parseManifestValue(std::string const & value, std::vector<std::string> & values)
+{
+  size_t position = 0;
+  while (position < value.size())
+  {
+    char const symbol = value[position];
+    if (symbol == '"')
+    {
+      size_t const stringEnd = value.find('"', position + 1);
+      if (stringEnd == std::string::npos)
+        return;
+      values.push_back(value.substr(position + 1, stringEnd - position - 1));
+      position = stringEnd + 1;
+    }
+    else if (std::isdigit(static_cast<unsigned char>(symbol)))
+    {
+      size_t const numberEnd = value.find_first_not_of("0123456789", position);
+      values.push_back(value.substr(position, numberEnd - position));
+      position = numberEnd == std::string::npos ? value.size() : numberEnd;
+    }
+    else
+      ++position;
+  }
+}
+}  // namespace
+
+/// The manifest is written by InferenceRecorder with a key and its value in every line
+InferenceReplay::InferenceReplay(std::string const & bundleDirectory)
+  : bundleDirectory(bundleDirectory)
+{
+  std::string const manifestPath = bundleDirectory + "/" + InferenceRecorder::MANIFEST_FILE_NAME;
+  std::ifstream manifest(manifestPath);
+  if (!manifest.is_open())
+  {
+    SC_THROW_EXCEPTION(utils::ExceptionItemNotFound, "Inference manifest " << manifestPath << " can't be read.");
+  }
+
+  for (std::string line; std::getline(manifest, line);)
+  {
+    size_t const keyBegin = line.find('"');
+    size_t const keyEnd = line.find("\":", keyBegin + 1);
+    if (keyBegin == std::string::npos || keyEnd == std::string::npos)
+      continue;
+    std::vector<std::string> & values = manifestValues[line.substr(keyBegin + 1, keyEnd - keyBegin - 1)];
+    parseManifestValue(line.substr(keyEnd + 2), values);
+  }
+
+  if (getNumber("version") != InferenceRecorder::MANIFEST_VERSION)
+  {
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidParams, "Inference manifest " << manifestPath << " has unsupported version.");
+  }
+}
+
+std::string InferenceReplay::getBundlePath() const
+{
+  return bundleDirectory + "/" + getValue("bundle");
+}
+
+InferenceConfig InferenceReplay::getConfig() const
+{
+  InferenceConfig inferenceConfig;
+  inferenceConfig.generationType = static_cast<GenerationType>(getNumber("generationType"));
+  inferenceConfig.replacementsUsingType = static_cast<ReplacementsUsingType>(getNumber("replacementsUsingType"));
+  inferenceConfig.solutionTreeType = static_cast<SolutionTreeType>(getNumber("solutionTreeType"));
+  inferenceConfig.searchType = static_cast<SearchType>(getNumber("searchType"));
+  inferenceConfig.joinConfig.threadsAmount = getNumber("joinThreadsAmount");
+  inferenceConfig.joinConfig.parallelThreshold = getNumber("joinParallelThreshold");
+  inferenceConfig.joinConfig.deterministic = getNumber("joinDeterministic") != 0;
+  inferenceConfig.joinConfig.memoryThreshold = getNumber("joinMemoryThreshold");
+  inferenceConfig.workersAmount = getNumber("workersAmount");
+  inferenceConfig.orderedCommit = getNumber("orderedCommit") != 0;
+  inferenceConfig.identityType = static_cast<IdentityType>(getNumber("identityType"));
+  inferenceConfig.frontierSize = getNumber("frontierSize");
+  return inferenceConfig;
+}
+
+InferenceStrategy InferenceReplay::getStrategy() const
+{
+  return static_cast<InferenceStrategy>(getNumber("strategy"));
+}
+
+InferenceParams InferenceReplay::createInferenceParams(ScMemoryContext * context) const
+{
+  auto const resolveElements = [this, context](std::string const & key) {
+    ScAddrVector elements;
+    for (std::string const & name : getValues(key))
+      elements.push_back(context->HelperResolveSystemIdtf(name));
+    return elements;
+  };
+
+  InferenceParams inferenceParams;
+  inferenceParams.formulasSet = context->HelperFindBySystemIdtf(getValue("formulasSet"));
+  inferenceParams.arguments = resolveElements("arguments");
+  inferenceParams.inputStructures = resolveElements("inputStructures");
+  inferenceParams.outputStructure = context->CreateNode(ScType::NodeConstStruct);
+  inferenceParams.targetStructures = resolveElements("targetStructures");
+  inferenceParams.targetsType = static_cast<TargetsType>(getNumber("targetsType"));
+  return inferenceParams;
+}
+
+std::vector<std::string> const & InferenceReplay::getValues(std::string const & key) const
+{
+  auto const & values = manifestValues.find(key);
+  if (values == manifestValues.cend())
+  {
+    SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Inference manifest has no " << key << ".");
+  }
+  return values->second;
+}
+
+std::string const & InferenceReplay::getValue(std::string const & key) const
+{
+  std::vector<std::string> const & values = getValues(key);
+  if (values.empty())
+  {
+    SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Inference manifest has no value of " << key << ".");
+  }
+  return values.front();
+}
+
+size_t InferenceReplay::getNumber(std::string const & key) const
+{
+  return std::stoul(getValue(key));
+}
+
+}  // namespace inference
@@ -0,0 +1,54 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sc-memory/sc_memory.hpp"
+
+#include "inferenceConfig/InferenceConfig.hpp"
+
+namespace inference
+{
+/// Params and config of inference recorded by InferenceRecorder, they are read from the manifest of the bundle
+class InferenceReplay
+{
+public:
+  /**
+   * @param bundleDirectory is a directory with the bundle and the manifest
+   * @throws utils::ExceptionItemNotFound Thrown if the manifest can't be read
+   * @throws utils::ExceptionInvalidParams Thrown if the manifest has other version
+   */
+  explicit InferenceReplay(std::string const & bundleDirectory);
+
+  /// @returns path of the scs bundle which is loaded to memory before inference is replayed
+  std::string getBundlePath() const;
+
+  InferenceConfig getConfig() const;
+
+  InferenceStrategy getStrategy() const;
+
+  /// Find elements of params in memory with the loaded bundle by system identifiers, output structure is created
+  InferenceParams createInferenceParams(ScMemoryContext * context) const;
+
+private:
+  /// @throws utils::ExceptionInvalidParams Thrown if the manifest has no key
+  std::vector<std::string> const & getValues(std::string const & key) const;
+
+  /// @throws utils::ExceptionInvalidParams Thrown if the manifest has no value with the key
+  std::string const & getValue(std::string const & key) const;
+
+  size_t getNumber(std::string const & key) const;
+
+  std::string bundleDirectory;
+  /// Values of the manifest by keys, a value which is not an array is a single value
+  std::map<std::string, std::vector<std::string>> manifestValues;
+};
+
+}  // namespace inference
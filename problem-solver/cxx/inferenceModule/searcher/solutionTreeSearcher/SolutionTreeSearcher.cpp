@@ -11,7 +11,7 @@ SolutionTreeSearcher::SolutionTreeSearcher(ScMemoryContext * context)
 bool SolutionTreeSearcher::checkIfSolutionNodeExists(
     ScAddr const & rule,
     ScTemplateParams const & templateParams,
-    std::set<std::string> const & varNames)
+    VarNames const & varNames)
 {
   ScTemplate solutionNodeTemplate;
   ScTemplateSearchResult searchResult;
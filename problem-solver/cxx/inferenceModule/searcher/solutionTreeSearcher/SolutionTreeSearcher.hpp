@@ -4,6 +4,8 @@
 #include "sc-memory/sc_addr.hpp"
 #include "sc-agents-common/keynodes/coreKeynodes.hpp"
 
+#include "utils/ReplacementsUtils.hpp"
+
 namespace inference
 {
 class SolutionTreeSearcher
@@ -14,7 +16,7 @@ public:
   bool checkIfSolutionNodeExists(
       ScAddr const & formula,
       ScTemplateParams const & templateParams,
-      std::set<std::string> const & varNames);
+      VarNames const & varNames);
 
 private:
   ScMemoryContext * context;
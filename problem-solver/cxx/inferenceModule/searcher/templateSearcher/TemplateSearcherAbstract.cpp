@@ -6,10 +6,38 @@
 
 #include "TemplateSearcherAbstract.hpp"
 
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <thread>
+
 #include "sc-agents-common/utils/CommonUtils.hpp"
 
+#include "keynodes/InferenceKeynodes.hpp"
+
 using namespace inference;
 
+namespace
+{
+/// Less rows are searched sequentially, because starting of workers takes more time than search
+size_t const MIN_CONCURRENTLY_SEARCHED_ROWS_AMOUNT = 16;
+/// Rows are split to more ranges than workers, so workers which have finished steal ranges of slower ones
+size_t const SEARCH_TASKS_PER_WORKER_AMOUNT = 4;
+}  // namespace
+
+thread_local ScMemoryContextPool::Lease const * TemplateSearcherAbstract::currentLease = nullptr;
+
+TemplateSearcherAbstract::ContextScope::ContextScope(ScMemoryContextPool::Lease const & lease)
+  : previousLease(currentLease)
+{
+  currentLease = &lease;
+}
+
+TemplateSearcherAbstract::ContextScope::~ContextScope()
+{
+  currentLease = previousLease;
+}
+
 TemplateSearcherAbstract::TemplateSearcherAbstract(ScMemoryContext * context)
   : context(context)
 {
@@ -18,6 +46,10 @@ TemplateSearcherAbstract::TemplateSearcherAbstract(ScMemoryContext * context)
 void TemplateSearcherAbstract::setInputStructures(ScAddrVector const & otherInputStructures)
 {
   inputStructures = otherInputStructures;
+  // Links content of templates depends on input structures
+  caches.clear();
+  if (contextPool != nullptr)
+    contextPool->clearCaches();
 }
 
 ScAddrVector TemplateSearcherAbstract::getInputStructures() const
@@ -25,73 +57,509 @@ ScAddrVector TemplateSearcherAbstract::getInputStructures() const
   return inputStructures;
 }
 
+void TemplateSearcherAbstract::setContextPool(std::shared_ptr<ScMemoryContextPool> pool)
+{
+  contextPool = std::move(pool);
+}
+
+void TemplateSearcherAbstract::setScheduler(std::shared_ptr<WorkStealingScheduler> otherScheduler)
+{
+  scheduler = std::move(otherScheduler);
+}
+
+void TemplateSearcherAbstract::setIdentityClasses(std::shared_ptr<IdentityClasses const> otherIdentityClasses)
+{
+  identityClasses = std::move(otherIdentityClasses);
+}
+
+size_t TemplateSearcherAbstract::getSearchesAmount() const
+{
+  return searchesAmount;
+}
+
+ScMemoryContext * TemplateSearcherAbstract::getSearchContext() const
+{
+  return currentLease != nullptr ? currentLease->getContext() : context;
+}
+
+ScMemoryContextCaches & TemplateSearcherAbstract::getSearchCaches()
+{
+  return currentLease != nullptr ? currentLease->getCaches() : caches;
+}
+
+void TemplateSearcherAbstract::searchTemplate(
+    ScAddr const & templateAddr,
+    ScTemplateParams const & templateParams,
+    VarNames const & varNames,
+    Replacements & result)
+{
+  if (identityClasses != nullptr)
+  {
+    searchTemplate(templateAddr, vector<ScTemplateParams>{templateParams}, varNames, result);
+    return;
+  }
+  ++searchesAmount;
+  searchTemplateInContext(getSearchContext(), getSearchCaches(), templateAddr, templateParams, varNames, result);
+}
+
 void TemplateSearcherAbstract::searchTemplate(
     ScAddr const & templateAddr,
     vector<ScTemplateParams> const & scTemplateParamsVector,
-    std::set<std::string> const & varNames,
+    VarNames const & varNames,
     Replacements & result)
 {
-  Replacements searchResults;
-  ScAddrVector varNameReplacementValues;
-  ScAddr argument;
+  if (identityClasses == nullptr)
+  {
+    searchTemplateRows(templateAddr, scTemplateParamsVector, varNames, result);
+    return;
+  }
+
+  searchTemplateRows(templateAddr, getIdenticalParams(scTemplateParamsVector, varNames), varNames, result);
+  replaceByRepresentatives(result);
+}
 
+void TemplateSearcherAbstract::searchTemplateRows(
+    ScAddr const & templateAddr,
+    vector<ScTemplateParams> const & scTemplateParamsVector,
+    VarNames const & varNames,
+    Replacements & result)
+{
+  if (currentLease == nullptr && contextPool != nullptr &&
+      scTemplateParamsVector.size() >= MIN_CONCURRENTLY_SEARCHED_ROWS_AMOUNT)
+    searchRowsConcurrently(templateAddr, scTemplateParamsVector, varNames, result);
+  else
+    searchRows(
+        getSearchContext(),
+        getSearchCaches(),
+        templateAddr,
+        scTemplateParamsVector,
+        0,
+        scTemplateParamsVector.size(),
+        varNames,
+        result);
+}
+
+/// Params of variables which are not in `varNames` are not in the template, so they are not added to rows
+vector<ScTemplateParams> TemplateSearcherAbstract::getIdenticalParams(
+    vector<ScTemplateParams> const & scTemplateParamsVector,
+    VarNames const & varNames) const
+{
+  vector<ScTemplateParams> identicalParamsVector;
+  ScAddr argument;
   for (ScTemplateParams const & scTemplateParams : scTemplateParamsVector)
   {
-    searchTemplate(templateAddr, scTemplateParams, varNames, searchResults);
+    std::vector<std::pair<std::string, ScAddrVector>> identicalArguments;
     for (std::string const & varName : varNames)
     {
-      if (searchResults.count(varName))
+      if (scTemplateParams.Get(varName, argument))
+        identicalArguments.emplace_back(varName, identityClasses->getIdenticalElements(argument));
+    }
+
+    // Combinations are enumerated as numbers with digits of positions of identical arguments
+    std::vector<size_t> positions(identicalArguments.size(), 0);
+    size_t changedPosition;
+    do
+    {
+      ScTemplateParams identicalParams;
+      for (size_t argumentIndex = 0; argumentIndex < identicalArguments.size(); ++argumentIndex)
       {
-        varNameReplacementValues = searchResults.at(varName);
-        if (scTemplateParams.Get(varName, argument))
+        auto const & identicalArgument = identicalArguments[argumentIndex];
+        identicalParams.Add(identicalArgument.first, identicalArgument.second[positions[argumentIndex]]);
+      }
+      identicalParamsVector.push_back(std::move(identicalParams));
+
+      for (changedPosition = 0; changedPosition < positions.size(); ++changedPosition)
+      {
+        if (++positions[changedPosition] < identicalArguments[changedPosition].second.size())
+          break;
+        positions[changedPosition] = 0;
+      }
+    } while (changedPosition < positions.size());
+  }
+  return identicalParamsVector;
+}
+
+void TemplateSearcherAbstract::replaceByRepresentatives(Replacements & result) const
+{
+  if (result.empty())
+    return;
+
+  size_t const columnsAmount = result.cbegin()->second.size();
+  std::set<std::vector<ScAddr::HashType>> foundColumns;
+  std::vector<ScAddr::HashType> column;
+  size_t uniqueColumnsAmount = 0;
+  for (size_t columnIndex = 0; columnIndex < columnsAmount; ++columnIndex)
+  {
+    column.clear();
+    for (auto & varReplacements : result)
+    {
+      ScAddr const & representative = identityClasses->getRepresentative(varReplacements.second[columnIndex]);
+      varReplacements.second[uniqueColumnsAmount] = representative;
+      column.push_back(representative.Hash());
+    }
+    if (foundColumns.insert(column).second)
+      ++uniqueColumnsAmount;
+  }
+
+  for (auto & varReplacements : result)
+    varReplacements.second.resize(uniqueColumnsAmount);
+}
+
+/**
+ * @brief Replacements of params are added once for every found column of the row, rows without found columns are
+ * skipped
+ */
+void TemplateSearcherAbstract::searchRows(
+    ScMemoryContext * searchContext,
+    ScMemoryContextCaches & searchCaches,
+    ScAddr const & templateAddr,
+    vector<ScTemplateParams> const & scTemplateParamsVector,
+    size_t beginIndex,
+    size_t endIndex,
+    VarNames const & varNames,
+    Replacements & result)
+{
+  Replacements rowResult;
+  ScAddr argument;
+  for (size_t rowIndex = beginIndex; rowIndex < endIndex; ++rowIndex)
+  {
+    ScTemplateParams const & scTemplateParams = scTemplateParamsVector[rowIndex];
+    rowResult.clear();
+    ++searchesAmount;
+    searchTemplateInContext(searchContext, searchCaches, templateAddr, scTemplateParams, varNames, rowResult);
+    if (rowResult.empty())
+      continue;
+
+    size_t columnsAmount = 1;
+    for (std::string const & varName : varNames)
+    {
+      auto const & varReplacements = rowResult.find(varName);
+      if (varReplacements != rowResult.cend() && !scTemplateParams.Get(varName, argument))
+        columnsAmount = varReplacements->second.size();
+    }
+    for (std::string const & varName : varNames)
+    {
+      auto const & varReplacements = rowResult.find(varName);
+      if (varReplacements == rowResult.cend())
+        continue;
+      ScAddrVector & resultReplacements = result[varName];
+      if (scTemplateParams.Get(varName, argument))
+        resultReplacements.insert(resultReplacements.end(), columnsAmount, argument);
+      else
+        resultReplacements.insert(
+            resultReplacements.end(), varReplacements->second.cbegin(), varReplacements->second.cend());
+    }
+  }
+}
+
+/**
+ * @brief Rows are split to contiguous ranges searched with contexts of the pool, by tasks of the scheduler or by a
+ * thread per range. Every range is searched to its own buffer, buffers are appended to `result` in order of ranges, so
+ * the result is the same as the result of sequential search
+ */
+void TemplateSearcherAbstract::searchRowsConcurrently(
+    ScAddr const & templateAddr,
+    vector<ScTemplateParams> const & scTemplateParamsVector,
+    VarNames const & varNames,
+    Replacements & result)
+{
+  size_t const rowsAmount = scTemplateParamsVector.size();
+  size_t rangesAmount = std::min(contextPool->getSize(), rowsAmount);
+  if (scheduler != nullptr)
+    rangesAmount = std::min(rangesAmount * SEARCH_TASKS_PER_WORKER_AMOUNT, rowsAmount);
+
+  std::vector<Replacements> rangesResults(rangesAmount);
+  auto const searchRange = [this, &templateAddr, &scTemplateParamsVector, &varNames, &rangesResults, rowsAmount,
+                            rangesAmount](size_t rangeIndex) {
+    ScMemoryContextPool::Lease const lease = contextPool->checkout();
+    searchRows(
+        lease.getContext(),
+        lease.getCaches(),
+        templateAddr,
+        scTemplateParamsVector,
+        rowsAmount * rangeIndex / rangesAmount,
+        rowsAmount * (rangeIndex + 1) / rangesAmount,
+        varNames,
+        rangesResults[rangeIndex]);
+  };
+
+  if (scheduler != nullptr)
+  {
+    WorkStealingScheduler::TaskGroup searchTasks(*scheduler);
+    for (size_t rangeIndex = 0; rangeIndex < rangesAmount; ++rangeIndex)
+      searchTasks.run([&searchRange, rangeIndex]() { searchRange(rangeIndex); });
+    searchTasks.wait();
+  }
+  else
+  {
+    std::vector<std::exception_ptr> rangesExceptions(rangesAmount);
+    std::vector<std::thread> workers;
+    workers.reserve(rangesAmount);
+    for (size_t rangeIndex = 0; rangeIndex < rangesAmount; ++rangeIndex)
+    {
+      workers.emplace_back([&searchRange, &rangesExceptions, rangeIndex]() {
+        try
         {
-          result[varName].push_back(argument);
+          searchRange(rangeIndex);
         }
-        else if (!varNameReplacementValues.empty())
+        catch (...)
         {
-          result[varName] = varNameReplacementValues;
+          rangesExceptions[rangeIndex] = std::current_exception();
         }
+      });
+    }
+    for (std::thread & worker : workers)
+      worker.join();
+
+    for (std::exception_ptr const & exception : rangesExceptions)
+    {
+      if (exception)
+        std::rethrow_exception(exception);
+    }
+  }
+
+  for (Replacements const & rangeResult : rangesResults)
+  {
+    for (auto const & pair : rangeResult)
+    {
+      ScAddrVector & resultReplacements = result[pair.first];
+      resultReplacements.insert(resultReplacements.end(), pair.second.cbegin(), pair.second.cend());
+    }
+  }
+}
+
+bool TemplateSearcherAbstract::isTemplateWithLinks(
+    ScMemoryContext * searchContext,
+    ScMemoryContextCaches & searchCaches,
+    ScAddr const & templateAddr)
+{
+  auto const & cachedValue = searchCaches.templatesWithLinks.find(templateAddr);
+  if (cachedValue != searchCaches.templatesWithLinks.cend())
+    return cachedValue->second;
+
+  bool const isWithLinks = searchContext->HelperCheckEdge(
+      InferenceKeynodes::concept_template_with_links, templateAddr, ScType::EdgeAccessConstPosPerm);
+  searchCaches.templatesWithLinks.emplace(templateAddr, isWithLinks);
+  return isWithLinks;
+}
+
+std::map<std::string, TemplateLinkContent> const & TemplateSearcherAbstract::getCachedTemplateLinksContent(
+    ScMemoryContext * searchContext,
+    ScMemoryContextCaches & searchCaches,
+    ScAddr const & templateAddr)
+{
+  auto cachedLinksContent = searchCaches.templatesLinksContent.find(templateAddr);
+  if (cachedLinksContent == searchCaches.templatesLinksContent.end())
+    cachedLinksContent = searchCaches.templatesLinksContent
+                             .emplace(templateAddr, getTemplateLinksContent(searchContext, templateAddr))
+                             .first;
+  return cachedLinksContent->second;
+}
+
+bool TemplateSearcherAbstract::hasLinksWithTemplateContent(
+    ScMemoryContext * searchContext,
+    ScMemoryContextCaches & searchCaches,
+    std::map<std::string, TemplateLinkContent> const & linksContentMap)
+{
+  for (auto const & contentMap : linksContentMap)
+  {
+    TemplateLinkContent const & linkContent = contentMap.second;
+    if (linkContent.isComparison || linkContent.content.empty())
+      continue;
+
+    // Inference doesn't erase links, so only content which is not found yet is searched again
+    ScAddrUnorderedSet & matches = searchCaches.templateLinksMatches[linkContent.link];
+    if (!matches.empty())
+      continue;
+    for (ScAddr const & link : searchContext->FindLinksByContent(linkContent.content))
+    {
+      if (link != linkContent.link)
+        matches.insert(link);
+    }
+    if (matches.empty())
+      return false;
+  }
+  return true;
+}
+
+LinkContent const & TemplateSearcherAbstract::getLinkContent(
+    ScMemoryContext * searchContext,
+    ScMemoryContextCaches & searchCaches,
+    ScAddr const & link)
+{
+  auto cachedContent = searchCaches.linksContent.find(link);
+  if (cachedContent == searchCaches.linksContent.end())
+  {
+    LinkContent linkContent;
+    searchContext->GetLinkContent(link, linkContent.content);
+    linkContent.contentHash = std::hash<std::string>()(linkContent.content);
+    cachedContent = searchCaches.linksContent.emplace(link, std::move(linkContent)).first;
+  }
+  return cachedContent->second;
+}
+
+bool TemplateSearcherAbstract::isLinkInRange(
+    ScMemoryContext * searchContext,
+    ScMemoryContextCaches & searchCaches,
+    ScAddr const & link,
+    TemplateLinkContent const & templateLinkContent)
+{
+  NumericLinksIndex & numericLinksIndex = searchCaches.numericLinksIndex;
+  if (!searchCaches.isNumericLinksIndexBuilt)
+  {
+    std::string linkContent;
+    for (ScAddr const & structure : inputStructures)
+    {
+      ScIterator3Ptr const linksIterator =
+          searchContext->Iterator3(structure, ScType::EdgeAccessConstPosPerm, ScType::Link);
+      while (linksIterator->Next())
+      {
+        linkContent.clear();
+        searchContext->GetLinkContent(linksIterator->Get(2), linkContent);
+        numericLinksIndex.add(linksIterator->Get(2), linkContent);
       }
     }
+    searchCaches.isNumericLinksIndexBuilt = true;
   }
+
+  if (numericLinksIndex.contains(link))
+  {
+    auto rangeLinks = searchCaches.rangesLinks.find(templateLinkContent.link);
+    if (rangeLinks == searchCaches.rangesLinks.end())
+      rangeLinks = searchCaches.rangesLinks
+                       .emplace(templateLinkContent.link, numericLinksIndex.findInRange(templateLinkContent.range))
+                       .first;
+    return rangeLinks->second.count(link) > 0;
+  }
+
+  // Links out of input structures are found by search in all knowledge base or are added to structures by inference
+  auto cachedValue = searchCaches.linksNumericValues.find(link);
+  if (cachedValue == searchCaches.linksNumericValues.end())
+  {
+    std::string linkContent;
+    searchContext->GetLinkContent(link, linkContent);
+    double value = std::nan("");
+    NumericLinksIndex::parseNumber(linkContent, value);
+    cachedValue = searchCaches.linksNumericValues.emplace(link, value).first;
+  }
+  return !std::isnan(cachedValue->second) && templateLinkContent.range.contains(cachedValue->second);
 }
 
-void TemplateSearcherAbstract::getVarNames(ScAddr const & formula, std::set<std::string> & varNames)
+TemplateLinkContent TemplateSearcherAbstract::createTemplateLinkContent(
+    ScMemoryContext * searchContext,
+    ScAddr const & templateAddr,
+    ScAddr const & link,
+    std::string const & content) const
 {
+  TemplateLinkContent linkContent;
+  linkContent.link = link;
+  linkContent.content = content;
+  linkContent.contentHash = std::hash<std::string>()(content);
+  ScIterator5Ptr const rolesIterator = searchContext->Iterator5(
+      templateAddr, ScType::EdgeAccessConstPosPerm, link, ScType::EdgeAccessConstPosPerm, ScType::NodeConstRole);
+  double bound;
+  while (!linkContent.isComparison && rolesIterator->Next())
+  {
+    ScAddr const & role = rolesIterator->Get(4);
+    bool const isUpperBound = role == InferenceKeynodes::rrel_less || role == InferenceKeynodes::rrel_less_or_equal;
+    bool const isLowerBound =
+        role == InferenceKeynodes::rrel_greater || role == InferenceKeynodes::rrel_greater_or_equal;
+    if (role == InferenceKeynodes::rrel_range)
+    {
+      linkContent.isComparison = NumericLinksIndex::parseRange(content, linkContent.range);
+    }
+    else if ((isUpperBound || isLowerBound) && NumericLinksIndex::parseNumber(content, bound))
+    {
+      linkContent.isComparison = true;
+      if (isUpperBound)
+      {
+        linkContent.range.upperBound = bound;
+        linkContent.range.isUpperBoundIncluded = role == InferenceKeynodes::rrel_less_or_equal;
+      }
+      else
+      {
+        linkContent.range.lowerBound = bound;
+        linkContent.range.isLowerBoundIncluded = role == InferenceKeynodes::rrel_greater_or_equal;
+      }
+    }
+  }
+  return linkContent;
+}
+
+void TemplateSearcherAbstract::getVarNames(ScAddr const & formula, VarNames & varNames)
+{
+  ScMemoryContext * searchContext = getSearchContext();
   ScIterator3Ptr const & formulaVariablesIterator =
-      context->Iterator3(formula, ScType::EdgeAccessConstPosPerm, ScType::Unknown);
+      searchContext->Iterator3(formula, ScType::EdgeAccessConstPosPerm, ScType::Unknown);
   ScAddr element;
   std::string variableSystemIdtf;
   while (formulaVariablesIterator->Next())
   {
     element = formulaVariablesIterator->Get(2);
     // TODO(MksmOrlov): replace with ScType::Var after new memory realisation
-    if (context->GetElementType(element) == ScType::NodeVar || context->GetElementType(element) == ScType::LinkVar)
+    if (searchContext->GetElementType(element) == ScType::NodeVar ||
+        searchContext->GetElementType(element) == ScType::LinkVar)
     {
-      variableSystemIdtf = context->HelperGetSystemIdtf(element);
+      variableSystemIdtf = searchContext->HelperGetSystemIdtf(element);
       if (!variableSystemIdtf.empty())
         varNames.insert(variableSystemIdtf);
     }
   }
 }
 
+bool TemplateSearcherAbstract::isSearchable(ScMemoryContext *, ScAddr const &) const
+{
+  return true;
+}
+
+std::vector<std::pair<ScAddr, ScAddr>> TemplateSearcherAbstract::findRelationPairs(
+    ScMemoryContext * searchContext,
+    ScAddr const & relation) const
+{
+  std::vector<std::pair<ScAddr, ScAddr>> pairs;
+  if (!isSearchable(searchContext, relation))
+    return pairs;
+
+  ScIterator3Ptr const pairsIterator =
+      searchContext->Iterator3(relation, ScType::EdgeAccessConstPosPerm, ScType::EdgeDCommonConst);
+  ScAddr begin;
+  ScAddr end;
+  while (pairsIterator->Next())
+  {
+    ScAddr const & pairArc = pairsIterator->Get(2);
+    searchContext->GetEdgeInfo(pairArc, begin, end);
+    if (isSearchable(searchContext, pairsIterator->Get(1)) && isSearchable(searchContext, pairArc) &&
+        isSearchable(searchContext, begin) && isSearchable(searchContext, end))
+      pairs.emplace_back(begin, end);
+  }
+  return pairs;
+}
+
 bool TemplateSearcherAbstract::isContentIdentical(
+    ScMemoryContext * searchContext,
+    ScMemoryContextCaches & searchCaches,
     ScTemplateSearchResultItem const & item,
-    std::map<std::string, std::string> const & linksContentMap)
+    std::map<std::string, TemplateLinkContent> const & linksContentMap)
 {
-  bool result = true;
   ScAddr link;
-  std::string linkContent;
   for (auto const & contentMap : linksContentMap)
   {
     item.Get(contentMap.first, link);
-    context->GetLinkContent(link, linkContent);
-    if (contentMap.second != linkContent)
+    if (contentMap.second.isComparison)
     {
-      result = false;
-      break;
+      if (!isLinkInRange(searchContext, searchCaches, link, contentMap.second))
+        return false;
+      continue;
     }
+
+    // Links found by the content index have the content, links generated after it are compared by hash and content
+    auto const & matches = searchCaches.templateLinksMatches.find(contentMap.second.link);
+    if (matches != searchCaches.templateLinksMatches.cend() && matches->second.count(link) > 0)
+      continue;
+    LinkContent const & linkContent = getLinkContent(searchContext, searchCaches, link);
+    if (linkContent.contentHash != contentMap.second.contentHash || linkContent.content != contentMap.second.content)
+      return false;
   }
 
-  return result;
+  return true;
 }
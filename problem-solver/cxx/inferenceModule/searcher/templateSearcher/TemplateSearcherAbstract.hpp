@@ -8,13 +8,22 @@
 
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
 
 #include "sc-memory/sc_memory.hpp"
 #include "sc-memory/sc_addr.hpp"
 
 #include "sc-agents-common/utils/CommonUtils.hpp"
 
+#include "utils/IdentityClasses.hpp"
 #include "utils/ReplacementsUtils.hpp"
+#include "utils/ScMemoryContextPool.hpp"
+#include "utils/WorkStealingScheduler.hpp"
 
 namespace inference
 {
@@ -22,44 +31,192 @@ namespace inference
 class TemplateSearcherAbstract
 {
 public:
+  /**
+   * Make searchers use the context of `lease` in this thread until the scope ends. It is opened by a task which uses
+   * one worker context for all its searches, so rows are searched sequentially in the scope
+   */
+  class ContextScope
+  {
+  public:
+    explicit ContextScope(ScMemoryContextPool::Lease const & lease);
+    ~ContextScope();
+
+    ContextScope(ContextScope const & other) = delete;
+    ContextScope & operator=(ContextScope const & other) = delete;
+
+  private:
+    ScMemoryContextPool::Lease const * previousLease;
+  };
+
   explicit TemplateSearcherAbstract(ScMemoryContext * context);
 
   virtual ~TemplateSearcherAbstract() = default;
 
   // TODO(MksmOrlov): implement searcher with default search template, configure searcher to use smart search or default
-  virtual void searchTemplate(
+  void searchTemplate(
       ScAddr const & templateAddr,
       ScTemplateParams const & templateParams,
-      std::set<std::string> const & varNames,
-      Replacements & result) = 0;
+      VarNames const & varNames,
+      Replacements & result);
 
+  /**
+   * @brief Search template with every params row and append replacements of rows to `result` in order of rows. If
+   * context pool is set and there are enough rows, rows are searched by workers concurrently. If identity classes are
+   * set, params are replaced by every identical element and found elements are replaced by their representatives
+   */
   virtual void searchTemplate(
       ScAddr const & templateAddr,
       vector<ScTemplateParams> const & scTemplateParamsVector,
-      std::set<std::string> const & varNames,
+      VarNames const & varNames,
       Replacements & result);
 
-  void getVarNames(ScAddr const & formula, std::set<std::string> & varNames);
+  void getVarNames(ScAddr const & formula, VarNames & varNames);
 
+  /// @returns true if `element` may be in found constructions, every element may be found if it is not overridden
+  virtual bool isSearchable(ScMemoryContext * searchContext, ScAddr const & element) const;
+
+  /// @returns begins and ends of pairs `begin => relation: end` which may be in found constructions
+  std::vector<std::pair<ScAddr, ScAddr>> findRelationPairs(ScMemoryContext * searchContext, ScAddr const & relation)
+      const;
+
+  /**
+   * @brief Compare content of links of `item` with content of template links, content is compared only if hashes are
+   * equal. Numeric content of links is compared with ranges of template links with comparison roles (rrel_less,
+   * rrel_less_or_equal, rrel_greater, rrel_greater_or_equal, rrel_range)
+   */
   bool isContentIdentical(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
       ScTemplateSearchResultItem const & item,
-      std::map<std::string, std::string> const & linksContentMap);
+      std::map<std::string, TemplateLinkContent> const & linksContentMap);
 
   void setInputStructures(ScAddrVector const & otherInputStructures);
 
   ScAddrVector getInputStructures() const;
 
+  void setContextPool(std::shared_ptr<ScMemoryContextPool> pool);
+
+  void setScheduler(std::shared_ptr<WorkStealingScheduler> otherScheduler);
+
+  /// Set classes of identical elements of the inference run, search is not aware of identity if it is nullptr
+  void setIdentityClasses(std::shared_ptr<IdentityClasses const> otherIdentityClasses);
+
+  /// @returns amount of searches of a template with a row of params, it is the same for sequential and concurrent
+  /// search
+  size_t getSearchesAmount() const;
+
 protected:
+  /// Search template by `searchContext`, it is the context of the searcher or a context of a worker
+  virtual void searchTemplateInContext(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
+      ScAddr const & templateAddr,
+      ScTemplateParams const & templateParams,
+      VarNames const & varNames,
+      Replacements & result) = 0;
+
   virtual void searchTemplateWithContent(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
       ScTemplate const & searchTemplate,
       ScAddr const & templateAddr,
       ScTemplateParams const & templateParams,
+      VarNames const & varNames,
       Replacements & result) = 0;
 
-  virtual std::map<std::string, std::string> getTemplateLinksContent(ScAddr const & templateAddr) = 0;
+  virtual std::map<std::string, TemplateLinkContent> getTemplateLinksContent(
+      ScMemoryContext * searchContext,
+      ScAddr const & templateAddr) = 0;
+
+  bool isTemplateWithLinks(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
+      ScAddr const & templateAddr);
+
+  std::map<std::string, TemplateLinkContent> const & getCachedTemplateLinksContent(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
+      ScAddr const & templateAddr);
+
+  /**
+   * @brief Check by the content index of sc-memory that there are other links with content of every template link, so
+   * a template can't be found and its structural search is skipped if it returns false
+   */
+  bool hasLinksWithTemplateContent(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
+      std::map<std::string, TemplateLinkContent> const & linksContentMap);
+
+  LinkContent const & getLinkContent(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
+      ScAddr const & link);
+
+  /**
+   * @brief Check if numeric content of `link` is in the range of the template link. Links of input structures are
+   * found by a range scan of the index of numeric links, content of other links is read once
+   */
+  bool isLinkInRange(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
+      ScAddr const & link,
+      TemplateLinkContent const & templateLinkContent);
+
+  /// Content of the template link, it is a comparison if the link is in the template with a comparison role
+  TemplateLinkContent createTemplateLinkContent(
+      ScMemoryContext * searchContext,
+      ScAddr const & templateAddr,
+      ScAddr const & link,
+      std::string const & content) const;
+
+  /// Search rows from `beginIndex` to `endIndex` and append their replacements to `result`
+  void searchRows(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
+      ScAddr const & templateAddr,
+      vector<ScTemplateParams> const & scTemplateParamsVector,
+      size_t beginIndex,
+      size_t endIndex,
+      VarNames const & varNames,
+      Replacements & result);
+
+  void searchTemplateRows(
+      ScAddr const & templateAddr,
+      vector<ScTemplateParams> const & scTemplateParamsVector,
+      VarNames const & varNames,
+      Replacements & result);
+
+  /// @returns rows of params with every combination of elements identical to elements of `scTemplateParamsVector`
+  vector<ScTemplateParams> getIdenticalParams(
+      vector<ScTemplateParams> const & scTemplateParamsVector,
+      VarNames const & varNames) const;
+
+  /// Replace elements of `result` by representatives of their classes and remove repeated columns
+  void replaceByRepresentatives(Replacements & result) const;
+
+  void searchRowsConcurrently(
+      ScAddr const & templateAddr,
+      vector<ScTemplateParams> const & scTemplateParamsVector,
+      VarNames const & varNames,
+      Replacements & result);
+
+  /// @returns context of the lease of the current context scope or the context of the searcher
+  ScMemoryContext * getSearchContext() const;
+
+  ScMemoryContextCaches & getSearchCaches();
 
   ScMemoryContext * context;
-  std::unique_ptr<ScTemplateSearchResult> searchWithoutContentResult;
+  /// Caches of the searcher context, they are cleared with caches of the context pool when input structures are set
+  ScMemoryContextCaches caches;
   ScAddrVector inputStructures;
+  /// Memory contexts to search concurrently, nullptr if search is sequential
+  std::shared_ptr<ScMemoryContextPool> contextPool;
+  /// Scheduler of concurrent search tasks, rows are searched by threads of their own if it is nullptr
+  std::shared_ptr<WorkStealingScheduler> scheduler;
+  /// Classes of identical elements, nullptr if search is not aware of identity
+  std::shared_ptr<IdentityClasses const> identityClasses;
+  std::atomic<size_t> searchesAmount{0};
+
+  static thread_local ScMemoryContextPool::Lease const * currentLease;
 };
 }  // namespace inference
@@ -21,23 +21,25 @@ TemplateSearcherGeneral::TemplateSearcherGeneral(ScMemoryContext * context)
 {
 }
 
-void TemplateSearcherGeneral::searchTemplate(
+void TemplateSearcherGeneral::searchTemplateInContext(
+    ScMemoryContext * searchContext,
+    ScMemoryContextCaches & searchCaches,
     ScAddr const & templateAddr,
     ScTemplateParams const & templateParams,
-    std::set<std::string> const & varNames,
+    VarNames const & varNames,
     Replacements & result)
 {
   ScTemplate searchTemplate;
-  if (context->HelperBuildTemplate(searchTemplate, templateAddr, templateParams))
+  if (searchContext->HelperBuildTemplate(searchTemplate, templateAddr, templateParams))
   {
-    if (context->HelperCheckEdge(
-            InferenceKeynodes::concept_template_with_links, templateAddr, ScType::EdgeAccessConstPosPerm))
+    if (isTemplateWithLinks(searchContext, searchCaches, templateAddr))
     {
-      searchTemplateWithContent(searchTemplate, templateAddr, templateParams, result);
+      searchTemplateWithContent(
+          searchContext, searchCaches, searchTemplate, templateAddr, templateParams, varNames, result);
     }
     else
     {
-      context->HelperSmartSearchTemplate(
+      searchContext->HelperSmartSearchTemplate(
           searchTemplate,
           [&templateParams, &result, &varNames](ScTemplateSearchResultItem const & item) -> ScTemplateSearchRequest {
             // Add search result items to the result Replacements
@@ -64,18 +66,22 @@ void TemplateSearcherGeneral::searchTemplate(
 }
 
 void TemplateSearcherGeneral::searchTemplateWithContent(
+    ScMemoryContext * searchContext,
+    ScMemoryContextCaches & searchCaches,
     ScTemplate const & searchTemplate,
     ScAddr const & templateAddr,
     ScTemplateParams const & templateParams,
+    VarNames const & varNames,
     Replacements & result)
 {
-  std::map<std::string, std::string> linksContentMap = getTemplateLinksContent(templateAddr);
-  std::set<std::string> varNames;
-  getVarNames(templateAddr, varNames);
+  std::map<std::string, TemplateLinkContent> const & linksContentMap =
+      getCachedTemplateLinksContent(searchContext, searchCaches, templateAddr);
+  if (!hasLinksWithTemplateContent(searchContext, searchCaches, linksContentMap))
+    return;
 
-  context->HelperSmartSearchTemplate(
+  searchContext->HelperSmartSearchTemplate(
       searchTemplate,
-      [templateParams, &result, &varNames](ScTemplateSearchResultItem const & item) -> ScTemplateSearchRequest {
+      [&templateParams, &result, &varNames](ScTemplateSearchResultItem const & item) -> ScTemplateSearchRequest {
         // Add search result items to the result Replacements
         for (std::string const & varName : varNames)
         {
@@ -91,23 +97,27 @@ void TemplateSearcherGeneral::searchTemplateWithContent(
         }
         return ScTemplateSearchRequest::STOP;
       },
-      [&linksContentMap, this](ScTemplateSearchResultItem const & item) -> bool {
+      [&linksContentMap, searchContext, &searchCaches, this](ScTemplateSearchResultItem const & item) -> bool {
         // Filter result item by the same content
-        return isContentIdentical(item, linksContentMap);
+        return isContentIdentical(searchContext, searchCaches, item, linksContentMap);
       });
 }
 
-std::map<std::string, std::string> TemplateSearcherGeneral::getTemplateLinksContent(ScAddr const & templateAddr)
+std::map<std::string, TemplateLinkContent> TemplateSearcherGeneral::getTemplateLinksContent(
+    ScMemoryContext * searchContext,
+    ScAddr const & templateAddr)
 {
-  std::map<std::string, std::string> linksContent;
-  ScIterator3Ptr linksIterator = context->Iterator3(templateAddr, ScType::EdgeAccessConstPosPerm, ScType::Link);
+  std::map<std::string, TemplateLinkContent> linksContent;
+  ScIterator3Ptr linksIterator =
+      searchContext->Iterator3(templateAddr, ScType::EdgeAccessConstPosPerm, ScType::Link);
   while (linksIterator->Next())
   {
     ScAddr const & linkAddr = linksIterator->Get(2);
     std::string stringContent;
-    if (context->GetLinkContent(linkAddr, stringContent))
+    if (searchContext->GetLinkContent(linkAddr, stringContent))
     {
-      linksContent.emplace(to_string(linkAddr.Hash()), stringContent);
+      linksContent.emplace(
+          to_string(linkAddr.Hash()), createTemplateLinkContent(searchContext, templateAddr, linkAddr, stringContent));
     }
   }
   return linksContent;
@@ -22,19 +22,26 @@ class TemplateSearcherGeneral : public TemplateSearcherAbstract
 public:
   explicit TemplateSearcherGeneral(ScMemoryContext * ms_context);
 
-  void searchTemplate(
+protected:
+  void searchTemplateInContext(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
       ScAddr const & templateAddr,
       ScTemplateParams const & templateParams,
-      std::set<std::string> const & varNames,
+      VarNames const & varNames,
       Replacements & result) override;
 
-protected:
   void searchTemplateWithContent(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
       ScTemplate const & searchTemplate,
       ScAddr const & templateAddr,
       ScTemplateParams const & templateParams,
+      VarNames const & varNames,
       Replacements & result) override;
 
-  std::map<std::string, std::string> getTemplateLinksContent(ScAddr const & templateAddr) override;
+  std::map<std::string, TemplateLinkContent> getTemplateLinksContent(
+      ScMemoryContext * searchContext,
+      ScAddr const & templateAddr) override;
 };
 }  // namespace inference
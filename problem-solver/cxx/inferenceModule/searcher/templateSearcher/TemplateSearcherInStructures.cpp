@@ -29,26 +29,35 @@ TemplateSearcherInStructures::TemplateSearcherInStructures(ScMemoryContext * con
 {
 }
 
-void TemplateSearcherInStructures::searchTemplate(
+bool TemplateSearcherInStructures::isSearchable(ScMemoryContext * searchContext, ScAddr const & element) const
+{
+  return std::any_of(
+      inputStructures.cbegin(), inputStructures.cend(), [&element, searchContext](ScAddr const & structure) -> bool {
+        return searchContext->HelperCheckEdge(structure, element, ScType::EdgeAccessConstPosPerm);
+      });
+}
+
+void TemplateSearcherInStructures::searchTemplateInContext(
+    ScMemoryContext * searchContext,
+    ScMemoryContextCaches & searchCaches,
     ScAddr const & templateAddr,
     ScTemplateParams const & templateParams,
-    std::set<std::string> const & varNames,
+    VarNames const & varNames,
     Replacements & result)
 {
-  searchWithoutContentResult = std::make_unique<ScTemplateSearchResult>();
   ScTemplate searchTemplate;
-  if (context->HelperBuildTemplate(searchTemplate, templateAddr, templateParams))
+  if (searchContext->HelperBuildTemplate(searchTemplate, templateAddr, templateParams))
   {
-    if (context->HelperCheckEdge(
-            InferenceKeynodes::concept_template_with_links, templateAddr, ScType::EdgeAccessConstPosPerm))
+    if (isTemplateWithLinks(searchContext, searchCaches, templateAddr))
     {
-      searchTemplateWithContent(searchTemplate, templateAddr, templateParams, result);
+      searchTemplateWithContent(
+          searchContext, searchCaches, searchTemplate, templateAddr, templateParams, varNames, result);
     }
     else
     {
-      context->HelperSmartSearchTemplate(
+      searchContext->HelperSmartSearchTemplate(
           searchTemplate,
-          [templateParams, &result, &varNames](ScTemplateSearchResultItem const & item) -> ScTemplateSearchRequest {
+          [&templateParams, &result, &varNames](ScTemplateSearchResultItem const & item) -> ScTemplateSearchRequest {
             // Add search result item to the answer container
             for (std::string const & varName : varNames)
             {
@@ -64,12 +73,9 @@ void TemplateSearcherInStructures::searchTemplate(
             }
             return ScTemplateSearchRequest::STOP;
           },
-          [this](ScAddr const & item) -> bool {
+          [searchContext, this](ScAddr const & item) -> bool {
             // Filter result item belonging to any of the input structures
-            return std::any_of(
-                inputStructures.cbegin(), inputStructures.cend(), [&item, this](ScAddr const & structure) -> bool {
-                  return context->HelperCheckEdge(structure, item, ScType::EdgeAccessConstPosPerm);
-                });
+            return isSearchable(searchContext, item);
           });
     }
   }
@@ -80,18 +86,22 @@ void TemplateSearcherInStructures::searchTemplate(
 }
 
 void TemplateSearcherInStructures::searchTemplateWithContent(
+    ScMemoryContext * searchContext,
+    ScMemoryContextCaches & searchCaches,
     ScTemplate const & searchTemplate,
     ScAddr const & templateAddr,
     ScTemplateParams const & templateParams,
+    VarNames const & varNames,
     Replacements & result)
 {
-  std::set<std::string> varNames;
-  getVarNames(templateAddr, varNames);
-  std::map<std::string, std::string> linksContentMap = getTemplateLinksContent(templateAddr);
+  std::map<std::string, TemplateLinkContent> const & linksContentMap =
+      getCachedTemplateLinksContent(searchContext, searchCaches, templateAddr);
+  if (!hasLinksWithTemplateContent(searchContext, searchCaches, linksContentMap))
+    return;
 
-  context->HelperSearchTemplate(
+  searchContext->HelperSearchTemplate(
       searchTemplate,
-      [templateParams, &result, &varNames](ScTemplateSearchResultItem const & item) -> ScTemplateSearchRequest {
+      [&templateParams, &result, &varNames](ScTemplateSearchResultItem const & item) -> ScTemplateSearchRequest {
         // Add search result item to the answer container
         for (std::string const & varName : varNames)
         {
@@ -107,15 +117,17 @@ void TemplateSearcherInStructures::searchTemplateWithContent(
         }
         return ScTemplateSearchRequest::STOP;
       },
-      [&linksContentMap, this](ScTemplateSearchResultItem const & item) -> bool {
+      [&linksContentMap, searchContext, &searchCaches, this](ScTemplateSearchResultItem const & item) -> bool {
         // Filter result item by the same content and belonging to any of the input structures
-        bool contentIdentical = isContentIdentical(item, linksContentMap);
+        bool contentIdentical = isContentIdentical(searchContext, searchCaches, item, linksContentMap);
         bool isElementInStructures = std::any_of(
-            inputStructures.cbegin(), inputStructures.cend(), [&item, this](ScAddr const & structure) -> bool {
+            inputStructures.cbegin(),
+            inputStructures.cend(),
+            [&item, searchContext](ScAddr const & structure) -> bool {
               bool result = true;
               for (size_t i = 0; i < item.Size(); i++)
               {
-                if (!context->HelperCheckEdge(structure, item[i], ScType::EdgeAccessConstPosPerm))
+                if (!searchContext->HelperCheckEdge(structure, item[i], ScType::EdgeAccessConstPosPerm))
                 {
                   result = false;
                   break;
@@ -127,21 +139,27 @@ void TemplateSearcherInStructures::searchTemplateWithContent(
       });
 }
 
-std::map<std::string, std::string> TemplateSearcherInStructures::getTemplateLinksContent(ScAddr const & templateAddr)
+std::map<std::string, TemplateLinkContent> TemplateSearcherInStructures::getTemplateLinksContent(
+    ScMemoryContext * searchContext,
+    ScAddr const & templateAddr)
 {
-  std::map<std::string, std::string> linksContent;
-  ScIterator3Ptr const & linksIterator = context->Iterator3(templateAddr, ScType::EdgeAccessConstPosPerm, ScType::Link);
+  std::map<std::string, TemplateLinkContent> linksContent;
+  ScIterator3Ptr const & linksIterator =
+      searchContext->Iterator3(templateAddr, ScType::EdgeAccessConstPosPerm, ScType::Link);
   while (linksIterator->Next())
   {
     ScAddr const & linkAddr = linksIterator->Get(2);
     std::string stringContent;
     if (std::any_of(
-            inputStructures.cbegin(), inputStructures.cend(), [&linkAddr, this](ScAddr const & structure) -> bool {
-              return context->HelperCheckEdge(structure, linkAddr, ScType::EdgeAccessConstPosPerm);
+            inputStructures.cbegin(),
+            inputStructures.cend(),
+            [&linkAddr, searchContext](ScAddr const & structure) -> bool {
+              return searchContext->HelperCheckEdge(structure, linkAddr, ScType::EdgeAccessConstPosPerm);
             }))
     {
-      context->GetLinkContent(linkAddr, stringContent);
-      linksContent.emplace(to_string(linkAddr.Hash()), stringContent);
+      searchContext->GetLinkContent(linkAddr, stringContent);
+      linksContent.emplace(
+          to_string(linkAddr.Hash()), createTemplateLinkContent(searchContext, templateAddr, linkAddr, stringContent));
     }
   }
 
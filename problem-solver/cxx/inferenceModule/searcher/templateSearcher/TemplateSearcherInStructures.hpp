@@ -24,18 +24,29 @@ public:
 
   explicit TemplateSearcherInStructures(ScMemoryContext * ms_context);
 
-  void searchTemplate(
+  /// @returns true if `element` belongs to any of the input structures
+  bool isSearchable(ScMemoryContext * searchContext, ScAddr const & element) const override;
+
+protected:
+  void searchTemplateInContext(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
       ScAddr const & templateAddr,
       ScTemplateParams const & templateParams,
-      std::set<std::string> const & varNames,
+      VarNames const & varNames,
       Replacements & result) override;
 
   void searchTemplateWithContent(
+      ScMemoryContext * searchContext,
+      ScMemoryContextCaches & searchCaches,
       ScTemplate const & searchTemplate,
       ScAddr const & templateAddr,
       ScTemplateParams const & templateParams,
+      VarNames const & varNames,
       Replacements & result) override;
 
-  std::map<std::string, std::string> getTemplateLinksContent(ScAddr const & templateAddr) override;
+  std::map<std::string, TemplateLinkContent> getTemplateLinksContent(
+      ScMemoryContext * searchContext,
+      ScAddr const & templateAddr) override;
 };
 }  // namespace inference
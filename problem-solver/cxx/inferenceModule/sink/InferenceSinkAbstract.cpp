@@ -0,0 +1,19 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "InferenceSinkAbstract.hpp"
+
+namespace inference
+{
+std::string InferenceSinkAbstract::getElementName(ScMemoryContext * context, ScAddr const & element)
+{
+  if (!element.IsValid())
+    return "#0";
+  std::string const & systemIdentifier = context->HelperGetSystemIdtf(element);
+  return systemIdentifier.empty() ? "#" + std::to_string(element.Hash()) : systemIdentifier;
+}
+
+}  // namespace inference
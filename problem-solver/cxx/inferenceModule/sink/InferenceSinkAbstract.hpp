@@ -0,0 +1,47 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <string>
+
+#include "sc-memory/sc_memory.hpp"
+#include "sc-memory/sc_addr.hpp"
+
+#include "utils/ReplacementsUtils.hpp"
+
+namespace inference
+{
+/// Use of a formula which has generated constructions
+struct InferenceFiring
+{
+  ScAddr formula;
+  /// Replacements of variables of the formula by which constructions are generated
+  Replacements replacements;
+  /// Elements of generated constructions, an element may be repeated if it is in several constructions
+  ScAddrVector generatedElements;
+  /// Elements created by the firing, elements found in memory are only in generated elements
+  ScAddrVector createdElements;
+};
+
+/**
+ * Receiver of results of inference. The inference manager notifies its sinks of every firing when the firing is added
+ * to the solution tree, so results can be processed while inference continues
+ */
+class InferenceSinkAbstract
+{
+public:
+  virtual ~InferenceSinkAbstract() = default;
+
+  /// Called by the thread of the inference manager in order of the solution tree
+  virtual void onFiring(InferenceFiring const & firing) = 0;
+
+protected:
+  /// @returns system identifier of the element, `#` and hash of the element if it has no system identifier
+  static std::string getElementName(ScMemoryContext * context, ScAddr const & element);
+};
+
+}  // namespace inference
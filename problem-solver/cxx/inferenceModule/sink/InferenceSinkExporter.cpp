@@ -0,0 +1,256 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "InferenceSinkExporter.hpp"
+
+#include <cstdio>
+#include <set>
+
+namespace inference
+{
+namespace
+{
+void appendNumber(std::string & record, uint64_t number, size_t bytesAmount)
+{
+  for (size_t byteIndex = 0; byteIndex < bytesAmount; ++byteIndex)
+    record.push_back(static_cast<char>((number >> (8 * byteIndex)) & 0xFF));
+}
+
+void appendString(std::string & record, std::string const & string)
+{
+  appendNumber(record, string.size(), 4);
+  record += string;
+}
+
+void appendJsonString(std::string & record, std::string const & string)
+{
+  record.push_back('"');
+  for (char const symbol : string)
+  {
+    if (symbol == '"' || symbol == '\\')
+    {
+      record.push_back('\\');
+      record.push_back(symbol);
+    }
+    else if (static_cast<unsigned char>(symbol) < 0x20)
+    {
+      char escapedSymbol[7];
+      std::snprintf(escapedSymbol, sizeof(escapedSymbol), "\\u%04x", static_cast<unsigned char>(symbol));
+      record += escapedSymbol;
+    }
+    else
+      record.push_back(symbol);
+  }
+  record.push_back('"');
+}
+}  // namespace
+
+std::string const InferenceSinkExporter::BINARY_MAGIC = "SCIF";
+uint32_t const InferenceSinkExporter::BINARY_VERSION = 1;
+size_t const InferenceSinkExporter::DEFAULT_BUFFER_SIZE = 1 << 16;
+size_t const InferenceSinkExporter::MAX_PENDING_BUFFERS_AMOUNT = 4;
+
+InferenceSinkExporter::InferenceSinkExporter(
+    ScMemoryContext * context,
+    std::string const & filePath,
+    ExportFormat format,
+    size_t bufferSize)
+  : context(context)
+  , filePath(filePath)
+  , format(format)
+  , bufferSize(bufferSize)
+  , file(filePath, std::ios::out | std::ios::trunc | std::ios::binary)
+{
+  if (!file.is_open())
+  {
+    SC_THROW_EXCEPTION(utils::ExceptionInvalidState, "File " << filePath << " can't be opened for inference export.");
+  }
+
+  if (format == EXPORT_BINARY)
+  {
+    pendingBuffer += BINARY_MAGIC;
+    appendNumber(pendingBuffer, BINARY_VERSION, 4);
+    fileSize = pendingBuffer.size();
+  }
+  writer = std::thread(&InferenceSinkExporter::writeBuffers, this);
+}
+
+InferenceSinkExporter::~InferenceSinkExporter()
+{
+  try
+  {
+    close();
+  }
+  catch (utils::ScException const & exception)
+  {
+    SC_LOG_ERROR(exception.Message());
+  }
+}
+
+void InferenceSinkExporter::onFiring(InferenceFiring const & firing)
+{
+  std::string record;
+  if (format == EXPORT_BINARY)
+    serializeBinary(firing, record);
+  else
+    serializeJson(firing, record);
+
+  bool isBufferFilled;
+  {
+    std::unique_lock<std::mutex> lock(bufferMutex);
+    // Memory of the buffer is bounded, so inference waits for the file if firings are faster than writing
+    bufferTaken.wait(
+        lock, [this]() { return closed || pendingBuffer.size() < MAX_PENDING_BUFFERS_AMOUNT * bufferSize; });
+    if (closed)
+      return;
+    recordsOffsets.push_back(fileSize);
+    fileSize += record.size();
+    pendingBuffer += record;
+    isBufferFilled = pendingBuffer.size() >= bufferSize;
+  }
+  if (isBufferFilled)
+    bufferFilled.notify_one();
+}
+
+void InferenceSinkExporter::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    if (closed)
+      return;
+    closed = true;
+  }
+  bufferFilled.notify_one();
+  bufferTaken.notify_all();
+  writer.join();
+
+  if (format == EXPORT_BINARY)
+  {
+    std::string index;
+    for (uint64_t const recordOffset : recordsOffsets)
+      appendNumber(index, recordOffset, 8);
+    appendNumber(index, recordsOffsets.size(), 8);
+    appendNumber(index, fileSize, 8);
+    index += BINARY_MAGIC;
+    file.write(index.data(), index.size());
+    writeFailed = writeFailed || !file;
+  }
+  file.close();
+  if (writeFailed || !file)
+  {
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidState, "File " << filePath << " of inference export isn't written completely.");
+  }
+}
+
+size_t InferenceSinkExporter::getExportedFiringsAmount() const
+{
+  std::lock_guard<std::mutex> lock(bufferMutex);
+  return recordsOffsets.size();
+}
+
+std::vector<std::vector<std::string>> InferenceSinkExporter::getGeneratedTriples(
+    ScAddrVector const & generatedElements) const
+{
+  std::vector<std::vector<std::string>> triples;
+  std::set<ScAddr, ScAddLessFunc> arcs;
+  for (ScAddr const & element : generatedElements)
+  {
+    if (!context->GetElementType(element).IsEdge() || !arcs.insert(element).second)
+      continue;
+
+    ScAddr source;
+    ScAddr target;
+    context->GetEdgeInfo(element, source, target);
+    triples.push_back(
+        {getElementName(context, source), getElementName(context, element), getElementName(context, target)});
+  }
+  return triples;
+}
+
+/// Record of a firing is `{"formula":"...","replacements":{"variable":["..."]},"triples":[["...","...","..."]]}`
+void InferenceSinkExporter::serializeJson(InferenceFiring const & firing, std::string & record) const
+{
+  record += "{\"formula\":";
+  appendJsonString(record, getElementName(context, firing.formula));
+  record += ",\"replacements\":{";
+  bool isFirstVariable = true;
+  for (auto const & variableReplacements : firing.replacements)
+  {
+    record += isFirstVariable ? "" : ",";
+    isFirstVariable = false;
+    appendJsonString(record, variableReplacements.first);
+    record += ":[";
+    for (size_t index = 0; index < variableReplacements.second.size(); ++index)
+    {
+      record += index == 0 ? "" : ",";
+      appendJsonString(record, getElementName(context, variableReplacements.second[index]));
+    }
+    record += "]";
+  }
+  record += "},\"triples\":[";
+  std::vector<std::vector<std::string>> const triples = getGeneratedTriples(firing.generatedElements);
+  for (size_t tripleIndex = 0; tripleIndex < triples.size(); ++tripleIndex)
+  {
+    record += tripleIndex == 0 ? "[" : ",[";
+    for (size_t index = 0; index < triples[tripleIndex].size(); ++index)
+    {
+      record += index == 0 ? "" : ",";
+      appendJsonString(record, triples[tripleIndex][index]);
+    }
+    record += "]";
+  }
+  record += "]}\n";
+}
+
+void InferenceSinkExporter::serializeBinary(InferenceFiring const & firing, std::string & record) const
+{
+  std::string payload;
+  appendString(payload, getElementName(context, firing.formula));
+  appendNumber(payload, firing.replacements.size(), 4);
+  for (auto const & variableReplacements : firing.replacements)
+  {
+    appendString(payload, variableReplacements.first);
+    appendNumber(payload, variableReplacements.second.size(), 4);
+    for (ScAddr const & replacement : variableReplacements.second)
+      appendString(payload, getElementName(context, replacement));
+  }
+  std::vector<std::vector<std::string>> const triples = getGeneratedTriples(firing.generatedElements);
+  appendNumber(payload, triples.size(), 4);
+  for (std::vector<std::string> const & triple : triples)
+  {
+    for (std::string const & name : triple)
+      appendString(payload, name);
+  }
+
+  appendNumber(record, payload.size(), 4);
+  record += payload;
+}
+
+/// Buffers are swapped under the lock and written without it, so the inference thread waits only for the swap
+void InferenceSinkExporter::writeBuffers()
+{
+  std::string writtenBuffer;
+  std::unique_lock<std::mutex> lock(bufferMutex);
+  while (true)
+  {
+    bufferFilled.wait(lock, [this]() { return closed || pendingBuffer.size() >= bufferSize; });
+    writtenBuffer.swap(pendingBuffer);
+    bool const isClosed = closed;
+    lock.unlock();
+    bufferTaken.notify_all();
+
+    // Buffers are still taken after a failure, so inference doesn't wait for the file, the failure is reported by close
+    file.write(writtenBuffer.data(), writtenBuffer.size());
+    writeFailed = writeFailed || !file;
+    writtenBuffer.clear();
+    if (isClosed)
+      return;
+    lock.lock();
+  }
+}
+
+}  // namespace inference
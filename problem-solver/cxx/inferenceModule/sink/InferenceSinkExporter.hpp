@@ -0,0 +1,101 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "InferenceSinkAbstract.hpp"
+
+namespace inference
+{
+enum ExportFormat
+{
+  /// A JSON object in a line for every firing
+  EXPORT_NDJSON = 1,
+  /// Records with length prefix and an index of records offsets at the end of the file
+  EXPORT_BINARY = 2
+};
+
+/**
+ * Sink that exports firings to a file: formula, replacements of variables and generated triples `source, arc, target`
+ * by names of elements (see InferenceSinkAbstract::getElementName). A firing is serialized by the inference thread
+ * into a buffer, the buffer is written to the file by a thread of the exporter, so inference doesn't wait for the file
+ * until the writer falls behind by MAX_PENDING_BUFFERS_AMOUNT buffers.
+ *
+ * Binary file is `SCIF`, version, records and the index. A record is its size and its payload: formula, amount of
+ * variables, every variable with amount of its replacements and replacements, amount of triples and names of triples
+ * elements. The index is offsets of records, amount of records, offset of the index and `SCIF`. Strings are prefixed
+ * by their size, numbers are little-endian of 4 bytes, offsets and amounts of the index are of 8 bytes
+ */
+class InferenceSinkExporter : public InferenceSinkAbstract
+{
+public:
+  static std::string const BINARY_MAGIC;
+  static uint32_t const BINARY_VERSION;
+  /// Size of serialized firings after which they are written to the file
+  static size_t const DEFAULT_BUFFER_SIZE;
+  /// Amount of buffers which are not written yet after which onFiring waits for the writer thread
+  static size_t const MAX_PENDING_BUFFERS_AMOUNT;
+
+  /// @throws utils::ExceptionInvalidState Thrown if the file can't be opened for writing
+  InferenceSinkExporter(
+      ScMemoryContext * context,
+      std::string const & filePath,
+      ExportFormat format,
+      size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+  /// Write the rest of the buffer and the index, see close, a failure of writing is logged
+  ~InferenceSinkExporter() override;
+
+  void onFiring(InferenceFiring const & firing) override;
+
+  /**
+   * Wait for the writer thread to write buffered firings and finish the file, firings after closing are dropped
+   * @throws utils::ExceptionInvalidState Thrown if some data isn't written to the file
+   */
+  void close();
+
+  size_t getExportedFiringsAmount() const;
+
+private:
+  /// Triples of generated arcs, arcs repeated in the firing are exported once
+  std::vector<std::vector<std::string>> getGeneratedTriples(ScAddrVector const & generatedElements) const;
+
+  void serializeJson(InferenceFiring const & firing, std::string & record) const;
+
+  void serializeBinary(InferenceFiring const & firing, std::string & record) const;
+
+  void writeBuffers();
+
+  ScMemoryContext * context;
+  std::string const filePath;
+  ExportFormat const format;
+  size_t const bufferSize;
+  std::ofstream file;
+  /// Set by the writer thread if a write to the file has failed, it is read after the thread is joined
+  bool writeFailed = false;
+
+  /// Firings serialized by the inference thread and not written yet
+  std::string pendingBuffer;
+  bool closed = false;
+  mutable std::mutex bufferMutex;
+  std::condition_variable bufferFilled;
+  std::condition_variable bufferTaken;
+  std::thread writer;
+
+  /// Offsets of records in the file, they are known without the file as records are written in order
+  std::vector<uint64_t> recordsOffsets;
+  uint64_t fileSize = 0;
+};
+
+}  // namespace inference
@@ -0,0 +1,39 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "InferenceSinkFile.hpp"
+
+namespace inference
+{
+InferenceSinkFile::InferenceSinkFile(ScMemoryContext * context, std::string const & filePath)
+  : context(context)
+  , file(filePath, std::ios::out | std::ios::trunc)
+{
+  if (!file.is_open())
+  {
+    SC_THROW_EXCEPTION(utils::ExceptionInvalidState, "File " << filePath << " can't be opened for inference results.");
+  }
+}
+
+/// Line of a firing is `formula\tvariable=element,element;variable=element\telement element`
+void InferenceSinkFile::onFiring(InferenceFiring const & firing)
+{
+  file << getElementName(context, firing.formula) << '\t';
+  bool isFirstVariable = true;
+  for (auto const & variableReplacements : firing.replacements)
+  {
+    file << (isFirstVariable ? "" : ";") << variableReplacements.first << '=';
+    isFirstVariable = false;
+    for (size_t index = 0; index < variableReplacements.second.size(); ++index)
+      file << (index == 0 ? "" : ",") << getElementName(context, variableReplacements.second[index]);
+  }
+  file << '\t';
+  for (size_t index = 0; index < firing.generatedElements.size(); ++index)
+    file << (index == 0 ? "" : " ") << getElementName(context, firing.generatedElements[index]);
+  file << std::endl;
+}
+
+}  // namespace inference
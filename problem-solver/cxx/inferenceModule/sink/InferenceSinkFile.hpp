@@ -0,0 +1,35 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <fstream>
+#include <string>
+
+#include "sc-memory/sc_memory.hpp"
+
+#include "InferenceSinkAbstract.hpp"
+
+namespace inference
+{
+/**
+ * Sink that writes a line of text for every firing: system identifier of the formula, replacements of variables and
+ * generated elements separated by tabs. Every line is flushed, so the file can be read while inference continues
+ */
+class InferenceSinkFile : public InferenceSinkAbstract
+{
+public:
+  /// @throws utils::ExceptionInvalidState Thrown if the file can't be opened for writing
+  InferenceSinkFile(ScMemoryContext * context, std::string const & filePath);
+
+  void onFiring(InferenceFiring const & firing) override;
+
+private:
+  ScMemoryContext * context;
+  std::ofstream file;
+};
+
+}  // namespace inference
@@ -0,0 +1,77 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "InferenceSinkQueue.hpp"
+
+#include "sc-memory/sc_memory.hpp"
+
+namespace inference
+{
+InferenceSinkQueue::InferenceSinkQueue(size_t capacity)
+  : capacity(capacity)
+{
+  if (capacity == 0)
+  {
+    SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Capacity of inference sink queue must be positive.");
+  }
+}
+
+void InferenceSinkQueue::onFiring(InferenceFiring const & firing)
+{
+  {
+    std::unique_lock<std::mutex> lock(firingsMutex);
+    notFull.wait(lock, [this]() { return closed || firings.size() < capacity; });
+    if (closed)
+      return;
+    firings.push_back(firing);
+  }
+  notEmpty.notify_one();
+}
+
+bool InferenceSinkQueue::pop(InferenceFiring & firing)
+{
+  {
+    std::unique_lock<std::mutex> lock(firingsMutex);
+    notEmpty.wait(lock, [this]() { return closed || !firings.empty(); });
+    if (firings.empty())
+      return false;
+    firing = std::move(firings.front());
+    firings.pop_front();
+  }
+  notFull.notify_one();
+  return true;
+}
+
+bool InferenceSinkQueue::tryPop(InferenceFiring & firing)
+{
+  {
+    std::lock_guard<std::mutex> lock(firingsMutex);
+    if (firings.empty())
+      return false;
+    firing = std::move(firings.front());
+    firings.pop_front();
+  }
+  notFull.notify_one();
+  return true;
+}
+
+void InferenceSinkQueue::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(firingsMutex);
+    closed = true;
+  }
+  notFull.notify_all();
+  notEmpty.notify_all();
+}
+
+size_t InferenceSinkQueue::size() const
+{
+  std::lock_guard<std::mutex> lock(firingsMutex);
+  return firings.size();
+}
+
+}  // namespace inference
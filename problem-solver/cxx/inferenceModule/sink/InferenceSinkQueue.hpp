@@ -0,0 +1,51 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "InferenceSinkAbstract.hpp"
+
+namespace inference
+{
+/**
+ * Bounded queue of firings for a consumer in another thread. Inference waits while the queue is full, so a slow
+ * consumer doesn't make the queue grow. The queue is closed by its owner after inference, then the consumer gets
+ * firings left in the queue and stops
+ */
+class InferenceSinkQueue : public InferenceSinkAbstract
+{
+public:
+  /// @throws utils::ExceptionInvalidParams Thrown if `capacity` is zero
+  explicit InferenceSinkQueue(size_t capacity);
+
+  /// Wait until the queue has space for the firing, the firing is dropped if the queue is closed
+  void onFiring(InferenceFiring const & firing) override;
+
+  /// Wait for the next firing, @returns false if the queue is closed and empty
+  bool pop(InferenceFiring & firing);
+
+  /// @returns false if the queue is empty
+  bool tryPop(InferenceFiring & firing);
+
+  /// Stop waiting of the producer and the consumer, firings are not added to the closed queue
+  void close();
+
+  size_t size() const;
+
+private:
+  size_t const capacity;
+  std::deque<InferenceFiring> firings;
+  bool closed = false;
+  mutable std::mutex firingsMutex;
+  std::condition_variable notFull;
+  std::condition_variable notEmpty;
+};
+
+}  // namespace inference
@@ -0,0 +1,28 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "InferenceSinkStructure.hpp"
+
+namespace inference
+{
+InferenceSinkStructure::InferenceSinkStructure(ScMemoryContext * context, ScAddr const & structure)
+  : context(context)
+  , structure(structure)
+{
+}
+
+void InferenceSinkStructure::onFiring(InferenceFiring const & firing)
+{
+  for (ScAddr const & element : firing.generatedElements)
+  {
+    // Elements added to the structure before the sink are checked once
+    if (structureElements.insert(element).second &&
+        !context->HelperCheckEdge(structure, element, ScType::EdgeAccessConstPosPerm))
+      context->CreateEdge(ScType::EdgeAccessConstPosPerm, structure, element);
+  }
+}
+
+}  // namespace inference
@@ -0,0 +1,31 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <unordered_set>
+
+#include "sc-memory/sc_memory.hpp"
+
+#include "InferenceSinkAbstract.hpp"
+
+namespace inference
+{
+/// Sink that adds generated elements to a structure, as inference adds them to its output structure
+class InferenceSinkStructure : public InferenceSinkAbstract
+{
+public:
+  InferenceSinkStructure(ScMemoryContext * context, ScAddr const & structure);
+
+  void onFiring(InferenceFiring const & firing) override;
+
+private:
+  ScMemoryContext * context;
+  ScAddr structure;
+  std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> structureElements;
+};
+
+}  // namespace inference
@@ -0,0 +1,27 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "sc_test.hpp"
+
+/// Memory test which can replace its memory by new empty memory in the middle of a test
+class ScMemoryReloadTest : public ScMemoryTest
+{
+protected:
+  /// Shut down the memory of the test and initialize new empty memory with a new context
+  void reloadMemory()
+  {
+    m_ctx->Destroy();
+    m_ctx.reset();
+    ScMemoryTest::Shutdown();
+
+    ScMemoryTest::Initialize();
+    m_ctx = std::make_unique<ScMemoryContext>(sc_access_lvl_make_min, "test");
+  }
+};
@@ -0,0 +1,396 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <sstream>
+
+#include "sc_test.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+#include "utils/ReplacementsUtils.hpp"
+
+using namespace inference;
+
+namespace inferencePerformanceTest
+{
+ScsLoader loader;
+std::string const BASELINE_PATH = INFERENCE_PERF_BASELINE_PATH;
+std::string const WORKLOAD_FILE_PATH = "inferencePerformanceWorkload.scs";
+/// Baseline is written by measured runs instead of comparing if the variable is set, it is run on a reference build
+char const * const RECORD_BASELINE_VARIABLE = "INFERENCE_PERF_RECORD_BASELINE";
+/// Factor of baseline time which a run may take, time is not checked if it is 0
+char const * const TIME_TOLERANCE_VARIABLE = "INFERENCE_PERF_TIME_TOLERANCE";
+double const DEFAULT_TIME_TOLERANCE = 2;
+
+/// Measures of a workload run, all of them except time are the same on every machine
+using WorkloadMeasures = std::map<std::string, double>;
+
+std::string const TEMPLATE_SEARCHES = "templateSearches";
+std::string const CREATED_ELEMENTS = "createdElements";
+std::string const JOINED_COLUMNS = "joinedColumns";
+std::string const FIRINGS = "firings";
+std::string const SECONDS = "seconds";
+
+class InferenceSinkCounter : public InferenceSinkAbstract
+{
+public:
+  void onFiring(InferenceFiring const &) override
+  {
+    ++firingsAmount;
+  }
+
+  size_t firingsAmount = 0;
+};
+
+/// Baseline has a line for every workload: `"name": {"measure": value, ...}`
+std::map<std::string, WorkloadMeasures> readBaseline()
+{
+  std::map<std::string, WorkloadMeasures> baseline;
+  std::ifstream file(BASELINE_PATH);
+  for (std::string line; std::getline(file, line);)
+  {
+    size_t const nameEnd = line.find("\": {\"");
+    if (nameEnd == std::string::npos)
+      continue;
+    WorkloadMeasures & measures = baseline[line.substr(line.find('"') + 1, nameEnd - line.find('"') - 1)];
+    for (size_t keyBegin = line.find('"', nameEnd + 4); keyBegin != std::string::npos;
+         keyBegin = line.find('"', line.find_first_of(",}", keyBegin)))
+    {
+      size_t const keyEnd = line.find('"', keyBegin + 1);
+      measures[line.substr(keyBegin + 1, keyEnd - keyBegin - 1)] = std::stod(line.substr(keyEnd + 2));
+    }
+  }
+  return baseline;
+}
+
+void writeBaseline(std::map<std::string, WorkloadMeasures> const & baseline)
+{
+  std::ofstream file(BASELINE_PATH);
+  file << "{\n\"version\": 1,\n\"workloads\": {\n";
+  for (auto workload = baseline.cbegin(); workload != baseline.cend(); ++workload)
+  {
+    file << "\"" << workload->first << "\": {";
+    for (auto measure = workload->second.cbegin(); measure != workload->second.cend(); ++measure)
+    {
+      file << (measure == workload->second.cbegin() ? "" : ", ") << "\"" << measure->first << "\": ";
+      if (measure->first == SECONDS)
+        file << std::fixed << std::setprecision(6) << measure->second;
+      else
+        file << static_cast<size_t>(measure->second);
+    }
+    file << "}" << (std::next(workload) == baseline.cend() ? "" : ",") << "\n";
+  }
+  file << "}\n}\n";
+}
+
+/// Fail and use the default tolerance if the variable is not a non-negative number
+double getTimeTolerance()
+{
+  char const * const toleranceValue = std::getenv(TIME_TOLERANCE_VARIABLE);
+  if (toleranceValue == nullptr)
+    return DEFAULT_TIME_TOLERANCE;
+
+  char * toleranceEnd = nullptr;
+  double const tolerance = std::strtod(toleranceValue, &toleranceEnd);
+  if (toleranceEnd == toleranceValue || *toleranceEnd != '\0' || !std::isfinite(tolerance) || tolerance < 0)
+  {
+    ADD_FAILURE() << TIME_TOLERANCE_VARIABLE << " is not a non-negative number: " << toleranceValue;
+    return DEFAULT_TIME_TOLERANCE;
+  }
+  return tolerance;
+}
+
+/// Implication `premise => conclusion` of the rule, premise and conclusion are atomic formulas
+void writeImplication(
+    std::ostream & scs,
+    std::string const & rule,
+    std::string const & premise,
+    std::string const & conclusion)
+{
+  scs << rule << "_if = [*\n\t" << premise << "\n*];;\n";
+  scs << rule << "_then = [*\n\t" << conclusion << "\n*];;\n";
+  scs << "atomic_logical_formula\n\t-> " << rule << "_if;\n\t-> " << rule << "_then;;\n";
+  scs << "concept_template_for_generation\n\t-> " << rule << "_then;;\n";
+  scs << "@" << rule << "_implication = (" << rule << "_if => " << rule << "_then);;\n";
+  scs << "@" << rule << "_implication <- nrel_implication;;\n";
+  scs << "@" << rule << "_key = (" << rule << " -> @" << rule << "_implication);;\n";
+  scs << "@" << rule << "_key <- rrel_main_key_sc_element;;\n\n";
+}
+
+/// Implication `(firstPremise && secondPremise) => conclusion` of the rule, premises and conclusion are atomic formulas
+void writeConjunctionImplication(
+    std::ostream & scs,
+    std::string const & rule,
+    std::string const & firstPremise,
+    std::string const & secondPremise,
+    std::string const & conclusion)
+{
+  scs << "sc_node_tuple\n\t-> " << rule << "_conjunction;\n\t-> " << rule << "_implication;;\n";
+  scs << rule << "_first = [*\n\t" << firstPremise << "\n*];;\n";
+  scs << rule << "_second = [*\n\t" << secondPremise << "\n*];;\n";
+  scs << rule << "_then = [*\n\t" << conclusion << "\n*];;\n";
+  scs << "atomic_logical_formula\n\t-> " << rule << "_first;\n\t-> " << rule << "_second;\n\t-> " << rule
+      << "_then;;\n";
+  scs << "concept_template_for_generation\n\t-> " << rule << "_then;;\n";
+  scs << rule << "_conjunction\n\t-> " << rule << "_first;\n\t-> " << rule << "_second;;\n";
+  scs << rule << "_conjunction <- nrel_conjunction;;\n";
+  scs << rule << "_implication <- nrel_implication;;\n";
+  scs << "@" << rule << "_if = (" << rule << "_implication -> " << rule << "_conjunction);;\n";
+  scs << "@" << rule << "_if <- rrel_if;;\n";
+  scs << "@" << rule << "_then = (" << rule << "_implication -> " << rule << "_then);;\n";
+  scs << "@" << rule << "_then <- rrel_then;;\n";
+  scs << "@" << rule << "_key = (" << rule << " -> " << rule << "_implication);;\n";
+  scs << "@" << rule << "_key <- rrel_main_key_sc_element;;\n\n";
+}
+
+void writeHeader(std::ostream & scs)
+{
+  scs << "sc_node_class\n\t-> atomic_logical_formula;;\n\n";
+  scs << "sc_node_role_relation\n\t-> rrel_1;\n\t-> rrel_if;\n\t-> rrel_then;\n\t-> rrel_main_key_sc_element;;\n\n";
+  scs << "sc_node_norole_relation\n\t-> nrel_implication;\n\t-> nrel_conjunction;;\n\n";
+}
+
+/**
+ * Chain of classes `perf_class_0` ... `perf_class_<classesAmount>` with elements of the first class, a rule of the
+ * chain moves elements to the next class and a distractor rule moves them to a class out of the chain
+ */
+std::string generateChainWorkload(size_t classesAmount, size_t elementsAmount)
+{
+  std::stringstream scs;
+  writeHeader(scs);
+  std::vector<std::string> rules;
+  for (size_t classIndex = 0; classIndex < classesAmount; ++classIndex)
+  {
+    std::string const currentClass = "perf_class_" + std::to_string(classIndex);
+    std::string const nextClass = "perf_class_" + std::to_string(classIndex + 1);
+    std::string const distractorClass = "perf_distractor_class_" + std::to_string(classIndex);
+    scs << "sc_node_class\n\t-> " << nextClass << ";\n\t-> " << distractorClass << ";;\n";
+    rules.push_back("perf_rule_" + std::to_string(classIndex));
+    writeImplication(scs, rules.back(), currentClass + " _-> _element;;", nextClass + " _-> _element;;");
+    rules.push_back("perf_distractor_rule_" + std::to_string(classIndex));
+    writeImplication(scs, rules.back(), currentClass + " _-> _element;;", distractorClass + " _-> _element;;");
+  }
+
+  scs << "sc_node_class\n\t-> perf_class_0;;\n\n";
+  scs << "target_template = [*\n\tperf_class_" << classesAmount << " _-> _element;;\n*];;\n\n";
+  scs << "input_structure = [*\n";
+  for (size_t elementIndex = 0; elementIndex < elementsAmount; ++elementIndex)
+    scs << "\tperf_element_" << elementIndex << " <- perf_class_0;;\n";
+  scs << "*];;\n\n";
+
+  scs << "rules_set\n\t-> rrel_1: {";
+  for (size_t ruleIndex = 0; ruleIndex < rules.size(); ++ruleIndex)
+    scs << (ruleIndex == 0 ? " " : "; ") << rules[ruleIndex];
+  scs << " };;\n";
+  return scs.str();
+}
+
+/**
+ * Elements of `perf_class_source` with `linksAmount` pairs of nrel_perf_link to other elements, the rule joins
+ * membership of elements and their pairs by `_source` to add linked elements to `perf_class_linked`
+ */
+std::string generateJoinWorkload(size_t elementsAmount, size_t linksAmount)
+{
+  std::stringstream scs;
+  writeHeader(scs);
+  scs << "sc_node_class\n\t-> perf_class_source;\n\t-> perf_class_linked;;\n\n";
+  scs << "sc_node_norole_relation\n\t-> nrel_perf_link;;\n\n";
+  writeConjunctionImplication(
+      scs,
+      "perf_join_rule",
+      "perf_class_source _-> _source;;",
+      "_source _=> nrel_perf_link:: _target;;",
+      "perf_class_linked _-> _target;;");
+
+  scs << "input_structure = [*\n";
+  for (size_t elementIndex = 0; elementIndex < elementsAmount; ++elementIndex)
+  {
+    scs << "\tperf_element_" << elementIndex << " <- perf_class_source;;\n";
+    for (size_t linkIndex = 1; linkIndex <= linksAmount; ++linkIndex)
+    {
+      scs << "\tperf_element_" << elementIndex << " => nrel_perf_link: perf_element_"
+          << (elementIndex + linkIndex) % elementsAmount << ";;\n";
+    }
+  }
+  scs << "*];;\n\n";
+
+  scs << "rules_set\n\t-> rrel_1: { perf_join_rule };;\n";
+  return scs.str();
+}
+
+/**
+ * Elements `perf_element_0` ... `perf_element_<elementsAmount>` in a row of nrel_perf_step_0 pairs, a rule of the
+ * chain joins pairs of `nrel_perf_step_<i>` and `nrel_perf_step_0` by the middle element to add pairs of the next
+ * relation, so template searcher and join of replacements are measured
+ */
+std::string generateRelationChainWorkload(size_t stepsAmount, size_t elementsAmount)
+{
+  std::stringstream scs;
+  writeHeader(scs);
+  scs << "sc_node_norole_relation\n\t-> nrel_perf_step_0;;\n\n";
+  std::vector<std::string> rules;
+  for (size_t stepIndex = 0; stepIndex < stepsAmount; ++stepIndex)
+  {
+    std::string const currentRelation = "nrel_perf_step_" + std::to_string(stepIndex);
+    std::string const nextRelation = "nrel_perf_step_" + std::to_string(stepIndex + 1);
+    scs << "sc_node_norole_relation\n\t-> " << nextRelation << ";;\n";
+    rules.push_back("perf_step_rule_" + std::to_string(stepIndex));
+    writeConjunctionImplication(
+        scs,
+        rules.back(),
+        "_begin _=> " + currentRelation + ":: _middle;;",
+        "_middle _=> nrel_perf_step_0:: _end;;",
+        "_begin _=> " + nextRelation + ":: _end;;");
+  }
+
+  scs << "target_template = [*\n\t_begin _=> nrel_perf_step_" << stepsAmount << ":: _end;;\n*];;\n\n";
+  scs << "input_structure = [*\n";
+  for (size_t elementIndex = 0; elementIndex < elementsAmount; ++elementIndex)
+    scs << "\tperf_element_" << elementIndex << " => nrel_perf_step_0: perf_element_" << elementIndex + 1 << ";;\n";
+  scs << "*];;\n\n";
+
+  scs << "rules_set\n\t-> rrel_1: {";
+  for (size_t ruleIndex = 0; ruleIndex < rules.size(); ++ruleIndex)
+    scs << (ruleIndex == 0 ? " " : "; ") << rules[ruleIndex];
+  scs << " };;\n";
+  return scs.str();
+}
+
+class InferencePerformanceTest : public ScMemoryTest
+{
+protected:
+  void loadWorkload(std::string const & workload)
+  {
+    std::ofstream file(WORKLOAD_FILE_PATH);
+    file << workload;
+    file.close();
+    loader.loadScsFile(*m_ctx, WORKLOAD_FILE_PATH);
+    std::remove(WORKLOAD_FILE_PATH.c_str());
+    InferenceKeynodes::InitGlobal();
+    scAgentsCommon::CoreKeynodes::InitGlobal();
+  }
+
+  WorkloadMeasures runWorkload(InferenceStrategy strategy, bool isTargetUsed)
+  {
+    ScMemoryContext & context = *m_ctx;
+    InferenceParams inferenceParams;
+    inferenceParams.formulasSet = context.HelperFindBySystemIdtf("rules_set");
+    inferenceParams.inputStructures = {context.HelperFindBySystemIdtf("input_structure")};
+    inferenceParams.outputStructure = context.CreateNode(ScType::NodeConstStruct);
+    if (isTargetUsed)
+      inferenceParams.targetStructure = context.HelperFindBySystemIdtf("target_template");
+    InferenceConfig inferenceConfig;
+    inferenceConfig.generationType = GENERATE_UNIQUE_FORMULAS;
+    inferenceConfig.replacementsUsingType = REPLACEMENTS_ALL;
+    inferenceConfig.solutionTreeType = TREE_ONLY_OUTPUT_STRUCTURE;
+    inferenceConfig.searchType = SEARCH_IN_STRUCTURES;
+    std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+        InferenceManagerFactory::constructInferenceManager(&context, strategy, inferenceConfig);
+    std::shared_ptr<InferenceSinkCounter> const counter = std::make_shared<InferenceSinkCounter>();
+    inferenceManager->addSink(counter);
+
+    size_t const elementsAmount = context.CalculateStat().GetAllNum();
+    size_t const joinedColumnsAmount = ReplacementsUtils::getJoinedColumnsAmount();
+    auto const startTime = std::chrono::steady_clock::now();
+    EXPECT_TRUE(inferenceManager->applyInference(inferenceParams));
+    double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    return {
+        {TEMPLATE_SEARCHES, static_cast<double>(inferenceManager->getProfile().templateSearchesAmount)},
+        {CREATED_ELEMENTS, static_cast<double>(context.CalculateStat().GetAllNum() - elementsAmount)},
+        {JOINED_COLUMNS, static_cast<double>(ReplacementsUtils::getJoinedColumnsAmount() - joinedColumnsAmount)},
+        {FIRINGS, static_cast<double>(counter->firingsAmount)},
+        {SECONDS, seconds}};
+  }
+
+  /**
+   * Fail if the workload or a measure of the run has no baseline, counts of the run differ from counts of the baseline
+   * or the run is slower than the tolerance allows. Counts don't depend on the machine, so any change of them is
+   * reported and the baseline is recorded again if the change is expected
+   */
+  void checkBaseline(std::string const & workload, WorkloadMeasures const & measures)
+  {
+    std::map<std::string, WorkloadMeasures> baseline = readBaseline();
+    if (std::getenv(RECORD_BASELINE_VARIABLE) != nullptr)
+    {
+      baseline[workload] = measures;
+      writeBaseline(baseline);
+      return;
+    }
+
+    auto const & workloadBaseline = baseline.find(workload);
+    if (workloadBaseline == baseline.cend())
+      FAIL() << "Workload " << workload << " has no baseline, set " << RECORD_BASELINE_VARIABLE << " to record it";
+    double const tolerance = getTimeTolerance();
+    for (auto const & measure : measures)
+    {
+      if (measure.first == SECONDS && tolerance == 0)
+        continue;
+      auto const & baselineMeasure = workloadBaseline->second.find(measure.first);
+      if (baselineMeasure == workloadBaseline->second.cend())
+      {
+        ADD_FAILURE() << "Workload " << workload << " has no baseline of " << measure.first << ", set "
+                      << RECORD_BASELINE_VARIABLE << " to record it";
+        continue;
+      }
+      if (measure.first == SECONDS)
+      {
+        EXPECT_LE(measure.second, baselineMeasure->second * tolerance) << workload << " is slower than baseline";
+        continue;
+      }
+      EXPECT_EQ(measure.second, baselineMeasure->second)
+          << workload << " has other " << measure.first << " than baseline, set " << RECORD_BASELINE_VARIABLE
+          << " to record it if the change is expected";
+    }
+  }
+};
+
+TEST_F(InferencePerformanceTest, ChainWithTarget)
+{
+  loadWorkload(generateChainWorkload(20, 50));
+  checkBaseline("chain_target", runWorkload(STRATEGY_TARGET, true));
+}
+
+TEST_F(InferencePerformanceTest, ChainWithBestFirstTarget)
+{
+  loadWorkload(generateChainWorkload(20, 50));
+  checkBaseline("chain_best_first", runWorkload(STRATEGY_BEST_FIRST, true));
+}
+
+TEST_F(InferencePerformanceTest, ChainWithAllFormulas)
+{
+  loadWorkload(generateChainWorkload(20, 50));
+  checkBaseline("chain_all", runWorkload(STRATEGY_ALL, false));
+}
+
+TEST_F(InferencePerformanceTest, JoinOfLinkedElements)
+{
+  loadWorkload(generateJoinWorkload(200, 5));
+  WorkloadMeasures const measures = runWorkload(STRATEGY_ALL, false);
+  EXPECT_GT(measures.at(JOINED_COLUMNS), 0);
+  checkBaseline("join_links", measures);
+}
+
+TEST_F(InferencePerformanceTest, RelationChainWithTarget)
+{
+  loadWorkload(generateRelationChainWorkload(10, 50));
+  WorkloadMeasures const measures = runWorkload(STRATEGY_TARGET, true);
+  EXPECT_GT(measures.at(TEMPLATE_SEARCHES), 0);
+  EXPECT_GT(measures.at(JOINED_COLUMNS), 0);
+  checkBaseline("relation_chain_target", measures);
+}
+
+}  // namespace inferencePerformanceTest
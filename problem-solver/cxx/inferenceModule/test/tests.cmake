@@ -7,3 +7,12 @@ make_tests_from_folder(${CMAKE_CURRENT_LIST_DIR}/units
 		DEPENDS sc-agents-common sc-builder-lib inferenceModule
 		INCLUDES ${SC_MEMORY_SRC}/tests/sc-memory/_test ${SC_MACHINE_ROOT}/sc-tools/sc-builder/src)
 add_definitions(-DTEMPLATE_SEARCH_MODULE_TEST_SRC_PATH="${CMAKE_CURRENT_LIST_DIR}")
+
+if (${SC_BUILD_INFERENCE_PERF_TESTS})
+	make_tests_from_folder(${CMAKE_CURRENT_LIST_DIR}/perf
+			NAME inference-module-perf-tests-starter
+			DEPENDS sc-agents-common sc-builder-lib inferenceModule
+			INCLUDES ${SC_MEMORY_SRC}/tests/sc-memory/_test ${SC_MACHINE_ROOT}/sc-tools/sc-builder/src)
+	set_tests_properties(inference-module-perf-tests-starter PROPERTIES LABELS perf)
+	add_definitions(-DINFERENCE_PERF_BASELINE_PATH="${CMAKE_CURRENT_LIST_DIR}/perf/baseline.json")
+endif ()
@@ -0,0 +1,132 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "ScMemoryReloadTest.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+#include "sc-agents-common/utils/IteratorUtils.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+
+using namespace inference;
+
+namespace bestFirstInferenceTest
+{
+ScsLoader loader;
+std::string const TEST_FILES_DIR_PATH = TEMPLATE_SEARCH_MODULE_TEST_SRC_PATH "/testStructures/ManagerModule/";
+
+using BestFirstInferenceTest = ScMemoryReloadTest;
+
+void initialize()
+{
+  InferenceKeynodes::InitGlobal();
+  scAgentsCommon::CoreKeynodes::InitGlobal();
+}
+
+InferenceParams createInferenceParams(ScMemoryContext & context)
+{
+  ScAddr const & argumentSet = context.HelperResolveSystemIdtf("argument_set");
+  return {
+      context.HelperResolveSystemIdtf("rules_set"),
+      utils::IteratorUtils::getAllWithType(&context, argumentSet, ScType::Node),
+      {context.HelperResolveSystemIdtf("input_structure")},
+      context.CreateNode(ScType::NodeConstStruct),
+      context.HelperResolveSystemIdtf("target_template")};
+}
+
+InferenceConfig const INFERENCE_CONFIG{
+    GENERATE_UNIQUE_FORMULAS, REPLACEMENTS_ALL, TREE_ONLY_OUTPUT_STRUCTURE, SEARCH_IN_STRUCTURES};
+
+size_t countFormulasUses(ScMemoryContext & context, bool isBestFirst)
+{
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      isBestFirst ? InferenceManagerFactory::constructDirectInferenceManagerBestFirst(&context, INFERENCE_CONFIG)
+                  : InferenceManagerFactory::constructDirectInferenceManagerTarget(&context, INFERENCE_CONFIG);
+  EXPECT_TRUE(inferenceManager->applyInference(createInferenceParams(context)));
+  return inferenceManager->getProfile().formulasUsesAmount;
+}
+
+TEST_F(BestFirstInferenceTest, OnlyFormulasLeadingToTargetAreUsed)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bestFirstInferenceTest.scs");
+  initialize();
+
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerBestFirst(&context, INFERENCE_CONFIG);
+  EXPECT_TRUE(inferenceManager->applyInference(createInferenceParams(context)));
+
+  ScAddr const & argument = context.HelperFindBySystemIdtf("argument");
+  EXPECT_TRUE(context.HelperCheckEdge(
+      context.HelperFindBySystemIdtf("class_d"), argument, ScType::EdgeAccessConstPosPerm));
+  for (char const * skippedClass : {"class_e", "class_f", "class_g"})
+    EXPECT_FALSE(context.HelperCheckEdge(
+        context.HelperFindBySystemIdtf(skippedClass), argument, ScType::EdgeAccessConstPosPerm));
+
+  // rule_2 and rule_3 are blocked until rule_1 and rule_2 generate, so they are not used before
+  InferenceProfile const profile = inferenceManager->getProfile();
+  EXPECT_EQ(profile.formulasUsesAmount, 3u);
+  EXPECT_EQ(profile.skippedFormulasAmount, 3u);
+
+  // Skipped formulas are counted by every inference anew, formulas which can't lead to the target are skipped again
+  inferenceManager->applyInference(createInferenceParams(context));
+  EXPECT_EQ(inferenceManager->getProfile().skippedFormulasAmount, 3u);
+}
+
+TEST_F(BestFirstInferenceTest, FormulasAreNotUsedMoreThanByTargetOrder)
+{
+  loader.loadScsFile(*m_ctx, TEST_FILES_DIR_PATH + "bestFirstInferenceTest.scs");
+  initialize();
+  size_t const targetFormulasUsesAmount = countFormulasUses(*m_ctx, false);
+
+  // Best-first inference is applied to the same knowledge base
+  reloadMemory();
+  loader.loadScsFile(*m_ctx, TEST_FILES_DIR_PATH + "bestFirstInferenceTest.scs");
+  initialize();
+  size_t const bestFirstFormulasUsesAmount = countFormulasUses(*m_ctx, true);
+
+  EXPECT_LE(bestFirstFormulasUsesAmount, targetFormulasUsesAmount);
+}
+
+TEST_F(BestFirstInferenceTest, FrontierIsBounded)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bestFirstInferenceTest.scs");
+  initialize();
+
+  InferenceConfig inferenceConfig = INFERENCE_CONFIG;
+  inferenceConfig.frontierSize = 1;
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerBestFirst(&context, inferenceConfig);
+  // The frontier keeps the most promising formula, so the path to the target is not lost
+  EXPECT_TRUE(inferenceManager->applyInference(createInferenceParams(context)));
+  EXPECT_EQ(inferenceManager->getProfile().formulasUsesAmount, 3u);
+}
+
+TEST_F(BestFirstInferenceTest, BacklogRefillsEmptyFrontier)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bestFirstBacklogTest.scs");
+  initialize();
+
+  InferenceConfig inferenceConfig = INFERENCE_CONFIG;
+  inferenceConfig.frontierSize = 1;
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerBestFirst(&context, inferenceConfig);
+  // rule_3 doesn't fit into the frontier with rule_1, it is used from the backlog after rule_1 and rule_2 lead nowhere
+  EXPECT_TRUE(inferenceManager->applyInference(createInferenceParams(context)));
+  EXPECT_TRUE(context.HelperCheckEdge(
+      context.HelperFindBySystemIdtf("class_d"),
+      context.HelperFindBySystemIdtf("argument"),
+      ScType::EdgeAccessConstPosPerm));
+  EXPECT_EQ(inferenceManager->getProfile().skippedFormulasAmount, 0u);
+}
+
+}  // namespace bestFirstInferenceTest
@@ -0,0 +1,107 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_test.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+#include "sc-agents-common/utils/IteratorUtils.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+
+using namespace inference;
+
+namespace bidirectionalInferenceTest
+{
+ScsLoader loader;
+std::string const TEST_FILES_DIR_PATH = TEMPLATE_SEARCH_MODULE_TEST_SRC_PATH "/testStructures/ManagerModule/";
+
+using BidirectionalInferenceTest = ScMemoryTest;
+
+void initialize()
+{
+  InferenceKeynodes::InitGlobal();
+  scAgentsCommon::CoreKeynodes::InitGlobal();
+}
+
+InferenceParams createInferenceParams(ScMemoryContext & context, std::string const & formulasSetIdentifier)
+{
+  InferenceParams inferenceParams;
+  inferenceParams.formulasSet = context.HelperResolveSystemIdtf(formulasSetIdentifier);
+  inferenceParams.arguments = utils::IteratorUtils::getAllWithType(
+      &context, context.HelperResolveSystemIdtf("argument_set"), ScType::Node);
+  inferenceParams.inputStructures = {context.HelperResolveSystemIdtf("input_structure")};
+  inferenceParams.outputStructure = context.CreateNode(ScType::NodeConstStruct);
+  inferenceParams.targetStructure = context.HelperResolveSystemIdtf("target_template");
+  return inferenceParams;
+}
+
+InferenceConfig createInferenceConfig()
+{
+  InferenceConfig inferenceConfig;
+  inferenceConfig.generationType = GENERATE_UNIQUE_FORMULAS;
+  inferenceConfig.replacementsUsingType = REPLACEMENTS_ALL;
+  inferenceConfig.solutionTreeType = TREE_ONLY_OUTPUT_STRUCTURE;
+  inferenceConfig.searchType = SEARCH_IN_STRUCTURES;
+  return inferenceConfig;
+}
+
+TEST_F(BidirectionalInferenceTest, ForwardFiringMeetsTargetAndOthersAreErased)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bidirectionalInferenceTest.scs");
+  initialize();
+
+  InferenceParams const inferenceParams = createInferenceParams(context, "rules_set");
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerBidirectional(&context, createInferenceConfig());
+  EXPECT_TRUE(inferenceManager->applyInference(inferenceParams));
+
+  ScAddr const & argument = context.HelperFindBySystemIdtf("argument");
+  EXPECT_TRUE(context.HelperCheckEdge(
+      context.HelperFindBySystemIdtf("class_10"), argument, ScType::EdgeAccessConstPosPerm));
+  // rule_11 is used by the forward search, but its construction doesn't connect facts with the target
+  EXPECT_FALSE(context.HelperCheckEdge(
+      context.HelperFindBySystemIdtf("class_forward_only"), argument, ScType::EdgeAccessConstPosPerm));
+
+  // The forward search uses rule_1, ..., rule_11 once, rule_12 is not reached from facts
+  InferenceProfile const profile = inferenceManager->getProfile();
+  EXPECT_EQ(profile.formulasUsesAmount, 11u);
+  EXPECT_EQ(profile.skippedFormulasAmount, 2u);
+}
+
+TEST_F(BidirectionalInferenceTest, BackwardSearchMeetsFactsAndChainIsMaterialized)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bidirectionalInferenceTest.scs");
+  initialize();
+
+  InferenceParams const inferenceParams = createInferenceParams(context, "fan_out_rules_set");
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerBidirectional(&context, createInferenceConfig());
+  EXPECT_TRUE(inferenceManager->applyInference(inferenceParams));
+
+  ScAddr const & argument = context.HelperFindBySystemIdtf("argument");
+  EXPECT_TRUE(context.HelperCheckEdge(
+      context.HelperFindBySystemIdtf("class_10"), argument, ScType::EdgeAccessConstPosPerm));
+  EXPECT_TRUE(context.HelperCheckEdge(
+      inferenceParams.outputStructure, context.HelperFindBySystemIdtf("class_1"), ScType::EdgeAccessConstPosPerm));
+  for (char const * fanClass : {"class_fan_1", "class_fan_2", "class_fan_3"})
+  {
+    EXPECT_FALSE(context.HelperCheckEdge(
+        context.HelperFindBySystemIdtf(fanClass), argument, ScType::EdgeAccessConstPosPerm));
+  }
+
+  // Backward layers are narrower than the forward frontier, so the backward search reaches rule_1 which premise is a
+  // fact. Then rule_1 is committed and rule_2, ..., rule_10 are used from it to the target, the fan is not used
+  InferenceProfile const profile = inferenceManager->getProfile();
+  EXPECT_EQ(profile.formulasUsesAmount, 10u);
+  EXPECT_EQ(profile.skippedFormulasAmount, 3u);
+}
+
+}  // namespace bidirectionalInferenceTest
@@ -0,0 +1,125 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_test.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+#include "utils/ClassHierarchy.hpp"
+
+using namespace inference;
+
+namespace classHierarchyTest
+{
+ScsLoader loader;
+std::string const TEST_FILES_DIR_PATH = TEMPLATE_SEARCH_MODULE_TEST_SRC_PATH "/testStructures/ManagerModule/";
+
+using ClassHierarchyTest = ScMemoryTest;
+
+void initialize()
+{
+  InferenceKeynodes::InitGlobal();
+  scAgentsCommon::CoreKeynodes::InitGlobal();
+}
+
+size_t countMemberships(ScMemoryContext & context, std::string const & classIdentifier, std::string const & element)
+{
+  ScIterator3Ptr const membershipsIterator = context.Iterator3(
+      context.HelperResolveSystemIdtf(classIdentifier),
+      ScType::EdgeAccessConstPosPerm,
+      context.HelperResolveSystemIdtf(element));
+  size_t membershipsAmount = 0;
+  while (membershipsIterator->Next())
+    ++membershipsAmount;
+  return membershipsAmount;
+}
+
+TEST_F(ClassHierarchyTest, SubclassesAreFoundByBitsets)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  ScAddrVector classes;
+  for (size_t classIndex = 0; classIndex < 70; ++classIndex)
+    classes.push_back(context.CreateNode(ScType::NodeConstClass));
+  ClassHierarchy classHierarchy;
+  for (size_t classIndex = 0; classIndex + 2 < classes.size(); ++classIndex)
+    classHierarchy.addSubclass(classes[classIndex], classes[classIndex + 1]);
+  // Classes from the 50th to the 68th are a cycle
+  classHierarchy.addSubclass(classes[68], classes[50]);
+  classHierarchy.encode();
+
+  EXPECT_EQ(classHierarchy.size(), 69u);
+  EXPECT_TRUE(classHierarchy.isSubclassOf(classes[0], classes[68]));
+  EXPECT_FALSE(classHierarchy.isSubclassOf(classes[68], classes[0]));
+  EXPECT_TRUE(classHierarchy.isSubclassOf(classes[60], classes[55]));
+  EXPECT_TRUE(classHierarchy.isSubclassOf(classes[69], classes[69]));
+  EXPECT_FALSE(classHierarchy.isSubclassOf(classes[69], classes[0]));
+  EXPECT_EQ(classHierarchy.getSubclasses(classes[0]), ScAddrVector({classes[0]}));
+  EXPECT_EQ(classHierarchy.getSubclasses(classes[49]).size(), 50u);
+  EXPECT_EQ(classHierarchy.getSubclasses(classes[55]).size(), 69u);
+  EXPECT_THROW(classHierarchy.getSubclasses(classes[69]), utils::ExceptionItemNotFound);
+}
+
+TEST_F(ClassHierarchyTest, MembershipsAreGeneratedByHierarchy)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "classHierarchyTest.scs");
+  initialize();
+
+  InferenceParams const inferenceParams{
+      context.HelperResolveSystemIdtf("formulas_set"),
+      {},
+      {context.HelperResolveSystemIdtf("input_structure")},
+      context.CreateNode(ScType::NodeConstStruct)};
+  InferenceConfig const inferenceConfig{
+      GENERATE_UNIQUE_FORMULAS, REPLACEMENTS_ALL, TREE_ONLY_OUTPUT_STRUCTURE, SEARCH_IN_STRUCTURES};
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerAll(&context, inferenceConfig);
+  EXPECT_TRUE(inferenceManager->applyInference(inferenceParams));
+
+  // Every rule is used once, but memberships are propagated through the whole hierarchy in any order of rules
+  for (char const * element : {"figure_1", "figure_2", "figure_3"})
+    EXPECT_EQ(countMemberships(context, "concept_polygon", element), 1u);
+  for (char const * element : {"figure_1", "figure_2"})
+    EXPECT_EQ(countMemberships(context, "concept_quadrangle", element), 1u);
+  EXPECT_EQ(countMemberships(context, "concept_rectangle", "figure_1"), 1u);
+  EXPECT_EQ(countMemberships(context, "concept_rectangle", "figure_3"), 0u);
+
+  // Membership of figure_4 is not in the input structure
+  EXPECT_EQ(countMemberships(context, "concept_polygon", "figure_4"), 0u);
+}
+
+TEST_F(ClassHierarchyTest, HierarchyIsBuiltByLevels)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "classHierarchyTest.scs");
+  initialize();
+
+  InferenceParams const inferenceParams{
+      context.HelperResolveSystemIdtf("formulas_by_levels_set"),
+      {},
+      {context.HelperResolveSystemIdtf("input_structure")},
+      context.CreateNode(ScType::NodeConstStruct)};
+  InferenceConfig const inferenceConfig{
+      GENERATE_UNIQUE_FORMULAS, REPLACEMENTS_ALL, TREE_ONLY_OUTPUT_STRUCTURE, SEARCH_IN_STRUCTURES};
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerAll(&context, inferenceConfig);
+  EXPECT_TRUE(inferenceManager->applyInference(inferenceParams));
+
+  // quadrangle_rule is used before rules of the second level, so it doesn't apply them through the hierarchy
+  EXPECT_EQ(countMemberships(context, "concept_polygon", "figure_3"), 1u);
+  for (char const * element : {"figure_1", "figure_2"})
+  {
+    EXPECT_EQ(countMemberships(context, "concept_quadrangle", element), 1u);
+    EXPECT_EQ(countMemberships(context, "concept_polygon", element), 0u);
+  }
+}
+
+}  // namespace classHierarchyTest
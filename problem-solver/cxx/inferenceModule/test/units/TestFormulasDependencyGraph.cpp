@@ -0,0 +1,159 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_test.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+#include "sc-agents-common/utils/IteratorUtils.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+#include "manager/inferenceManager/FormulasDependencyGraph.hpp"
+
+using namespace inference;
+
+namespace formulasDependencyGraphTest
+{
+ScsLoader loader;
+std::string const TEST_FILES_DIR_PATH = TEMPLATE_SEARCH_MODULE_TEST_SRC_PATH "/testStructures/ManagerModule/";
+
+using FormulasDependencyGraphTest = ScMemoryTest;
+
+void initialize()
+{
+  InferenceKeynodes::InitGlobal();
+  scAgentsCommon::CoreKeynodes::InitGlobal();
+}
+
+bool applyInference(ScMemoryContext & context, size_t workersAmount)
+{
+  ScAddr const & argumentSet = context.HelperResolveSystemIdtf("argument_set");
+  ScAddrVector const & argumentVector = utils::IteratorUtils::getAllWithType(&context, argumentSet, ScType::Node);
+  ScAddr const & outputStructure = context.CreateNode(ScType::NodeConstStruct);
+  InferenceParams const & inferenceParams{
+      context.HelperResolveSystemIdtf("rules_set"),
+      argumentVector,
+      {context.HelperResolveSystemIdtf("input_structure")},
+      outputStructure,
+      context.HelperResolveSystemIdtf("target_template")};
+
+  InferenceConfig inferenceConfig{
+      GENERATE_UNIQUE_FORMULAS, REPLACEMENTS_ALL, TREE_ONLY_OUTPUT_STRUCTURE, SEARCH_IN_STRUCTURES};
+  inferenceConfig.workersAmount = workersAmount;
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerTarget(&context, inferenceConfig);
+  return inferenceManager->applyInference(inferenceParams);
+}
+
+TEST_F(FormulasDependencyGraphTest, ComponentsInTopologicalOrder)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "formulasDependencyGraphTest.scs");
+  initialize();
+
+  // rule_1 generates premise of rule_2, rule_2 and rule_3 generate premises of each other, rule_4 is independent
+  ScAddrVector const formulas{
+      context.HelperResolveSystemIdtf("rule_2"),
+      context.HelperResolveSystemIdtf("rule_4"),
+      context.HelperResolveSystemIdtf("rule_3"),
+      context.HelperResolveSystemIdtf("rule_1")};
+  FormulasDependencyGraph const dependencyGraph(&context, formulas);
+
+  EXPECT_TRUE(dependencyGraph.dependsOn(0, 3));
+  EXPECT_FALSE(dependencyGraph.dependsOn(3, 0));
+  EXPECT_TRUE(dependencyGraph.dependsOn(0, 2));
+  EXPECT_TRUE(dependencyGraph.dependsOn(2, 0));
+  EXPECT_FALSE(dependencyGraph.dependsOn(1, 1));
+
+  std::vector<FormulasDependencyGraph::Partition> const & partitions = dependencyGraph.getPartitions();
+  ASSERT_EQ(partitions.size(), 2u);
+  EXPECT_EQ(partitions[0].formulasIndices, std::vector<size_t>({0, 2, 3}));
+  ASSERT_EQ(partitions[0].components.size(), 2u);
+  EXPECT_EQ(partitions[0].components[0].formulasIndices, std::vector<size_t>({3}));
+  EXPECT_FALSE(partitions[0].components[0].isRecursive);
+  EXPECT_EQ(partitions[0].components[1].formulasIndices, std::vector<size_t>({0, 2}));
+  EXPECT_TRUE(partitions[0].components[1].isRecursive);
+
+  EXPECT_EQ(partitions[1].formulasIndices, std::vector<size_t>({1}));
+  ASSERT_EQ(partitions[1].components.size(), 1u);
+  EXPECT_FALSE(partitions[1].components[0].isRecursive);
+}
+
+TEST_F(FormulasDependencyGraphTest, IndependentComponentsInOrderOfFormulas)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "formulasDependencyGraphTest.scs");
+  initialize();
+
+  // rule_5 and rule_1 generate premise of rule_2 and don't depend on each other
+  ScAddrVector const formulas{
+      context.HelperResolveSystemIdtf("rule_2"),
+      context.HelperResolveSystemIdtf("rule_5"),
+      context.HelperResolveSystemIdtf("rule_1")};
+  FormulasDependencyGraph const dependencyGraph(&context, formulas);
+
+  std::vector<FormulasDependencyGraph::Partition> const & partitions = dependencyGraph.getPartitions();
+  ASSERT_EQ(partitions.size(), 1u);
+  ASSERT_EQ(partitions[0].components.size(), 3u);
+  EXPECT_EQ(partitions[0].components[0].formulasIndices, std::vector<size_t>({1}));
+  EXPECT_EQ(partitions[0].components[1].formulasIndices, std::vector<size_t>({2}));
+  EXPECT_EQ(partitions[0].components[2].formulasIndices, std::vector<size_t>({0}));
+}
+
+TEST_F(FormulasDependencyGraphTest, ConclusionWithoutPredicatesIsGeneratingAnything)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "formulasDependencyGraphTest.scs");
+  initialize();
+
+  // Conclusion of rule_6 is a common arc without a relation
+  ScAddrVector const formulas{context.HelperResolveSystemIdtf("rule_1"), context.HelperResolveSystemIdtf("rule_6")};
+  FormulasDependencyGraph const dependencyGraph(&context, formulas);
+
+  EXPECT_TRUE(dependencyGraph.getFormulaPredicates(1).isAnyGenerated);
+  EXPECT_FALSE(dependencyGraph.getFormulaPredicates(1).isAnySearched);
+  EXPECT_TRUE(dependencyGraph.dependsOn(0, 1));
+  EXPECT_FALSE(dependencyGraph.dependsOn(1, 0));
+
+  std::vector<FormulasDependencyGraph::Partition> const & partitions = dependencyGraph.getPartitions();
+  ASSERT_EQ(partitions.size(), 1u);
+  ASSERT_EQ(partitions[0].components.size(), 2u);
+  EXPECT_EQ(partitions[0].components[0].formulasIndices, std::vector<size_t>({1}));
+  EXPECT_EQ(partitions[0].components[1].formulasIndices, std::vector<size_t>({0}));
+}
+
+TEST_F(FormulasDependencyGraphTest, TargetIsAchievedByComponents)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "formulasDependencyGraphTest.scs");
+  initialize();
+
+  EXPECT_TRUE(applyInference(context, 1));
+
+  ScAddr const & argument = context.HelperFindBySystemIdtf("argument");
+  ScAddr const & targetClass = context.HelperFindBySystemIdtf("class_3");
+  EXPECT_TRUE(context.HelperCheckEdge(targetClass, argument, ScType::EdgeAccessConstPosPerm));
+}
+
+TEST_F(FormulasDependencyGraphTest, TargetIsAchievedByConcurrentPartitions)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "formulasDependencyGraphTest.scs");
+  initialize();
+
+  EXPECT_TRUE(applyInference(context, 2));
+
+  ScAddr const & argument = context.HelperFindBySystemIdtf("argument");
+  ScAddr const & targetClass = context.HelperFindBySystemIdtf("class_3");
+  EXPECT_TRUE(context.HelperCheckEdge(targetClass, argument, ScType::EdgeAccessConstPosPerm));
+}
+
+}  // namespace formulasDependencyGraphTest
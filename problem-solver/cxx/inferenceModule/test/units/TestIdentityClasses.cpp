@@ -0,0 +1,95 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_test.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+#include "utils/IdentityClasses.hpp"
+
+using namespace inference;
+
+namespace identityClassesTest
+{
+ScsLoader loader;
+std::string const TEST_FILES_DIR_PATH = TEMPLATE_SEARCH_MODULE_TEST_SRC_PATH "/testStructures/ManagerModule/";
+
+using IdentityClassesTest = ScMemoryTest;
+
+void initialize()
+{
+  InferenceKeynodes::InitGlobal();
+  scAgentsCommon::CoreKeynodes::InitGlobal();
+}
+
+bool applyInference(ScMemoryContext & context, IdentityType identityType)
+{
+  InferenceParams const inferenceParams{
+      context.HelperResolveSystemIdtf("formulas_set"),
+      {},
+      {context.HelperResolveSystemIdtf("input_structure")},
+      context.CreateNode(ScType::NodeConstStruct)};
+  InferenceConfig inferenceConfig{
+      GENERATE_UNIQUE_FORMULAS, REPLACEMENTS_ALL, TREE_ONLY_OUTPUT_STRUCTURE, SEARCH_IN_STRUCTURES};
+  inferenceConfig.identityType = identityType;
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerAll(&context, inferenceConfig);
+  return inferenceManager->applyInference(inferenceParams);
+}
+
+TEST_F(IdentityClassesTest, ClassesAreUnitedWithFirstRepresentative)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  ScAddrVector elements;
+  for (size_t elementIndex = 0; elementIndex < 6; ++elementIndex)
+    elements.push_back(context.CreateNode(ScType::NodeConst));
+  IdentityClasses identityClasses;
+  identityClasses.unite(elements[0], elements[1]);
+  identityClasses.unite(elements[2], elements[3]);
+  identityClasses.unite(elements[3], elements[1]);
+  identityClasses.unite(elements[4], elements[4]);
+
+  EXPECT_EQ(identityClasses.size(), 5u);
+  for (size_t elementIndex = 0; elementIndex < 4; ++elementIndex)
+    EXPECT_EQ(identityClasses.getRepresentative(elements[elementIndex]), elements[0]);
+  EXPECT_EQ(
+      identityClasses.getIdenticalElements(elements[2]),
+      ScAddrVector({elements[0], elements[1], elements[2], elements[3]}));
+  EXPECT_EQ(identityClasses.getRepresentative(elements[5]), elements[5]);
+  EXPECT_EQ(identityClasses.getIdenticalElements(elements[5]), ScAddrVector({elements[5]}));
+}
+
+TEST_F(IdentityClassesTest, IdenticalElementsAreJoined)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "identityTest.scs");
+  initialize();
+
+  EXPECT_TRUE(applyInference(context, IDENTITY_RELATION));
+
+  // Generated construction is about the representative of identical elements
+  ScAddr const & portCityClass = context.HelperFindBySystemIdtf("concept_port_city");
+  EXPECT_TRUE(context.HelperCheckEdge(
+      portCityClass, context.HelperFindBySystemIdtf("odessa"), ScType::EdgeAccessConstPosPerm));
+  EXPECT_FALSE(context.HelperCheckEdge(
+      portCityClass, context.HelperFindBySystemIdtf("odesa"), ScType::EdgeAccessConstPosPerm));
+}
+
+TEST_F(IdentityClassesTest, IdenticalElementsAreDifferentWithoutIdentity)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "identityTest.scs");
+  initialize();
+
+  EXPECT_FALSE(applyInference(context, IDENTITY_NONE));
+}
+
+}  // namespace identityClassesTest
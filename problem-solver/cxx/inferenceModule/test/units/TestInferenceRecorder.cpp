@@ -0,0 +1,122 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <cstdio>
+#include <fstream>
+
+#include "ScMemoryReloadTest.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+#include "sc-agents-common/utils/IteratorUtils.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+#include "recorder/InferenceRecorder.hpp"
+#include "recorder/InferenceReplay.hpp"
+
+using namespace inference;
+
+namespace inferenceRecorderTest
+{
+ScsLoader loader;
+std::string const TEST_FILES_DIR_PATH = TEMPLATE_SEARCH_MODULE_TEST_SRC_PATH "/testStructures/ManagerModule/";
+std::string const BUNDLE_DIRECTORY = ".";
+
+class InferenceRecorderTest : public ScMemoryReloadTest
+{
+protected:
+  void initialize()
+  {
+    InferenceKeynodes::InitGlobal();
+    scAgentsCommon::CoreKeynodes::InitGlobal();
+  }
+
+  void removeBundle()
+  {
+    std::remove((BUNDLE_DIRECTORY + "/" + InferenceRecorder::BUNDLE_FILE_NAME).c_str());
+    std::remove((BUNDLE_DIRECTORY + "/" + InferenceRecorder::MANIFEST_FILE_NAME).c_str());
+  }
+};
+
+TEST_F(InferenceRecorderTest, RecordedInferenceIsReplayedInNewMemory)
+{
+  loader.loadScsFile(*m_ctx, TEST_FILES_DIR_PATH + "bestFirstInferenceTest.scs");
+  initialize();
+
+  {
+    ScMemoryContext & context = *m_ctx;
+    ScAddr const & argumentSet = context.HelperResolveSystemIdtf("argument_set");
+    InferenceParams const inferenceParams{
+        context.HelperResolveSystemIdtf("rules_set"),
+        utils::IteratorUtils::getAllWithType(&context, argumentSet, ScType::Node),
+        {context.HelperResolveSystemIdtf("input_structure")},
+        context.CreateNode(ScType::NodeConstStruct),
+        context.HelperResolveSystemIdtf("target_template")};
+    InferenceConfig inferenceConfig{
+        GENERATE_UNIQUE_FORMULAS, REPLACEMENTS_ALL, TREE_ONLY_OUTPUT_STRUCTURE, SEARCH_IN_STRUCTURES};
+    inferenceConfig.frontierSize = 2;
+    inferenceConfig.joinConfig.threadsAmount = 3;
+    inferenceConfig.joinConfig.parallelThreshold = 5;
+    inferenceConfig.joinConfig.deterministic = false;
+    inferenceConfig.joinConfig.memoryThreshold = 1024;
+
+    // Variable links of templates stay variable after replay
+    ScAddr const & variableLink = context.CreateLink(ScType::LinkVar);
+    context.SetLinkContent(variableLink, std::string("text"));
+    context.HelperSetSystemIdtf("_variable_link", variableLink);
+    context.CreateEdge(ScType::EdgeAccessConstPosPerm, inferenceParams.inputStructures[0], variableLink);
+
+    InferenceRecorder recorder(&context, BUNDLE_DIRECTORY);
+    recorder.record(inferenceParams, inferenceConfig, STRATEGY_BEST_FIRST);
+    EXPECT_GT(recorder.getRecordedElementsAmount(), 0u);
+  }
+
+  // The bundle is replayed without knowledge of the recorded memory
+  reloadMemory();
+  ScMemoryContext & context = *m_ctx;
+  EXPECT_FALSE(context.HelperFindBySystemIdtf("rule_1").IsValid());
+
+  InferenceReplay const replay(BUNDLE_DIRECTORY);
+  loader.loadScsFile(context, replay.getBundlePath());
+  initialize();
+  removeBundle();
+
+  EXPECT_EQ(replay.getStrategy(), STRATEGY_BEST_FIRST);
+  InferenceConfig const & inferenceConfig = replay.getConfig();
+  EXPECT_EQ(inferenceConfig.searchType, SEARCH_IN_STRUCTURES);
+  EXPECT_EQ(inferenceConfig.frontierSize, 2u);
+  EXPECT_EQ(inferenceConfig.joinConfig.threadsAmount, 3u);
+  EXPECT_EQ(inferenceConfig.joinConfig.parallelThreshold, 5u);
+  EXPECT_FALSE(inferenceConfig.joinConfig.deterministic);
+  EXPECT_EQ(inferenceConfig.joinConfig.memoryThreshold, 1024u);
+
+  ScAddr const & variableLink = context.HelperFindBySystemIdtf("_variable_link");
+  ASSERT_TRUE(variableLink.IsValid());
+  EXPECT_TRUE(context.GetElementType(variableLink).IsVar());
+
+  InferenceParams const inferenceParams = replay.createInferenceParams(&context);
+  ScAddr const & argument = context.HelperFindBySystemIdtf("argument");
+  ASSERT_TRUE(argument.IsValid());
+  EXPECT_EQ(inferenceParams.arguments, ScAddrVector({argument}));
+
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructInferenceManager(&context, replay.getStrategy(), inferenceConfig);
+  EXPECT_TRUE(inferenceManager->applyInference(inferenceParams));
+  EXPECT_TRUE(context.HelperCheckEdge(
+      context.HelperFindBySystemIdtf("class_d"), argument, ScType::EdgeAccessConstPosPerm));
+}
+
+TEST_F(InferenceRecorderTest, ManifestOfAnotherVersionIsNotReplayed)
+{
+  std::ofstream manifest(BUNDLE_DIRECTORY + "/" + InferenceRecorder::MANIFEST_FILE_NAME);
+  manifest << "{\n\"version\": 0\n}\n";
+  manifest.close();
+
+  EXPECT_THROW(InferenceReplay{BUNDLE_DIRECTORY}, utils::ExceptionInvalidParams);
+  removeBundle();
+}
+
+}  // namespace inferenceRecorderTest
@@ -0,0 +1,249 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <thread>
+
+#include "sc_test.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+#include "sc-agents-common/utils/IteratorUtils.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+#include "sink/InferenceSinkExporter.hpp"
+#include "sink/InferenceSinkFile.hpp"
+#include "sink/InferenceSinkQueue.hpp"
+#include "sink/InferenceSinkStructure.hpp"
+
+using namespace inference;
+
+namespace inferenceSinksTest
+{
+ScsLoader loader;
+std::string const TEST_FILES_DIR_PATH = TEMPLATE_SEARCH_MODULE_TEST_SRC_PATH "/testStructures/ManagerModule/";
+std::string const SINK_FILE_PATH = "inferenceSinksTest.txt";
+
+using InferenceSinksTest = ScMemoryTest;
+
+std::string readFile(std::string const & filePath)
+{
+  std::ifstream file(filePath, std::ios::binary);
+  std::string content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  file.close();
+  std::remove(filePath.c_str());
+  return content;
+}
+
+uint64_t readNumber(std::string const & content, size_t offset, size_t bytesAmount)
+{
+  uint64_t number = 0;
+  for (size_t byteIndex = 0; byteIndex < bytesAmount; ++byteIndex)
+    number |= static_cast<uint64_t>(static_cast<unsigned char>(content[offset + byteIndex])) << (8 * byteIndex);
+  return number;
+}
+
+void initialize()
+{
+  InferenceKeynodes::InitGlobal();
+  scAgentsCommon::CoreKeynodes::InitGlobal();
+}
+
+InferenceParams createInferenceParams(ScMemoryContext & context)
+{
+  InferenceParams inferenceParams;
+  inferenceParams.formulasSet = context.HelperResolveSystemIdtf("rules_set");
+  inferenceParams.arguments = utils::IteratorUtils::getAllWithType(
+      &context, context.HelperResolveSystemIdtf("argument_set"), ScType::Node);
+  inferenceParams.inputStructures = {context.HelperResolveSystemIdtf("input_structure")};
+  inferenceParams.outputStructure = context.CreateNode(ScType::NodeConstStruct);
+  inferenceParams.targetStructure = context.HelperResolveSystemIdtf("target_template");
+  return inferenceParams;
+}
+
+std::unique_ptr<InferenceManagerAbstract> createInferenceManager(ScMemoryContext & context)
+{
+  InferenceConfig inferenceConfig;
+  inferenceConfig.generationType = GENERATE_UNIQUE_FORMULAS;
+  inferenceConfig.replacementsUsingType = REPLACEMENTS_ALL;
+  inferenceConfig.solutionTreeType = TREE_ONLY_OUTPUT_STRUCTURE;
+  inferenceConfig.searchType = SEARCH_IN_STRUCTURES;
+  return InferenceManagerFactory::constructDirectInferenceManagerBestFirst(&context, inferenceConfig);
+}
+
+TEST_F(InferenceSinksTest, FiringsAreConsumedByAnotherThread)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bestFirstInferenceTest.scs");
+  initialize();
+
+  // The queue is smaller than amount of firings, so inference waits for the consumer
+  std::shared_ptr<InferenceSinkQueue> const queue = std::make_shared<InferenceSinkQueue>(1);
+  std::vector<InferenceFiring> firings;
+  std::thread consumer([&queue, &firings]() {
+    InferenceFiring firing;
+    while (queue->pop(firing))
+      firings.push_back(firing);
+  });
+
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager = createInferenceManager(context);
+  inferenceManager->addSink(queue);
+  InferenceParams const inferenceParams = createInferenceParams(context);
+  EXPECT_TRUE(inferenceManager->applyInference(inferenceParams));
+  queue->close();
+  consumer.join();
+
+  ScAddr const & argument = context.HelperFindBySystemIdtf("argument");
+  ASSERT_EQ(firings.size(), 3u);
+  std::vector<std::string> const classes = {"class_b", "class_c", "class_d"};
+  for (size_t firingIndex = 0; firingIndex < firings.size(); ++firingIndex)
+  {
+    InferenceFiring const & firing = firings[firingIndex];
+    EXPECT_EQ(context.HelperGetSystemIdtf(firing.formula), "rule_" + std::to_string(firingIndex + 1));
+    EXPECT_EQ(firing.replacements.at("_arg"), ScAddrVector({argument}));
+
+    ScAddr const & generatedClass = context.HelperFindBySystemIdtf(classes[firingIndex]);
+    EXPECT_NE(
+        std::find(firing.generatedElements.cbegin(), firing.generatedElements.cend(), generatedClass),
+        firing.generatedElements.cend());
+    for (ScAddr const & element : firing.generatedElements)
+      EXPECT_TRUE(context.HelperCheckEdge(inferenceParams.outputStructure, element, ScType::EdgeAccessConstPosPerm));
+  }
+
+  InferenceFiring firing;
+  EXPECT_FALSE(queue->tryPop(firing));
+}
+
+TEST_F(InferenceSinksTest, StructureSinkHasElementsOfOutputStructure)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bestFirstInferenceTest.scs");
+  initialize();
+
+  ScAddr const & sinkStructure = context.CreateNode(ScType::NodeConstStruct);
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager = createInferenceManager(context);
+  inferenceManager->addSink(std::make_shared<InferenceSinkStructure>(&context, sinkStructure));
+  InferenceParams const inferenceParams = createInferenceParams(context);
+  EXPECT_TRUE(inferenceManager->applyInference(inferenceParams));
+
+  ScAddrVector const & outputElements = utils::IteratorUtils::getAllWithType(
+      &context, inferenceParams.outputStructure, ScType::Unknown);
+  ScAddrVector const & sinkElements = utils::IteratorUtils::getAllWithType(&context, sinkStructure, ScType::Unknown);
+  std::set<ScAddr, ScAddLessFunc> const sinkElementsSet(sinkElements.cbegin(), sinkElements.cend());
+  std::set<ScAddr, ScAddLessFunc> const outputElementsSet(outputElements.cbegin(), outputElements.cend());
+  EXPECT_FALSE(sinkElementsSet.empty());
+  EXPECT_EQ(sinkElementsSet, outputElementsSet);
+}
+
+TEST_F(InferenceSinksTest, FileSinkWritesLineForEveryFiring)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bestFirstInferenceTest.scs");
+  initialize();
+
+  {
+    std::unique_ptr<InferenceManagerAbstract> inferenceManager = createInferenceManager(context);
+    inferenceManager->addSink(std::make_shared<InferenceSinkFile>(&context, SINK_FILE_PATH));
+    EXPECT_TRUE(inferenceManager->applyInference(createInferenceParams(context)));
+  }
+
+  std::ifstream file(SINK_FILE_PATH);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(file, line);)
+    lines.push_back(line);
+  file.close();
+  std::remove(SINK_FILE_PATH.c_str());
+
+  ASSERT_EQ(lines.size(), 3u);
+  EXPECT_EQ(lines[0].substr(0, lines[0].find('\t')), "rule_1");
+  EXPECT_NE(lines[0].find("\t_arg=argument\t"), std::string::npos);
+  EXPECT_NE(lines[0].find("class_b"), std::string::npos);
+  EXPECT_EQ(lines[2].substr(0, lines[2].find('\t')), "rule_3");
+  EXPECT_NE(lines[2].find("class_d"), std::string::npos);
+}
+
+TEST_F(InferenceSinksTest, FiringsAreExportedAsJsonLines)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bestFirstInferenceTest.scs");
+  initialize();
+
+  // Every firing fills the buffer, so every firing is written by the writer thread
+  std::shared_ptr<InferenceSinkExporter> const exporter =
+      std::make_shared<InferenceSinkExporter>(&context, SINK_FILE_PATH, EXPORT_NDJSON, 1);
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager = createInferenceManager(context);
+  inferenceManager->addSink(exporter);
+  EXPECT_TRUE(inferenceManager->applyInference(createInferenceParams(context)));
+  exporter->close();
+  EXPECT_EQ(exporter->getExportedFiringsAmount(), 3u);
+
+  std::string const content = readFile(SINK_FILE_PATH);
+  std::vector<std::string> lines;
+  for (size_t lineBegin = 0, lineEnd; (lineEnd = content.find('\n', lineBegin)) != std::string::npos;
+       lineBegin = lineEnd + 1)
+    lines.push_back(content.substr(lineBegin, lineEnd - lineBegin));
+
+  ASSERT_EQ(lines.size(), 3u);
+  EXPECT_EQ(lines[0].find(R"({"formula":"rule_1","replacements":{"_arg":["argument"]},"triples":[[)"), 0u);
+  EXPECT_NE(lines[0].find(R"(["class_b","#)"), std::string::npos);
+  EXPECT_NE(lines[0].find(R"(","argument"])"), std::string::npos);
+  EXPECT_NE(lines[2].find(R"(["class_d","#)"), std::string::npos);
+}
+
+TEST_F(InferenceSinksTest, FiringsAreExportedAsIndexedBinaryRecords)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bestFirstInferenceTest.scs");
+  initialize();
+
+  {
+    std::unique_ptr<InferenceManagerAbstract> inferenceManager = createInferenceManager(context);
+    inferenceManager->addSink(std::make_shared<InferenceSinkExporter>(&context, SINK_FILE_PATH, EXPORT_BINARY));
+    EXPECT_TRUE(inferenceManager->applyInference(createInferenceParams(context)));
+  }
+
+  std::string const content = readFile(SINK_FILE_PATH);
+  std::string const & magic = InferenceSinkExporter::BINARY_MAGIC;
+  ASSERT_GT(content.size(), 2 * magic.size() + 16);
+  EXPECT_EQ(content.substr(0, magic.size()), magic);
+  EXPECT_EQ(readNumber(content, magic.size(), 4), InferenceSinkExporter::BINARY_VERSION);
+  EXPECT_EQ(content.substr(content.size() - magic.size()), magic);
+
+  size_t const footerOffset = content.size() - magic.size() - 16;
+  uint64_t const recordsAmount = readNumber(content, footerOffset, 8);
+  uint64_t const indexOffset = readNumber(content, footerOffset + 8, 8);
+  ASSERT_EQ(recordsAmount, 3u);
+  EXPECT_EQ(indexOffset + 8 * recordsAmount, footerOffset);
+
+  // The last record is found by the index, its formula is the first string of the record payload
+  uint64_t const lastRecordOffset = readNumber(content, indexOffset + 8 * (recordsAmount - 1), 8);
+  uint64_t const formulaSize = readNumber(content, lastRecordOffset + 4, 4);
+  EXPECT_EQ(content.substr(lastRecordOffset + 8, formulaSize), "rule_3");
+  EXPECT_EQ(lastRecordOffset + 4 + readNumber(content, lastRecordOffset, 4), indexOffset);
+}
+
+TEST_F(InferenceSinksTest, FailedExportIsReportedByClose)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  // Every write to the device fails because there is no space left
+  InferenceSinkExporter exporter(&context, "/dev/full", EXPORT_NDJSON, 1);
+  InferenceFiring firing;
+  firing.formula = context.CreateNode(ScType::NodeConst);
+  exporter.onFiring(firing);
+  EXPECT_THROW(exporter.close(), utils::ExceptionInvalidState);
+}
+
+}  // namespace inferenceSinksTest
@@ -0,0 +1,98 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_test.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+#include "sc-agents-common/utils/IteratorUtils.hpp"
+
+#include "classifier/FormulaClassifier.hpp"
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+
+using namespace inference;
+
+namespace inverseRelationsTest
+{
+ScsLoader loader;
+std::string const TEST_FILES_DIR_PATH = TEMPLATE_SEARCH_MODULE_TEST_SRC_PATH "/testStructures/ManagerModule/";
+
+using InverseRelationsTest = ScMemoryTest;
+
+void initialize()
+{
+  InferenceKeynodes::InitGlobal();
+  scAgentsCommon::CoreKeynodes::InitGlobal();
+}
+
+size_t countPairs(
+    ScMemoryContext & context,
+    std::string const & source,
+    std::string const & relation,
+    std::string const & target)
+{
+  ScIterator5Ptr const pairsIterator = context.Iterator5(
+      context.HelperResolveSystemIdtf(source),
+      ScType::EdgeDCommonConst,
+      context.HelperResolveSystemIdtf(target),
+      ScType::EdgeAccessConstPosPerm,
+      context.HelperResolveSystemIdtf(relation));
+  size_t pairsAmount = 0;
+  while (pairsIterator->Next())
+    ++pairsAmount;
+  return pairsAmount;
+}
+
+TEST_F(InverseRelationsTest, InverseRulesAreClassified)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "inverseRelationsTest.scs");
+  initialize();
+
+  FormulaClassifier::InverseRule rule;
+  EXPECT_TRUE(FormulaClassifier::isInverseRule(
+      &context,
+      context.HelperResolveSystemIdtf("adjacency_if"),
+      context.HelperResolveSystemIdtf("adjacency_then"),
+      rule));
+  EXPECT_EQ(rule.relation, rule.inverseRelation);
+
+  EXPECT_TRUE(FormulaClassifier::isInverseRule(
+      &context, context.HelperResolveSystemIdtf("parent_if"), context.HelperResolveSystemIdtf("child_then"), rule));
+  EXPECT_EQ(rule.inverseRelation, context.HelperResolveSystemIdtf("nrel_child"));
+
+  EXPECT_FALSE(FormulaClassifier::isInverseRule(
+      &context, context.HelperResolveSystemIdtf("parent_if"), context.HelperResolveSystemIdtf("parent_if"), rule));
+}
+
+TEST_F(InverseRelationsTest, InversePairsAreGeneratedByOnePass)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "inverseRelationsTest.scs");
+  initialize();
+
+  InferenceParams const inferenceParams{
+      context.HelperResolveSystemIdtf("formulas_set"),
+      {},
+      {context.HelperResolveSystemIdtf("input_structure")},
+      context.CreateNode(ScType::NodeConstStruct)};
+  InferenceConfig const inferenceConfig{
+      GENERATE_UNIQUE_FORMULAS, REPLACEMENTS_ALL, TREE_ONLY_OUTPUT_STRUCTURE, SEARCH_IN_STRUCTURES};
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerAll(&context, inferenceConfig);
+  EXPECT_TRUE(inferenceManager->applyInference(inferenceParams));
+
+  EXPECT_EQ(countPairs(context, "element_2", "nrel_adjacency", "element_1"), 1u);
+  EXPECT_EQ(countPairs(context, "element_2", "nrel_adjacency", "element_3"), 1u);
+  EXPECT_EQ(countPairs(context, "element_3", "nrel_adjacency", "element_2"), 1u);
+  EXPECT_EQ(countPairs(context, "person_2", "nrel_child", "person_1"), 1u);
+  EXPECT_EQ(countPairs(context, "person_3", "nrel_child", "person_1"), 1u);
+  EXPECT_EQ(countPairs(context, "person_1", "nrel_child", "person_2"), 0u);
+}
+
+}  // namespace inverseRelationsTest
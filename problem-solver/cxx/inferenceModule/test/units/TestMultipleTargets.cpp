@@ -0,0 +1,134 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <algorithm>
+
+#include "sc_test.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+#include "sc-agents-common/utils/IteratorUtils.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+
+using namespace inference;
+
+namespace multipleTargetsTest
+{
+ScsLoader loader;
+std::string const TEST_FILES_DIR_PATH = TEMPLATE_SEARCH_MODULE_TEST_SRC_PATH "/testStructures/ManagerModule/";
+
+using MultipleTargetsTest = ScMemoryTest;
+
+void initialize()
+{
+  InferenceKeynodes::InitGlobal();
+  scAgentsCommon::CoreKeynodes::InitGlobal();
+}
+
+InferenceParams createInferenceParams(
+    ScMemoryContext & context,
+    std::vector<std::string> const & targetsIdentifiers,
+    TargetsType targetsType)
+{
+  InferenceParams inferenceParams;
+  inferenceParams.formulasSet = context.HelperResolveSystemIdtf("rules_set");
+  inferenceParams.arguments = utils::IteratorUtils::getAllWithType(
+      &context, context.HelperResolveSystemIdtf("argument_set"), ScType::Node);
+  inferenceParams.inputStructures = {context.HelperResolveSystemIdtf("input_structure")};
+  inferenceParams.outputStructure = context.CreateNode(ScType::NodeConstStruct);
+  for (std::string const & targetIdentifier : targetsIdentifiers)
+    inferenceParams.targetStructures.push_back(context.HelperResolveSystemIdtf(targetIdentifier));
+  inferenceParams.targetsType = targetsType;
+  return inferenceParams;
+}
+
+InferenceConfig createInferenceConfig()
+{
+  InferenceConfig inferenceConfig;
+  inferenceConfig.generationType = GENERATE_UNIQUE_FORMULAS;
+  inferenceConfig.replacementsUsingType = REPLACEMENTS_ALL;
+  inferenceConfig.solutionTreeType = TREE_ONLY_OUTPUT_STRUCTURE;
+  inferenceConfig.searchType = SEARCH_IN_STRUCTURES;
+  return inferenceConfig;
+}
+
+TEST_F(MultipleTargetsTest, InferenceStopsAtAnyTarget)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "multipleTargetsTest.scs");
+  initialize();
+
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerTarget(&context, createInferenceConfig());
+  EXPECT_TRUE(inferenceManager->applyInference(
+      createInferenceParams(context, {"target_template_d", "target_template_b"}, TARGETS_ANY)));
+
+  std::vector<TargetResult> const targetsResults = inferenceManager->getTargetsResults();
+  ASSERT_EQ(targetsResults.size(), 2u);
+  EXPECT_EQ(targetsResults[0].targetStructure, context.HelperFindBySystemIdtf("target_template_d"));
+  EXPECT_FALSE(targetsResults[0].isAchieved);
+  EXPECT_TRUE(targetsResults[1].isAchieved);
+  EXPECT_EQ(targetsResults[1].formulasUsesAmount, 1u);
+  EXPECT_FALSE(context.HelperCheckEdge(
+      context.HelperFindBySystemIdtf("class_d"),
+      context.HelperFindBySystemIdtf("argument"),
+      ScType::EdgeAccessConstPosPerm));
+
+  // Uses of formulas are counted by every inference anew, the next inference generates in its own output structure
+  EXPECT_TRUE(inferenceManager->applyInference(
+      createInferenceParams(context, {"target_template_d", "target_template_b"}, TARGETS_ANY)));
+  EXPECT_EQ(inferenceManager->getTargetsResults()[1].formulasUsesAmount, 1u);
+}
+
+TEST_F(MultipleTargetsTest, InferenceStopsAtAllTargets)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "multipleTargetsTest.scs");
+  initialize();
+
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerTarget(&context, createInferenceConfig());
+  EXPECT_TRUE(inferenceManager->applyInference(createInferenceParams(
+      context, {"target_template_b", "target_template_d", "target_template_e"}, TARGETS_ALL)));
+
+  std::vector<TargetResult> const targetsResults = inferenceManager->getTargetsResults();
+  ASSERT_EQ(targetsResults.size(), 3u);
+  for (TargetResult const & targetResult : targetsResults)
+    EXPECT_TRUE(targetResult.isAchieved);
+  // class_b is generated by the first formula, class_d is generated by the third formula of the derivation at least
+  EXPECT_EQ(targetsResults[0].formulasUsesAmount, 1u);
+  EXPECT_GE(targetsResults[1].formulasUsesAmount, 3u);
+  EXPECT_EQ(
+      inferenceManager->getProfile().formulasUsesAmount,
+      std::max(targetsResults[1].formulasUsesAmount, targetsResults[2].formulasUsesAmount));
+}
+
+TEST_F(MultipleTargetsTest, TargetsAchievedBeforeInference)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "multipleTargetsTest.scs");
+  initialize();
+
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerBestFirst(&context, createInferenceConfig());
+  InferenceParams inferenceParams = createInferenceParams(context, {"target_template_d"}, TARGETS_ANY);
+  inferenceParams.targetStructure = context.HelperResolveSystemIdtf("if_1");
+  // Premise of rule_1 is in the input structure
+  EXPECT_FALSE(inferenceManager->applyInference(inferenceParams));
+
+  std::vector<TargetResult> const targetsResults = inferenceManager->getTargetsResults();
+  ASSERT_EQ(targetsResults.size(), 2u);
+  EXPECT_EQ(targetsResults[0].targetStructure, context.HelperFindBySystemIdtf("if_1"));
+  EXPECT_TRUE(targetsResults[0].isAchieved);
+  EXPECT_EQ(targetsResults[0].formulasUsesAmount, 0u);
+  EXPECT_FALSE(targetsResults[1].isAchieved);
+}
+
+}  // namespace multipleTargetsTest
@@ -0,0 +1,142 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "ScMemoryReloadTest.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+#include "manager/solutionTreeManager/SolutionTreeManagerEmpty.hpp"
+
+using namespace inference;
+
+namespace orderedCommitTest
+{
+ScsLoader loader;
+std::string const TEST_FILES_DIR_PATH = TEMPLATE_SEARCH_MODULE_TEST_SRC_PATH "/testStructures/ManagerModule/";
+
+std::vector<std::string> const GENERATED_CLASSES = {"class_2", "class_3", "class_5", "class_6"};
+
+/// Solution tree manager which remembers formulas and arguments of solution nodes in order of adding
+class SolutionTreeManagerRecorder : public SolutionTreeManagerEmpty
+{
+public:
+  explicit SolutionTreeManagerRecorder(ScMemoryContext * context)
+    : SolutionTreeManagerEmpty(context)
+    , context(context)
+  {
+  }
+
+  bool addNode(ScAddr const & formula, Replacements const & replacements) override
+  {
+    std::string node = context->HelperGetSystemIdtf(formula) + ":";
+    auto const & arguments = replacements.find("_arg");
+    if (arguments != replacements.cend())
+    {
+      for (ScAddr const & argument : arguments->second)
+        node += " " + context->HelperGetSystemIdtf(argument);
+    }
+    nodes.push_back(node);
+    return true;
+  }
+
+  std::vector<std::string> nodes;
+
+private:
+  ScMemoryContext * context;
+};
+
+/// Result of inference which doesn't depend on addresses of generated elements
+struct InferenceTrace
+{
+  bool result = false;
+  std::vector<std::string> solutionNodes;
+  std::map<std::string, std::set<std::string>> classesElements;
+  InferenceProfile profile;
+};
+
+class OrderedCommitTest : public ScMemoryReloadTest
+{
+protected:
+  /// Create new memory with the test knowledge base, so every inference is applied to the same knowledge base
+  void reloadKnowledgeBase()
+  {
+    reloadMemory();
+    loader.loadScsFile(*m_ctx, TEST_FILES_DIR_PATH + "orderedCommitTest.scs");
+    InferenceKeynodes::InitGlobal();
+    scAgentsCommon::CoreKeynodes::InitGlobal();
+  }
+
+  InferenceTrace applyInference(bool isTargetUsed, size_t workersAmount, bool orderedCommit)
+  {
+    reloadKnowledgeBase();
+    ScMemoryContext & context = *m_ctx;
+    InferenceParams const inferenceParams{
+        context.HelperResolveSystemIdtf("rules_set"),
+        {},
+        {context.HelperResolveSystemIdtf("input_structure")},
+        context.CreateNode(ScType::NodeConstStruct),
+        context.HelperResolveSystemIdtf("target_template")};
+
+    InferenceConfig inferenceConfig{
+        GENERATE_UNIQUE_FORMULAS, REPLACEMENTS_ALL, TREE_ONLY_OUTPUT_STRUCTURE, SEARCH_IN_ALL_KB};
+    inferenceConfig.workersAmount = workersAmount;
+    inferenceConfig.orderedCommit = orderedCommit;
+    std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+        isTargetUsed ? InferenceManagerFactory::constructDirectInferenceManagerTarget(&context, inferenceConfig)
+                     : InferenceManagerFactory::constructDirectInferenceManagerAll(&context, inferenceConfig);
+    std::shared_ptr<SolutionTreeManagerRecorder> const recorder =
+        std::make_shared<SolutionTreeManagerRecorder>(&context);
+    inferenceManager->setSolutionTreeManager(recorder);
+
+    InferenceTrace trace;
+    trace.result = inferenceManager->applyInference(inferenceParams);
+    trace.solutionNodes = recorder->nodes;
+    for (std::string const & generatedClass : GENERATED_CLASSES)
+    {
+      ScIterator3Ptr const elementsIterator = context.Iterator3(
+          context.HelperFindBySystemIdtf(generatedClass), ScType::EdgeAccessConstPosPerm, ScType::Unknown);
+      while (elementsIterator->Next())
+        trace.classesElements[generatedClass].insert(context.HelperGetSystemIdtf(elementsIterator->Get(2)));
+    }
+    trace.profile = inferenceManager->getProfile();
+    return trace;
+  }
+};
+
+TEST_F(OrderedCommitTest, ResultIsSameAsOfDirectInferenceManagerAll)
+{
+  InferenceTrace const sequentialTrace = applyInference(false, 1, false);
+  InferenceTrace const orderedTrace = applyInference(false, 3, true);
+
+  EXPECT_TRUE(sequentialTrace.result);
+  EXPECT_EQ(orderedTrace.result, sequentialTrace.result);
+  EXPECT_EQ(orderedTrace.solutionNodes, sequentialTrace.solutionNodes);
+  EXPECT_EQ(orderedTrace.classesElements, sequentialTrace.classesElements);
+  // rule_2 searches what rule_1 generates and rule_4 searches what rule_2 generates
+  EXPECT_EQ(
+      sequentialTrace.classesElements.at("class_6"), std::set<std::string>({"first_argument", "second_argument"}));
+
+  EXPECT_EQ(sequentialTrace.profile.speculativeFormulasAmount, 0u);
+  EXPECT_EQ(orderedTrace.profile.speculativeFormulasAmount, 4u);
+  EXPECT_EQ(orderedTrace.profile.reexecutedFormulasAmount, 2u);
+}
+
+TEST_F(OrderedCommitTest, TargetIsAchievedAsByDirectInferenceManagerTarget)
+{
+  InferenceTrace const sequentialTrace = applyInference(true, 1, false);
+  InferenceTrace const orderedTrace = applyInference(true, 3, true);
+
+  EXPECT_TRUE(sequentialTrace.result);
+  EXPECT_EQ(orderedTrace.result, sequentialTrace.result);
+  EXPECT_EQ(orderedTrace.solutionNodes, sequentialTrace.solutionNodes);
+  EXPECT_EQ(orderedTrace.classesElements, sequentialTrace.classesElements);
+  // Inference is stopped by rule_4 before independent rule_3 is used
+  EXPECT_EQ(orderedTrace.classesElements.count("class_5"), 0u);
+}
+
+}  // namespace orderedCommitTest
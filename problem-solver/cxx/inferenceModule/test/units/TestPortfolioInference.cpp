@@ -0,0 +1,149 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_test.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+#include "sc-agents-common/utils/IteratorUtils.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+#include "manager/inferenceManager/DirectInferenceManagerPortfolio.hpp"
+
+using namespace inference;
+
+namespace portfolioInferenceTest
+{
+ScsLoader loader;
+std::string const TEST_FILES_DIR_PATH = TEMPLATE_SEARCH_MODULE_TEST_SRC_PATH "/testStructures/ManagerModule/";
+
+using PortfolioInferenceTest = ScMemoryTest;
+
+void initialize()
+{
+  InferenceKeynodes::InitGlobal();
+  scAgentsCommon::CoreKeynodes::InitGlobal();
+}
+
+InferenceParams createInferenceParams(ScMemoryContext & context)
+{
+  InferenceParams inferenceParams;
+  inferenceParams.formulasSet = context.HelperResolveSystemIdtf("rules_set");
+  inferenceParams.arguments = utils::IteratorUtils::getAllWithType(
+      &context, context.HelperResolveSystemIdtf("argument_set"), ScType::Node);
+  inferenceParams.inputStructures = {context.HelperResolveSystemIdtf("input_structure")};
+  inferenceParams.outputStructure = context.CreateNode(ScType::NodeConstStruct);
+  inferenceParams.targetStructure = context.HelperResolveSystemIdtf("target_template");
+  return inferenceParams;
+}
+
+InferenceConfig createInferenceConfig(SearchType searchType)
+{
+  InferenceConfig inferenceConfig;
+  inferenceConfig.generationType = GENERATE_UNIQUE_FORMULAS;
+  inferenceConfig.replacementsUsingType = REPLACEMENTS_ALL;
+  inferenceConfig.solutionTreeType = TREE_ONLY_OUTPUT_STRUCTURE;
+  inferenceConfig.searchType = searchType;
+  return inferenceConfig;
+}
+
+size_t countMemberships(ScMemoryContext & context, std::string const & classIdentifier)
+{
+  ScIterator3Ptr const membershipsIterator = context.Iterator3(
+      context.HelperResolveSystemIdtf(classIdentifier),
+      ScType::EdgeAccessConstPosPerm,
+      context.HelperResolveSystemIdtf("argument"));
+  size_t membershipsAmount = 0;
+  while (membershipsIterator->Next())
+    ++membershipsAmount;
+  return membershipsAmount;
+}
+
+TEST_F(PortfolioInferenceTest, OnlyWinnerOutputIsCommitted)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bidirectionalInferenceTest.scs");
+  initialize();
+
+  InferenceConfig inferenceConfig = createInferenceConfig(SEARCH_IN_STRUCTURES);
+  inferenceConfig.portfolioStrategies = {STRATEGY_TARGET, STRATEGY_BEST_FIRST, STRATEGY_BIDIRECTIONAL};
+  DirectInferenceManagerPortfolio inferenceManager(&context, inferenceConfig);
+  InferenceParams const inferenceParams = createInferenceParams(context);
+  EXPECT_TRUE(inferenceManager.applyInference(inferenceParams));
+  EXPECT_LT(inferenceManager.getWinnerIndex(), 3u);
+
+  // Every strategy has generated the derivation, but constructions of strategies which have lost are erased
+  for (char const * derivedClass : {"class_1", "class_5", "class_10"})
+    EXPECT_EQ(countMemberships(context, derivedClass), 1u);
+  EXPECT_TRUE(context.HelperCheckEdge(
+      inferenceParams.outputStructure, context.HelperFindBySystemIdtf("argument"), ScType::EdgeAccessConstPosPerm));
+}
+
+TEST_F(PortfolioInferenceTest, ScratchElementsAreErasedIfTargetIsNotAchieved)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bidirectionalInferenceTest.scs");
+  initialize();
+
+  // Inference of all formulas searches in input structures only, so only the first step of the derivation is found
+  InferenceConfig inferenceConfig = createInferenceConfig(SEARCH_IN_STRUCTURES);
+  inferenceConfig.portfolioStrategies = {STRATEGY_ALL};
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerPortfolio(&context, inferenceConfig);
+  InferenceParams const inferenceParams = createInferenceParams(context);
+  EXPECT_FALSE(inferenceManager->applyInference(inferenceParams));
+
+  EXPECT_EQ(countMemberships(context, "class_1"), 0u);
+  EXPECT_EQ(countMemberships(context, "class_0"), 1u);
+  EXPECT_FALSE(context.Iterator3(inferenceParams.outputStructure, ScType::EdgeAccessConstPosPerm, ScType::Unknown)
+                   ->Next());
+}
+
+TEST_F(PortfolioInferenceTest, CancelledPortfolioRunsNextInference)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bidirectionalInferenceTest.scs");
+  initialize();
+
+  InferenceConfig inferenceConfig = createInferenceConfig(SEARCH_IN_STRUCTURES);
+  inferenceConfig.portfolioStrategies = {STRATEGY_TARGET};
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructInferenceManager(&context, STRATEGY_PORTFOLIO, inferenceConfig);
+  inferenceManager->cancel();
+  InferenceParams const inferenceParams = createInferenceParams(context);
+  EXPECT_TRUE(inferenceManager->applyInference(inferenceParams));
+
+  for (char const * derivedClass : {"class_1", "class_5", "class_10"})
+    EXPECT_EQ(countMemberships(context, derivedClass), 1u);
+}
+
+TEST_F(PortfolioInferenceTest, StrategiesSearchInAllKnowledgeBase)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "bidirectionalInferenceTest.scs");
+  initialize();
+
+  // Facts are found without input structures only if strategies search in all knowledge base
+  InferenceConfig inferenceConfig = createInferenceConfig(SEARCH_IN_ALL_KB);
+  inferenceConfig.portfolioStrategies = {STRATEGY_TARGET};
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerPortfolio(&context, inferenceConfig);
+  InferenceParams inferenceParams = createInferenceParams(context);
+  inferenceParams.inputStructures.clear();
+  EXPECT_TRUE(inferenceManager->applyInference(inferenceParams));
+  EXPECT_EQ(countMemberships(context, "class_10"), 1u);
+  EXPECT_GT(inferenceManager->getProfile().formulasUsesAmount, 0u);
+
+  // Uses of formulas are counted by every inference anew, the target is achieved before the next inference
+  EXPECT_FALSE(inferenceManager->applyInference(inferenceParams));
+  EXPECT_EQ(inferenceManager->getProfile().formulasUsesAmount, 0u);
+}
+
+}  // namespace portfolioInferenceTest
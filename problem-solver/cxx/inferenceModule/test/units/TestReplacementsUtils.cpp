@@ -0,0 +1,302 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_test.hpp"
+
+#include "utils/ReplacementsUtils.hpp"
+#include "utils/EncodedColumn.hpp"
+#include "utils/MonotonicArena.hpp"
+#include "utils/ReplacementsJoin.hpp"
+#include "utils/ReplacementsUnion.hpp"
+
+using namespace inference;
+
+namespace replacementsUtilsTest
+{
+using ReplacementsUtilsTest = ScMemoryTest;
+
+TEST_F(ReplacementsUtilsTest, UniteWithSameVariablesSkipsDuplicates)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  ScAddr const & first = context.CreateNode(ScType::NodeConst);
+  ScAddr const & second = context.CreateNode(ScType::NodeConst);
+  ScAddr const & third = context.CreateNode(ScType::NodeConst);
+
+  Replacements const left{{"_x", {first, second}}};
+  Replacements const right{{"_x", {second, third, third}}};
+
+  Replacements const result = ReplacementsUtils::uniteReplacements(left, right);
+
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_EQ(ReplacementsUtils::getColumnsAmount(result), 3u);
+  ScAddrVector const expected{first, second, third};
+  EXPECT_TRUE(result.at("_x") == expected);
+}
+
+TEST_F(ReplacementsUtilsTest, UniteWithDifferentVariablesPadsMissingVariables)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  ScAddr const & first = context.CreateNode(ScType::NodeConst);
+  ScAddr const & second = context.CreateNode(ScType::NodeConst);
+
+  Replacements const left{{"_x", {first}}};
+  Replacements const right{{"_x", {first}}, {"_y", {second}}};
+
+  Replacements const result = ReplacementsUtils::uniteReplacements(left, right);
+
+  // Columns are not crossed: one column from each operand, the first one is padded for `_y`
+  EXPECT_EQ(ReplacementsUtils::getColumnsAmount(result), 2u);
+  EXPECT_TRUE(result.at("_x")[0] == first);
+  EXPECT_FALSE(result.at("_y")[0].IsValid());
+  EXPECT_TRUE(result.at("_x")[1] == first);
+  EXPECT_TRUE(result.at("_y")[1] == second);
+
+  // Padded variable is not added to template params
+  std::vector<ScTemplateParams> const params = ReplacementsUtils::getReplacementsToScTemplateParams(result);
+  EXPECT_EQ(params.size(), 2u);
+  ScAddr replacement;
+  EXPECT_FALSE(params[0].Get("_y", replacement));
+  EXPECT_TRUE(params[1].Get("_y", replacement));
+}
+
+TEST_F(ReplacementsUtilsTest, UniteStreamsOperands)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  ScAddr const & first = context.CreateNode(ScType::NodeConst);
+  ScAddr const & second = context.CreateNode(ScType::NodeConst);
+
+  ReplacementsUnion replacementsUnion;
+  replacementsUnion.add({});
+  replacementsUnion.add({{"_x", {first}}});
+  replacementsUnion.add({{"_y", {second}}});
+  replacementsUnion.add({{"_x", {first}}});
+
+  EXPECT_EQ(replacementsUnion.getColumnsAmount(), 2u);
+  Replacements const result = replacementsUnion.getReplacements();
+  EXPECT_EQ(result.size(), 2u);
+  EXPECT_FALSE(result.at("_x")[1].IsValid());
+  EXPECT_TRUE(result.at("_y")[1] == second);
+}
+
+TEST_F(ReplacementsUtilsTest, IntersectWithPaddedVariable)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  ScAddr const & first = context.CreateNode(ScType::NodeConst);
+  ScAddr const & second = context.CreateNode(ScType::NodeConst);
+
+  Replacements const padded{{"_x", {first}}, {"_y", {ScAddr()}}};
+  Replacements const other{{"_y", {second}}};
+
+  Replacements const result = ReplacementsUtils::intersectReplacements(padded, other);
+
+  EXPECT_EQ(ReplacementsUtils::getColumnsAmount(result), 1u);
+  EXPECT_TRUE(result.at("_x")[0] == first);
+  EXPECT_TRUE(result.at("_y")[0] == second);
+}
+
+TEST_F(ReplacementsUtilsTest, IntersectKeepsOrderOfColumns)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  ScAddr const & first = context.CreateNode(ScType::NodeConst);
+  ScAddr const & second = context.CreateNode(ScType::NodeConst);
+  ScAddr const & third = context.CreateNode(ScType::NodeConst);
+
+  Replacements const left{{"_x", {first, second, first}}, {"_y", {first, second, third}}};
+  Replacements const right{{"_x", {second, first, first, third}}, {"_z", {first, second, third, first}}};
+
+  Replacements const result = ReplacementsUtils::intersectReplacements(left, right);
+
+  EXPECT_EQ(result.size(), 3u);
+  ScAddrVector const expectedX{first, first, second, first, first};
+  ScAddrVector const expectedY{first, first, second, third, third};
+  ScAddrVector const expectedZ{second, third, first, second, third};
+  EXPECT_TRUE(result.at("_x") == expectedX);
+  EXPECT_TRUE(result.at("_y") == expectedY);
+  EXPECT_TRUE(result.at("_z") == expectedZ);
+}
+
+TEST_F(ReplacementsUtilsTest, IntersectWithoutCommonVariablesIsCrossProduct)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  ScAddr const & first = context.CreateNode(ScType::NodeConst);
+  ScAddr const & second = context.CreateNode(ScType::NodeConst);
+
+  Replacements const left{{"_x", {first, second}}};
+  Replacements const right{{"_y", {first, second}}};
+
+  Replacements const result = ReplacementsUtils::intersectReplacements(left, right);
+
+  EXPECT_EQ(ReplacementsUtils::getColumnsAmount(result), 4u);
+  ScAddrVector const expectedX{first, first, second, second};
+  ScAddrVector const expectedY{first, second, first, second};
+  EXPECT_TRUE(result.at("_x") == expectedX);
+  EXPECT_TRUE(result.at("_y") == expectedY);
+}
+
+TEST_F(ReplacementsUtilsTest, ParallelIntersectIsSameAsSerial)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  size_t const nodesAmount = 16;
+  size_t const columnsAmount = 200;
+  ScAddrVector nodes;
+  for (size_t nodeIndex = 0; nodeIndex < nodesAmount; ++nodeIndex)
+    nodes.push_back(context.CreateNode(ScType::NodeConst));
+
+  Replacements left;
+  Replacements right;
+  for (size_t columnIndex = 0; columnIndex < columnsAmount; ++columnIndex)
+  {
+    left["_x"].push_back(nodes[columnIndex % nodesAmount]);
+    left["_y"].push_back(nodes[(columnIndex / nodesAmount) % nodesAmount]);
+    right["_x"].push_back(nodes[(columnIndex * 7) % nodesAmount]);
+    right["_z"].push_back(nodes[(columnIndex * 3) % nodesAmount]);
+  }
+
+  JoinConfig serialConfig;
+  Replacements const serialResult = ReplacementsJoin(left, right, serialConfig).getReplacements();
+
+  JoinConfig parallelConfig;
+  parallelConfig.threadsAmount = 4;
+  parallelConfig.parallelThreshold = columnsAmount;
+  Replacements const parallelResult = ReplacementsJoin(left, right, parallelConfig).getReplacements();
+
+  EXPECT_GT(ReplacementsUtils::getColumnsAmount(serialResult), 0u);
+  EXPECT_TRUE(serialResult == parallelResult);
+
+  parallelConfig.deterministic = false;
+  Replacements const unorderedResult = ReplacementsJoin(left, right, parallelConfig).getReplacements();
+  EXPECT_EQ(
+      ReplacementsUtils::getColumnsAmount(unorderedResult), ReplacementsUtils::getColumnsAmount(serialResult));
+}
+
+TEST_F(ReplacementsUtilsTest, SpilledIntersectIsSameAsInMemory)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  size_t const nodesAmount = 16;
+  size_t const columnsAmount = 200;
+  ScAddrVector nodes;
+  for (size_t nodeIndex = 0; nodeIndex < nodesAmount; ++nodeIndex)
+    nodes.push_back(context.CreateNode(ScType::NodeConst));
+
+  Replacements left;
+  Replacements right;
+  for (size_t columnIndex = 0; columnIndex < columnsAmount; ++columnIndex)
+  {
+    left["_x"].push_back(nodes[columnIndex % nodesAmount]);
+    left["_y"].push_back(nodes[(columnIndex / nodesAmount) % nodesAmount]);
+    right["_x"].push_back(nodes[(columnIndex * 5) % nodesAmount]);
+    right["_y"].push_back(nodes[(columnIndex * 3) % nodesAmount]);
+  }
+
+  JoinConfig inMemoryConfig;
+  Replacements const inMemoryResult = ReplacementsJoin(left, right, inMemoryConfig).getReplacements();
+
+  JoinConfig spilledConfig;
+  spilledConfig.memoryThreshold = 1024;
+  Replacements const spilledResult = ReplacementsJoin(left, right, spilledConfig).getReplacements();
+
+  EXPECT_GT(ReplacementsUtils::getColumnsAmount(inMemoryResult), 0u);
+  EXPECT_TRUE(inMemoryResult == spilledResult);
+
+  // Partitions still exceed the threshold, so they are partitioned again
+  spilledConfig.memoryThreshold = 64;
+  Replacements const repartitionedResult = ReplacementsJoin(left, right, spilledConfig).getReplacements();
+  EXPECT_TRUE(inMemoryResult == repartitionedResult);
+}
+
+TEST_F(ReplacementsUtilsTest, EncodingIsSelectedByReplacements)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  size_t const replacementsAmount = 100;
+  ScAddrVector nodes;
+  for (size_t nodeIndex = 0; nodeIndex < replacementsAmount; ++nodeIndex)
+    nodes.push_back(context.CreateNode(ScType::NodeConst));
+
+  Replacements replacements;
+  for (size_t index = 0; index < replacementsAmount; ++index)
+  {
+    replacements["_constant"].push_back(nodes[0]);
+    replacements["_runs"].push_back(nodes[index / 25]);
+    replacements["_dictionary"].push_back(nodes[index % 3]);
+    replacements["_plain"].push_back(nodes[index]);
+  }
+
+  std::map<std::string, EncodedColumn> encoded;
+  for (auto const & pair : replacements)
+    encoded.emplace(pair.first, EncodedColumn(pair.second));
+  EXPECT_EQ(encoded.at("_constant").getEncoding(), COLUMN_CONSTANT);
+  EXPECT_EQ(encoded.at("_runs").getEncoding(), COLUMN_RUN_LENGTH);
+  EXPECT_EQ(encoded.at("_dictionary").getEncoding(), COLUMN_DICTIONARY);
+  EXPECT_EQ(encoded.at("_plain").getEncoding(), COLUMN_PLAIN);
+  EXPECT_LT(encoded.at("_runs").getBytesSize(), replacementsAmount * sizeof(ScAddr));
+  EXPECT_EQ(&encoded.at("_plain").getValues(), &replacements.at("_plain"));
+
+  for (auto const & pair : replacements)
+  {
+    for (size_t index = 0; index < replacementsAmount; ++index)
+      EXPECT_TRUE(encoded.at(pair.first).get(index) == pair.second[index]);
+  }
+}
+
+TEST_F(ReplacementsUtilsTest, IntersectWithConstantCommonVariable)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  ScAddr const & constant = context.CreateNode(ScType::NodeConst);
+  ScAddr const & other = context.CreateNode(ScType::NodeConst);
+  ScAddr const & first = context.CreateNode(ScType::NodeConst);
+  ScAddr const & second = context.CreateNode(ScType::NodeConst);
+
+  Replacements const left{{"_class", {constant, constant}}, {"_x", {first, second}}};
+  Replacements const right{{"_class", {constant, constant}}, {"_x", {second, first}}};
+
+  Replacements const result = ReplacementsUtils::intersectReplacements(left, right);
+  EXPECT_EQ(ReplacementsUtils::getColumnsAmount(result), 2u);
+  ScAddrVector const expectedClass{constant, constant};
+  ScAddrVector const expectedX{first, second};
+  EXPECT_TRUE(result.at("_class") == expectedClass);
+  EXPECT_TRUE(result.at("_x") == expectedX);
+
+  Replacements const otherRight{{"_class", {other, other}}, {"_x", {first, second}}};
+  EXPECT_TRUE(ReplacementsUtils::intersectReplacements(left, otherRight).empty());
+}
+
+TEST_F(ReplacementsUtilsTest, UnionAllocatesInArenaScope)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  ScAddr const & first = context.CreateNode(ScType::NodeConst);
+  ScAddr const & second = context.CreateNode(ScType::NodeConst);
+
+  MonotonicArena arena(1024);
+  Replacements result;
+  {
+    MonotonicArena::Scope const arenaScope(arena);
+    EXPECT_EQ(MonotonicArena::getCurrent(), &arena);
+
+    ReplacementsUnion replacementsUnion;
+    replacementsUnion.add({{"_x", {first, second}}});
+    replacementsUnion.add({{"_x", {second}}, {"_y", {first}}});
+    result = replacementsUnion.getReplacements();
+  }
+  EXPECT_EQ(MonotonicArena::getCurrent(), nullptr);
+
+  EXPECT_GT(arena.getAllocationsAmount(), 0u);
+  EXPECT_GE(arena.getPeakSize(), arena.getBytesAllocated());
+  EXPECT_EQ(ReplacementsUtils::getColumnsAmount(result), 3u);
+  EXPECT_TRUE(result.at("_y")[2] == first);
+}
+
+}  // namespace replacementsUtilsTest
@@ -0,0 +1,79 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <thread>
+
+#include "sc_test.hpp"
+
+#include "utils/ScMemoryContextPool.hpp"
+
+using namespace inference;
+
+namespace scMemoryContextPoolTest
+{
+using ScMemoryContextPoolTest = ScMemoryTest;
+
+TEST_F(ScMemoryContextPoolTest, LeasesHaveDifferentContexts)
+{
+  ScMemoryContextPool pool(2);
+  EXPECT_EQ(pool.getSize(), 2u);
+  {
+    ScMemoryContextPool::Lease const firstLease = pool.checkout();
+    ScMemoryContextPool::Lease const secondLease = pool.checkout();
+    EXPECT_NE(firstLease.getContext(), secondLease.getContext());
+    EXPECT_NE(&firstLease.getCaches(), &secondLease.getCaches());
+    EXPECT_TRUE(firstLease.getContext()->IsValid());
+
+    ScAddr const & node = firstLease.getContext()->CreateNode(ScType::NodeConst);
+    EXPECT_TRUE(secondLease.getContext()->IsElement(node));
+  }
+
+  EXPECT_EQ(pool.getCheckoutsAmount(), 2u);
+  EXPECT_EQ(pool.getPeakInUse(), 2u);
+  EXPECT_EQ(pool.getWaitsAmount(), 0u);
+  EXPECT_GE(pool.getUtilization(), 0.0);
+  EXPECT_LE(pool.getUtilization(), 1.0);
+}
+
+TEST_F(ScMemoryContextPoolTest, CheckoutWaitsForReturnedContext)
+{
+  ScMemoryContextPool pool(1);
+  std::unique_ptr<ScMemoryContextPool::Lease> lease =
+      std::make_unique<ScMemoryContextPool::Lease>(pool.checkout());
+  ScMemoryContext * context = lease->getContext();
+
+  std::thread worker([&pool, context]() {
+    ScMemoryContextPool::Lease const workerLease = pool.checkout();
+    EXPECT_EQ(workerLease.getContext(), context);
+  });
+  while (pool.getWaitsAmount() == 0)
+    std::this_thread::yield();
+  lease.reset();
+  worker.join();
+
+  EXPECT_EQ(pool.getCheckoutsAmount(), 2u);
+  EXPECT_EQ(pool.getWaitsAmount(), 1u);
+}
+
+TEST_F(ScMemoryContextPoolTest, ResizeKeepsCheckedOutContexts)
+{
+  ScMemoryContextPool pool(3);
+  {
+    ScMemoryContextPool::Lease const lease = pool.checkout();
+    lease.getCaches().templatesWithLinks[lease.getContext()->CreateNode(ScType::NodeConst)] = true;
+
+    pool.resize(1);
+    EXPECT_EQ(pool.getSize(), 1u);
+    EXPECT_FALSE(lease.getCaches().templatesWithLinks.empty());
+  }
+
+  ScMemoryContextPool::Lease const lease = pool.checkout();
+  pool.resize(2);
+  ScMemoryContextPool::Lease const otherLease = pool.checkout();
+  EXPECT_NE(lease.getContext(), otherLease.getContext());
+}
+
+}  // namespace scMemoryContextPoolTest
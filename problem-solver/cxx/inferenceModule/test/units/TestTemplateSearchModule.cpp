@@ -10,6 +10,7 @@
 
 #include "searcher/templateSearcher/TemplateSearcherGeneral.hpp"
 #include "keynodes/InferenceKeynodes.hpp"
+#include "utils/NumericLinksIndex.hpp"
 #include "utils/ReplacementsUtils.hpp"
 
 #include <algorithm>
@@ -40,7 +41,7 @@ TEST_F(TemplateSearchManagerTest, SearchWithContent_NoStructuresTestCase)
   ScTemplateParams templateParams;
 
   Replacements searchResults;
-  std::set<std::string> varNames;
+  VarNames varNames;
   templateSearcher.getVarNames(searchTemplateAddr, varNames);
   templateSearcher.searchTemplate(searchTemplateAddr, templateParams, varNames, searchResults);
 
@@ -59,7 +60,7 @@ TEST_F(TemplateSearchManagerTest, SearchWithContent_EmptyResultsTestCase)
   ScTemplateParams templateParams;
 
   Replacements searchResults;
-  std::set<std::string> varNames;
+  VarNames varNames;
   templateSearcher.getVarNames(searchTemplateAddr, varNames);
   templateSearcher.searchTemplate(searchTemplateAddr, templateParams, varNames, searchResults);
 
@@ -82,7 +83,7 @@ TEST_F(TemplateSearchManagerTest, SearchWithContent_SingleResultTestCase)
   inference::TemplateSearcherGeneral templateSearcher(&context);
   ScTemplateParams templateParams;
   Replacements searchResults;
-  std::set<std::string> varNames;
+  VarNames varNames;
   templateSearcher.getVarNames(searchTemplateAddr, varNames);
   templateSearcher.searchTemplate(searchTemplateAddr, templateParams, varNames, searchResults);
 
@@ -103,7 +104,7 @@ TEST_F(TemplateSearchManagerTest, SearchWithoutContent_NoStructuresTestCase)
   ScTemplateParams templateParams;
 
   Replacements searchResults;
-  std::set<std::string> varNames;
+  VarNames varNames;
   templateSearcher.getVarNames(searchTemplateAddr, varNames);
   templateSearcher.searchTemplate(searchTemplateAddr, templateParams, varNames, searchResults);
 
@@ -126,7 +127,7 @@ TEST_F(TemplateSearchManagerTest, SearchWithoutContent_SingleResultTestCase)
   inference::TemplateSearcherGeneral templateSearcher(&context);
   ScTemplateParams templateParams;
   Replacements searchResults;
-  std::set<std::string> varNames;
+  VarNames varNames;
   templateSearcher.getVarNames(searchTemplateAddr, varNames);
   templateSearcher.searchTemplate(searchTemplateAddr, templateParams, varNames, searchResults);
 
@@ -149,7 +150,7 @@ TEST_F(TemplateSearchManagerTest, SearchWithoutContent_EmptyLinkTestCase)
   inference::TemplateSearcherGeneral templateSearcher(&context);
   ScTemplateParams templateParams;
   Replacements searchResults;
-  std::set<std::string> varNames;
+  VarNames varNames;
   templateSearcher.getVarNames(searchTemplateAddr, varNames);
   templateSearcher.searchTemplate(searchTemplateAddr, templateParams, varNames, searchResults);
 
@@ -171,11 +172,171 @@ TEST_F(TemplateSearchManagerTest, SearchWithContent_EmptyLinkTestCase)
   inference::TemplateSearcherGeneral templateSearcher(&context);
   ScTemplateParams templateParams;
   Replacements searchResults;
-  std::set<std::string> varNames;
+  VarNames varNames;
   templateSearcher.getVarNames(searchTemplateAddr, varNames);
   templateSearcher.searchTemplate(searchTemplateAddr, templateParams, varNames, searchResults);
 
   EXPECT_EQ(searchResults.size(), 1u);
   EXPECT_EQ(searchResults.at(searchLinkIdentifier)[0], context.HelperFindBySystemIdtf(correctResultLinkIdentifier));
 }
+
+TEST_F(TemplateSearchManagerTest, SearchWithContent_MultipleResultTestCase)
+{
+  std::string searchLinkIdentifier = "search_link";
+
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "searchWithContentMultipleResultTestStucture.scs");
+  initialize();
+
+  ScAddr searchTemplateAddr = context.HelperFindBySystemIdtf(TEST_SEARCH_TEMPLATE_ID);
+  inference::TemplateSearcherGeneral templateSearcher(&context);
+  ScTemplateParams templateParams;
+  Replacements searchResults;
+  VarNames varNames;
+  templateSearcher.getVarNames(searchTemplateAddr, varNames);
+  templateSearcher.searchTemplate(searchTemplateAddr, templateParams, varNames, searchResults);
+
+  ScAddrVector const & foundLinks = searchResults.at(searchLinkIdentifier);
+  EXPECT_EQ(foundLinks.size(), 2u);
+  EXPECT_NE(
+      std::find(foundLinks.cbegin(), foundLinks.cend(), context.HelperFindBySystemIdtf("first_correct_result_link")),
+      foundLinks.cend());
+  EXPECT_NE(
+      std::find(foundLinks.cbegin(), foundLinks.cend(), context.HelperFindBySystemIdtf("second_correct_result_link")),
+      foundLinks.cend());
+}
+
+TEST_F(TemplateSearchManagerTest, SearchWithContent_LinkCreatedAfterSearchTestCase)
+{
+  std::string searchLinkIdentifier = "search_link";
+
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "searchWithContentEmptyResultsTestStucture.scs");
+  initialize();
+
+  ScAddr searchTemplateAddr = context.HelperFindBySystemIdtf(TEST_SEARCH_TEMPLATE_ID);
+  inference::TemplateSearcherGeneral templateSearcher(&context);
+  ScTemplateParams templateParams;
+  Replacements searchResults;
+  VarNames varNames;
+  templateSearcher.getVarNames(searchTemplateAddr, varNames);
+  templateSearcher.searchTemplate(searchTemplateAddr, templateParams, varNames, searchResults);
+  EXPECT_TRUE(searchResults.empty());
+
+  // Content which was not found before is searched in the content index again
+  ScAddr const & node = context.CreateNode(ScType::NodeConst);
+  context.CreateEdge(ScType::EdgeAccessConstPosPerm, context.HelperFindBySystemIdtf("test_class"), node);
+  ScAddr const & link = context.CreateLink();
+  context.SetLinkContent(link, std::string("text"));
+  context.CreateEdge(ScType::EdgeAccessConstPosPerm, node, link);
+
+  templateSearcher.searchTemplate(searchTemplateAddr, templateParams, varNames, searchResults);
+  EXPECT_EQ(searchResults.size(), 2u);
+  EXPECT_EQ(searchResults.at(searchLinkIdentifier)[0], link);
+}
+
+TEST_F(TemplateSearchManagerTest, SearchWithParamsRows_RowsWithoutResultsTestCase)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "searchWithParamsRowsTestStucture.scs");
+  initialize();
+
+  ScAddr searchTemplateAddr = context.HelperFindBySystemIdtf(TEST_SEARCH_TEMPLATE_ID);
+  inference::TemplateSearcherGeneral templateSearcher(&context);
+  ScAddr const firstClass = context.HelperFindBySystemIdtf("first_class");
+  ScAddr const thirdClass = context.HelperFindBySystemIdtf("third_class");
+  std::vector<ScTemplateParams> templateParamsVector;
+  for (ScAddr const & classAddr : {firstClass, context.HelperFindBySystemIdtf("second_class"), thirdClass})
+  {
+    ScTemplateParams templateParams;
+    templateParams.Add("_class", classAddr);
+    templateParamsVector.push_back(templateParams);
+  }
+
+  Replacements searchResults;
+  VarNames varNames;
+  templateSearcher.getVarNames(searchTemplateAddr, varNames);
+  templateSearcher.searchTemplate(searchTemplateAddr, templateParamsVector, varNames, searchResults);
+
+  // The row of second_class has no results, so its param is not added and replacements stay aligned
+  ScAddrVector const expectedClasses{firstClass, thirdClass};
+  ScAddrVector const expectedElements{
+      context.HelperFindBySystemIdtf("first_element"), context.HelperFindBySystemIdtf("third_element")};
+  EXPECT_TRUE(searchResults.at("_class") == expectedClasses);
+  EXPECT_TRUE(searchResults.at("_element") == expectedElements);
+}
+
+TEST_F(TemplateSearchManagerTest, SearchWithContent_GreaterComparisonTestCase)
+{
+  std::string searchLinkIdentifier = "search_link";
+
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "searchWithComparisonTestStucture.scs");
+  initialize();
+
+  ScAddr searchTemplateAddr = context.HelperFindBySystemIdtf(TEST_SEARCH_TEMPLATE_ID);
+  inference::TemplateSearcherGeneral templateSearcher(&context);
+  ScTemplateParams templateParams;
+  Replacements searchResults;
+  VarNames varNames;
+  templateSearcher.getVarNames(searchTemplateAddr, varNames);
+  templateSearcher.searchTemplate(searchTemplateAddr, templateParams, varNames, searchResults);
+
+  EXPECT_EQ(searchResults.at(searchLinkIdentifier), ScAddrVector({context.HelperFindBySystemIdtf("old_link")}));
+}
+
+TEST_F(TemplateSearchManagerTest, SearchWithContent_RangeComparisonTestCase)
+{
+  std::string rangeLinkIdentifier = "range_link";
+
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "searchWithComparisonTestStucture.scs");
+  initialize();
+
+  ScAddr searchTemplateAddr = context.HelperFindBySystemIdtf("range_template");
+  inference::TemplateSearcherGeneral templateSearcher(&context);
+  ScTemplateParams templateParams;
+  Replacements searchResults;
+  VarNames varNames;
+  templateSearcher.getVarNames(searchTemplateAddr, varNames);
+  templateSearcher.searchTemplate(searchTemplateAddr, templateParams, varNames, searchResults);
+
+  ScAddrVector const & foundLinks = searchResults.at(rangeLinkIdentifier);
+  EXPECT_EQ(foundLinks.size(), 2u);
+  EXPECT_NE(
+      std::find(foundLinks.cbegin(), foundLinks.cend(), context.HelperFindBySystemIdtf("old_link")), foundLinks.cend());
+  EXPECT_NE(
+      std::find(foundLinks.cbegin(), foundLinks.cend(), context.HelperFindBySystemIdtf("exact_link")),
+      foundLinks.cend());
+}
+
+TEST_F(TemplateSearchManagerTest, NumericLinksIndexRangeScan)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  inference::NumericLinksIndex index;
+  ScAddrVector links;
+  for (char const * content : {"42", "-1.5", "7", "text", "7e1", "42"})
+  {
+    links.push_back(context.CreateLink());
+    index.add(links.back(), content);
+  }
+  EXPECT_EQ(index.size(), 5u);
+  EXPECT_FALSE(index.contains(links[3]));
+
+  inference::NumericRange range;
+  range.lowerBound = 7;
+  range.isLowerBoundIncluded = false;
+  EXPECT_EQ(index.findInRange(range), inference::ScAddrUnorderedSet({links[0], links[4], links[5]}));
+
+  ASSERT_TRUE(inference::NumericLinksIndex::parseRange("-2..7", range));
+  EXPECT_EQ(index.findInRange(range), inference::ScAddrUnorderedSet({links[1], links[2]}));
+  EXPECT_FALSE(inference::NumericLinksIndex::parseRange("1..", range));
+}
+
 }  // namespace inferenceTest
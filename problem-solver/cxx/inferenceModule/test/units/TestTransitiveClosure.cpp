@@ -0,0 +1,113 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_test.hpp"
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+#include "sc-agents-common/utils/IteratorUtils.hpp"
+
+#include "classifier/FormulaClassifier.hpp"
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+
+using namespace inference;
+
+namespace transitiveClosureTest
+{
+ScsLoader loader;
+std::string const TEST_FILES_DIR_PATH = TEMPLATE_SEARCH_MODULE_TEST_SRC_PATH "/testStructures/ManagerModule/";
+
+size_t const ELEMENTS_AMOUNT = 5;
+
+using TransitiveClosureTest = ScMemoryTest;
+
+void initialize()
+{
+  InferenceKeynodes::InitGlobal();
+  scAgentsCommon::CoreKeynodes::InitGlobal();
+}
+
+bool isTransitivityRule(ScMemoryContext & context, std::string const & ruleIdentifier)
+{
+  ScAddr const & implication = utils::IteratorUtils::getAnyByOutRelation(
+      &context,
+      context.HelperResolveSystemIdtf(ruleIdentifier),
+      scAgentsCommon::CoreKeynodes::rrel_main_key_sc_element);
+  ScAddr premise;
+  ScAddr conclusion;
+  context.GetEdgeInfo(implication, premise, conclusion);
+  FormulaClassifier::TransitivityRule rule;
+  return FormulaClassifier::isTransitivityRule(&context, premise, conclusion, rule) &&
+         rule.relation == context.HelperResolveSystemIdtf("nrel_before");
+}
+
+bool applyInference(ScMemoryContext & context, ScAddrVector const & inputStructures, ScAddr const & outputStructure)
+{
+  InferenceParams const inferenceParams{
+      context.HelperResolveSystemIdtf("formulas_set"), {}, inputStructures, outputStructure};
+  InferenceConfig const inferenceConfig{
+      GENERATE_UNIQUE_FORMULAS, REPLACEMENTS_ALL, TREE_ONLY_OUTPUT_STRUCTURE, SEARCH_IN_STRUCTURES};
+  std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+      InferenceManagerFactory::constructDirectInferenceManagerAll(&context, inferenceConfig);
+  return inferenceManager->applyInference(inferenceParams);
+}
+
+size_t countPairs(ScMemoryContext & context, std::string const & source, std::string const & target)
+{
+  ScAddr const & relation = context.HelperResolveSystemIdtf("nrel_before");
+  ScIterator5Ptr const pairsIterator = context.Iterator5(
+      context.HelperResolveSystemIdtf(source),
+      ScType::EdgeDCommonConst,
+      context.HelperResolveSystemIdtf(target),
+      ScType::EdgeAccessConstPosPerm,
+      relation);
+  size_t pairsAmount = 0;
+  while (pairsIterator->Next())
+    ++pairsAmount;
+  return pairsAmount;
+}
+
+TEST_F(TransitiveClosureTest, TransitivityRuleIsClassified)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "transitiveClosureTest.scs");
+  initialize();
+
+  EXPECT_TRUE(isTransitivityRule(context, "transitivity_rule"));
+  EXPECT_FALSE(isTransitivityRule(context, "inversion_rule"));
+}
+
+TEST_F(TransitiveClosureTest, ClosureIsGeneratedByOneUseOfRule)
+{
+  ScMemoryContext & context = *m_ctx;
+
+  loader.loadScsFile(context, TEST_FILES_DIR_PATH + "transitiveClosureTest.scs");
+  initialize();
+
+  ScAddr const & inputStructure = context.HelperResolveSystemIdtf("input_structure");
+  ScAddr const & outputStructure = context.CreateNode(ScType::NodeConstStruct);
+  EXPECT_TRUE(applyInference(context, {inputStructure}, outputStructure));
+
+  for (size_t sourceNumber = 1; sourceNumber <= ELEMENTS_AMOUNT; ++sourceNumber)
+  {
+    for (size_t targetNumber = sourceNumber + 1; targetNumber <= ELEMENTS_AMOUNT; ++targetNumber)
+    {
+      EXPECT_EQ(
+          countPairs(context, "element_" + std::to_string(sourceNumber), "element_" + std::to_string(targetNumber)),
+          1u);
+    }
+  }
+  // The pair of element_5 and element_6 is not in the input structure
+  EXPECT_EQ(countPairs(context, "element_1", "element_6"), 0u);
+  EXPECT_EQ(countPairs(context, "element_2", "element_1"), 0u);
+
+  // Every pair of the closure is already generated
+  EXPECT_FALSE(
+      applyInference(context, {inputStructure, outputStructure}, context.CreateNode(ScType::NodeConstStruct)));
+}
+
+}  // namespace transitiveClosureTest
@@ -0,0 +1,123 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <atomic>
+#include <stdexcept>
+
+#include "sc_test.hpp"
+
+#include "utils/MonotonicArena.hpp"
+#include "utils/ReplacementsJoin.hpp"
+#include "utils/WorkStealingScheduler.hpp"
+
+using namespace inference;
+
+namespace workStealingSchedulerTest
+{
+using WorkStealingSchedulerTest = ScMemoryTest;
+
+TEST_F(WorkStealingSchedulerTest, NestedGroupsAreFinishedBeforeWait)
+{
+  WorkStealingScheduler scheduler(3);
+  std::atomic<size_t> partitionsAmount{0};
+  std::vector<size_t> rulesPartitionsAmounts(20);
+  {
+    WorkStealingScheduler::TaskGroup rulesTasks(scheduler);
+    for (size_t ruleIndex = 0; ruleIndex < rulesPartitionsAmounts.size(); ++ruleIndex)
+    {
+      rulesTasks.run([&scheduler, &partitionsAmount, &rulesPartitionsAmounts, ruleIndex]() {
+        std::atomic<size_t> rulePartitionsAmount{0};
+        WorkStealingScheduler::TaskGroup partitionsTasks(scheduler);
+        for (size_t partition = 0; partition < 8; ++partition)
+        {
+          partitionsTasks.run([&partitionsAmount, &rulePartitionsAmount]() {
+            ++partitionsAmount;
+            ++rulePartitionsAmount;
+          });
+        }
+        partitionsTasks.wait();
+        rulesPartitionsAmounts[ruleIndex] = rulePartitionsAmount;
+      });
+    }
+    rulesTasks.wait();
+  }
+
+  EXPECT_EQ(partitionsAmount, 160u);
+  for (size_t rulePartitionsAmount : rulesPartitionsAmounts)
+    EXPECT_EQ(rulePartitionsAmount, 8u);
+  EXPECT_EQ(scheduler.getThreadsAmount(), 3u);
+  EXPECT_EQ(scheduler.getTasksAmount(), 180u);
+}
+
+TEST_F(WorkStealingSchedulerTest, WaitingThreadRunsTasksWithoutWorkers)
+{
+  WorkStealingScheduler scheduler(0);
+  MonotonicArena arena;
+  MonotonicArena::Scope const arenaScope(arena);
+
+  size_t tasksAmount = 0;
+  bool isRunWithArena = false;
+  WorkStealingScheduler::TaskGroup tasks(scheduler);
+  for (size_t taskIndex = 0; taskIndex < 5; ++taskIndex)
+  {
+    tasks.run([&tasksAmount, &isRunWithArena]() {
+      ++tasksAmount;
+      isRunWithArena = isRunWithArena || MonotonicArena::getCurrent() != nullptr;
+    });
+  }
+  tasks.wait();
+
+  EXPECT_EQ(tasksAmount, 5u);
+  EXPECT_FALSE(isRunWithArena);
+  EXPECT_EQ(MonotonicArena::getCurrent(), &arena);
+  EXPECT_EQ(scheduler.getStealsAmount(), 0u);
+}
+
+TEST_F(WorkStealingSchedulerTest, WaitRethrowsExceptionOfTask)
+{
+  WorkStealingScheduler scheduler(2);
+  std::atomic<size_t> tasksAmount{0};
+  WorkStealingScheduler::TaskGroup tasks(scheduler);
+  for (size_t taskIndex = 0; taskIndex < 10; ++taskIndex)
+  {
+    tasks.run([&tasksAmount, taskIndex]() {
+      ++tasksAmount;
+      if (taskIndex == 3)
+        throw std::runtime_error("Task is failed");
+    });
+  }
+
+  EXPECT_THROW(tasks.wait(), std::runtime_error);
+  EXPECT_EQ(tasksAmount, 10u);
+  EXPECT_NO_THROW(tasks.wait());
+}
+
+TEST_F(WorkStealingSchedulerTest, JoinPartitionsAsTasks)
+{
+  Replacements first;
+  Replacements second;
+  for (size_t columnIndex = 0; columnIndex < 200; ++columnIndex)
+  {
+    ScAddr const & node = m_ctx->CreateNode(ScType::NodeConst);
+    first["_x"].push_back(node);
+    first["_y"].push_back(m_ctx->CreateNode(ScType::NodeConst));
+    second["_x"].push_back(node);
+    second["_z"].push_back(m_ctx->CreateNode(ScType::NodeConst));
+  }
+
+  JoinConfig config;
+  config.threadsAmount = 4;
+  config.parallelThreshold = 1;
+  Replacements const serialResult = ReplacementsJoin(first, second, JoinConfig()).getReplacements();
+
+  WorkStealingScheduler scheduler(3);
+  Replacements const result = ReplacementsJoin(first, second, config, &scheduler).getReplacements();
+  EXPECT_EQ(result, serialResult);
+  EXPECT_EQ(result.at("_z").size(), 200u);
+  EXPECT_GE(scheduler.getTasksAmount(), 4u);
+}
+
+}  // namespace workStealingSchedulerTest
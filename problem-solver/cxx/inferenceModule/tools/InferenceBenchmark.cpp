@@ -0,0 +1,78 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "InferenceBenchmark.hpp"
+
+#include <chrono>
+
+#include "sink/InferenceSinkAbstract.hpp"
+
+namespace inference
+{
+namespace
+{
+class InferenceSinkCounter : public InferenceSinkAbstract
+{
+public:
+  void onFiring(InferenceFiring const &) override
+  {
+    ++firingsAmount;
+  }
+
+  size_t firingsAmount = 0;
+};
+}  // namespace
+
+bool InferenceBenchmark::initializeMemory(std::string const & repoPath)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+  params.repo_path = repoPath.c_str();
+  params.clear = SC_TRUE;
+  params.ext_path = nullptr;
+  return ScMemory::Initialize(params);
+}
+
+void InferenceBenchmark::shutdownMemory()
+{
+  ScMemory::Shutdown(false);
+}
+
+InferenceRunResult InferenceBenchmark::runInference(
+    ScMemoryContext * context,
+    InferenceManagerAbstract & inferenceManager,
+    InferenceParams const & inferenceParams)
+{
+  std::shared_ptr<InferenceSinkCounter> const counter = std::make_shared<InferenceSinkCounter>();
+  inferenceManager.addSink(counter);
+
+  InferenceRunResult runResult;
+  uint32_t const elementsAmount = context->CalculateStat().GetAllNum();
+  auto const startTime = std::chrono::steady_clock::now();
+  runResult.isTargetAchieved = inferenceManager.applyInference(inferenceParams);
+  runResult.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  runResult.firingsAmount = counter->firingsAmount;
+  runResult.memoryStat = context->CalculateStat();
+  runResult.createdElementsAmount =
+      static_cast<int64_t>(runResult.memoryStat.GetAllNum()) - static_cast<int64_t>(elementsAmount);
+  runResult.profile = inferenceManager.getProfile();
+  return runResult;
+}
+
+void InferenceBenchmark::printRunResult(std::ostream & stream, size_t runIndex, InferenceRunResult const & runResult)
+{
+  InferenceProfile const & profile = runResult.profile;
+  stream << "run " << runIndex << ": result " << runResult.isTargetAchieved << ", time " << runResult.seconds
+         << " s, firings " << runResult.firingsAmount << ", formulas uses " << profile.formulasUsesAmount
+         << ", skipped formulas " << profile.skippedFormulasAmount << ", template searches "
+         << profile.templateSearchesAmount << ", speculative formulas "
+         << profile.speculativeFormulasAmount << ", reexecuted formulas " << profile.reexecutedFormulasAmount
+         << ", created elements " << runResult.createdElementsAmount << ", nodes " << runResult.memoryStat.m_nodesNum
+         << ", links " << runResult.memoryStat.m_linksNum << ", arcs " << runResult.memoryStat.m_edgesNum
+         << ", arena peak " << profile.arenaPeakSize << " B, contexts peak " << profile.contextsPeakInUse << std::endl;
+}
+
+}  // namespace inference
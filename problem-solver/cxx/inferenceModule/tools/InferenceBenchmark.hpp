@@ -0,0 +1,52 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "sc-memory/sc_memory.hpp"
+
+#include "inferenceConfig/InferenceConfig.hpp"
+#include "inferenceConfig/InferenceProfile.hpp"
+#include "manager/inferenceManager/InferenceManagerAbstract.hpp"
+
+namespace inference
+{
+/// Result of an inference run of a command-line tool
+struct InferenceRunResult
+{
+  bool isTargetAchieved = false;
+  double seconds = 0;
+  size_t firingsAmount = 0;
+  /// Amount of elements in memory after inference
+  ScMemoryContext::Stat memoryStat{};
+  /// Amount of elements created by inference, elements erased by inference are subtracted
+  int64_t createdElementsAmount = 0;
+  InferenceProfile profile;
+};
+
+/// Harness of command-line tools: every run of inference is made in new memory, so runs don't see results of others
+class InferenceBenchmark
+{
+public:
+  /// Initialize new memory in the repo directory, memory is cleared at initialization
+  static bool initializeMemory(std::string const & repoPath);
+
+  static void shutdownMemory();
+
+  /// Apply inference by the manager and measure time of applyInference only
+  static InferenceRunResult runInference(
+      ScMemoryContext * context,
+      InferenceManagerAbstract & inferenceManager,
+      InferenceParams const & inferenceParams);
+
+  static void printRunResult(std::ostream & stream, size_t runIndex, InferenceRunResult const & runResult);
+};
+
+}  // namespace inference
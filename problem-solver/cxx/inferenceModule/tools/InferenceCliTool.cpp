@@ -0,0 +1,236 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+
+#include "InferenceBenchmark.hpp"
+
+using namespace inference;
+
+namespace
+{
+std::string const USAGE =
+    "Usage: inference-cli --repo <path> --scs <file> [--scs <file>...] --formulas <idtf> [options]\n"
+    "  --argument <idtf>        argument of inference, can be repeated\n"
+    "  --input <idtf>           input structure, can be repeated, inference searches in all knowledge base without it\n"
+    "  --target <idtf>          target structure, can be repeated\n"
+    "  --targets any|all        inference is stopped when any or all targets are achieved, any by default\n"
+    "  --manager target|all|best-first|bidirectional|portfolio\n"
+    "                           inference manager, target by default\n"
+    "  --generation unique|all  generate unique formulas or all formulas, unique by default\n"
+    "  --replacements first|all use the first replacement or all replacements, all by default\n"
+    "  --tree full|success|output\n"
+    "                           solution tree type, output by default\n"
+    "  --workers <amount>       amount of workers, 1 by default\n"
+    "  --ordered-commit         commit formulas of concurrent workers in sequential order\n"
+    "  --join-threads <amount>  amount of threads to join replacements in, 1 by default\n"
+    "  --frontier <size>        frontier size of best-first inference, 64 by default\n"
+    "  --runs <amount>          amount of runs, every run is made in new memory, 1 by default\n";
+
+/// Options of the command line, an option is a name starting with `--` and its value
+class CliOptions
+{
+public:
+  /// @throws utils::ExceptionInvalidParams Thrown if an option has no value
+  CliOptions(int argc, char ** argv)
+  {
+    for (int argumentIndex = 1; argumentIndex < argc; ++argumentIndex)
+    {
+      std::string const name = argv[argumentIndex];
+      if (name == "--ordered-commit")
+      {
+        options[name].push_back("true");
+        continue;
+      }
+      if (name.compare(0, 2, "--") != 0 || argumentIndex + 1 == argc)
+        SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Option " << name << " is unknown or has no value.");
+      options[name].push_back(argv[++argumentIndex]);
+    }
+  }
+
+  std::vector<std::string> getValues(std::string const & name) const
+  {
+    auto const & values = options.find(name);
+    return values == options.cend() ? std::vector<std::string>{} : values->second;
+  }
+
+  /// @returns the last value of the option or the default value
+  std::string getValue(std::string const & name, std::string const & defaultValue = "") const
+  {
+    std::vector<std::string> const values = getValues(name);
+    return values.empty() ? defaultValue : values.back();
+  }
+
+  /// @throws utils::ExceptionInvalidParams Thrown if the option is missing
+  std::string getRequiredValue(std::string const & name) const
+  {
+    std::string const value = getValue(name);
+    if (value.empty())
+      SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Option " << name << " is required.");
+    return value;
+  }
+
+  /// @throws utils::ExceptionInvalidParams Thrown if the value of the option is not a number
+  size_t getNumber(std::string const & name, size_t defaultValue) const
+  {
+    std::string const value = getValue(name);
+    if (value.empty())
+      return defaultValue;
+    if (value.find_first_not_of("0123456789") != std::string::npos)
+      SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Option " << name << " has invalid number " << value << ".");
+    try
+    {
+      return std::stoul(value);
+    }
+    catch (std::out_of_range const &)
+    {
+      SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Option " << name << " has invalid number " << value << ".");
+    }
+  }
+
+  /// @throws utils::ExceptionInvalidParams Thrown if the value of the option is not one of the variants
+  template <typename EnumType>
+  EnumType getVariant(
+      std::string const & name,
+      std::map<std::string, EnumType> const & variants,
+      std::string const & defaultVariant) const
+  {
+    std::string const value = getValue(name, defaultVariant);
+    auto const & variant = variants.find(value);
+    if (variant == variants.cend())
+      SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Option " << name << " has unknown value " << value << ".");
+    return variant->second;
+  }
+
+private:
+  std::map<std::string, std::vector<std::string>> options;
+};
+
+InferenceConfig createInferenceConfig(CliOptions const & options, bool isSearchInStructures)
+{
+  InferenceConfig inferenceConfig;
+  inferenceConfig.generationType = options.getVariant<GenerationType>(
+      "--generation", {{"unique", GENERATE_UNIQUE_FORMULAS}, {"all", GENERATE_ALL_FORMULAS}}, "unique");
+  inferenceConfig.replacementsUsingType = options.getVariant<ReplacementsUsingType>(
+      "--replacements", {{"first", REPLACEMENTS_FIRST}, {"all", REPLACEMENTS_ALL}}, "all");
+  inferenceConfig.solutionTreeType = options.getVariant<SolutionTreeType>(
+      "--tree",
+      {{"full", TREE_FULL}, {"success", TREE_ONLY_SUCCESS_BRANCH}, {"output", TREE_ONLY_OUTPUT_STRUCTURE}},
+      "output");
+  inferenceConfig.searchType = isSearchInStructures ? SEARCH_IN_STRUCTURES : SEARCH_IN_ALL_KB;
+  inferenceConfig.workersAmount = options.getNumber("--workers", inferenceConfig.workersAmount);
+  inferenceConfig.orderedCommit = !options.getValue("--ordered-commit").empty();
+  inferenceConfig.joinConfig.threadsAmount =
+      options.getNumber("--join-threads", inferenceConfig.joinConfig.threadsAmount);
+  inferenceConfig.frontierSize = options.getNumber("--frontier", inferenceConfig.frontierSize);
+  return inferenceConfig;
+}
+
+/// @throws utils::ExceptionItemNotFound Thrown if there is no element with the identifier
+ScAddr findElement(ScMemoryContext & context, std::string const & identifier)
+{
+  ScAddr const & element = context.HelperFindBySystemIdtf(identifier);
+  if (!element.IsValid())
+    SC_THROW_EXCEPTION(utils::ExceptionItemNotFound, "Element " << identifier << " is not found.");
+  return element;
+}
+
+ScAddrVector findElements(ScMemoryContext & context, std::vector<std::string> const & identifiers)
+{
+  ScAddrVector elements;
+  for (std::string const & identifier : identifiers)
+    elements.push_back(findElement(context, identifier));
+  return elements;
+}
+
+InferenceParams createInferenceParams(ScMemoryContext & context, CliOptions const & options)
+{
+  InferenceParams inferenceParams;
+  inferenceParams.formulasSet = findElement(context, options.getRequiredValue("--formulas"));
+  inferenceParams.arguments = findElements(context, options.getValues("--argument"));
+  inferenceParams.inputStructures = findElements(context, options.getValues("--input"));
+  inferenceParams.outputStructure = context.CreateNode(ScType::NodeConstStruct);
+  inferenceParams.targetStructures = findElements(context, options.getValues("--target"));
+  inferenceParams.targetsType =
+      options.getVariant<TargetsType>("--targets", {{"any", TARGETS_ANY}, {"all", TARGETS_ALL}}, "any");
+  return inferenceParams;
+}
+
+std::unique_ptr<InferenceManagerAbstract> createInferenceManager(
+    ScMemoryContext & context,
+    CliOptions const & options,
+    InferenceConfig const & inferenceConfig)
+{
+  InferenceStrategy const strategy = options.getVariant<InferenceStrategy>(
+      "--manager",
+      {{"target", STRATEGY_TARGET},
+       {"all", STRATEGY_ALL},
+       {"best-first", STRATEGY_BEST_FIRST},
+       {"bidirectional", STRATEGY_BIDIRECTIONAL},
+       {"portfolio", STRATEGY_PORTFOLIO}},
+      "target");
+  return InferenceManagerFactory::constructInferenceManager(&context, strategy, inferenceConfig);
+}
+
+}  // namespace
+
+/// Run inference with knowledge of scs files, see USAGE
+int main(int argc, char ** argv)
+{
+  try
+  {
+    CliOptions const options(argc, argv);
+    std::string const repoPath = options.getRequiredValue("--repo");
+    std::vector<std::string> const scsFiles = options.getValues("--scs");
+    if (scsFiles.empty())
+      SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Option --scs is required.");
+    InferenceConfig const inferenceConfig = createInferenceConfig(options, !options.getValues("--input").empty());
+    size_t const runsAmount = options.getNumber("--runs", 1);
+
+    for (size_t runIndex = 1; runIndex <= runsAmount; ++runIndex)
+    {
+      if (!InferenceBenchmark::initializeMemory(repoPath))
+      {
+        std::cerr << "Memory can't be initialized in " << repoPath << std::endl;
+        return EXIT_FAILURE;
+      }
+      {
+        ScMemoryContext context(sc_access_lvl_make_min, "inference_cli");
+        ScsLoader loader;
+        for (std::string const & scsFile : scsFiles)
+          loader.loadScsFile(context, scsFile);
+        InferenceKeynodes::InitGlobal();
+        scAgentsCommon::CoreKeynodes::InitGlobal();
+
+        InferenceParams const inferenceParams = createInferenceParams(context, options);
+        std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+            createInferenceManager(context, options, inferenceConfig);
+        InferenceRunResult const runResult =
+            InferenceBenchmark::runInference(&context, *inferenceManager, inferenceParams);
+        InferenceBenchmark::printRunResult(std::cout, runIndex, runResult);
+      }
+      InferenceBenchmark::shutdownMemory();
+    }
+  }
+  catch (std::exception const & exception)
+  {
+    std::cerr << exception.what() << std::endl << USAGE;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
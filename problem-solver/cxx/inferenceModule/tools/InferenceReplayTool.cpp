@@ -0,0 +1,65 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "scs_loader.hpp"
+#include "sc-agents-common/keynodes/coreKeynodes.hpp"
+
+#include "factory/InferenceManagerFactory.hpp"
+#include "keynodes/InferenceKeynodes.hpp"
+#include "recorder/InferenceReplay.hpp"
+
+#include "InferenceBenchmark.hpp"
+
+using namespace inference;
+
+/// Replay inference recorded by InferenceRecorder: `inference-replay <repo path> <bundle directory> [runs amount]`
+int main(int argc, char ** argv)
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: inference-replay <repo path> <bundle directory> [runs amount]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try
+  {
+    InferenceReplay const replay(argv[2]);
+    size_t const runsAmount = argc > 3 ? std::stoul(argv[3]) : 1;
+    for (size_t runIndex = 1; runIndex <= runsAmount; ++runIndex)
+    {
+      if (!InferenceBenchmark::initializeMemory(argv[1]))
+      {
+        std::cerr << "Memory can't be initialized in " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+      }
+      {
+        ScMemoryContext context(sc_access_lvl_make_min, "inference_replay");
+        ScsLoader loader;
+        loader.loadScsFile(context, replay.getBundlePath());
+        InferenceKeynodes::InitGlobal();
+        scAgentsCommon::CoreKeynodes::InitGlobal();
+
+        std::unique_ptr<InferenceManagerAbstract> inferenceManager =
+            InferenceManagerFactory::constructInferenceManager(&context, replay.getStrategy(), replay.getConfig());
+        InferenceRunResult const runResult =
+            InferenceBenchmark::runInference(&context, *inferenceManager, replay.createInferenceParams(&context));
+        InferenceBenchmark::printRunResult(std::cout, runIndex, runResult);
+      }
+      InferenceBenchmark::shutdownMemory();
+    }
+  }
+  catch (std::exception const & exception)
+  {
+    std::cerr << exception.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,15 @@
+set(INFERENCE_TOOLS_INCLUDES ${CMAKE_CURRENT_LIST_DIR} ${SC_MACHINE_ROOT}/sc-tools/sc-builder/src)
+
+add_library(inference-benchmark STATIC
+		${CMAKE_CURRENT_LIST_DIR}/InferenceBenchmark.cpp
+		${CMAKE_CURRENT_LIST_DIR}/InferenceBenchmark.hpp)
+target_include_directories(inference-benchmark PUBLIC ${INFERENCE_TOOLS_INCLUDES})
+target_link_libraries(inference-benchmark inferenceModule)
+
+add_executable(inference-replay ${CMAKE_CURRENT_LIST_DIR}/InferenceReplayTool.cpp)
+target_link_libraries(inference-replay inference-benchmark sc-builder-lib)
+set_target_properties(inference-replay PROPERTIES RUNTIME_OUTPUT_DIRECTORY ${SC_BIN_PATH})
+
+add_executable(inference-cli ${CMAKE_CURRENT_LIST_DIR}/InferenceCliTool.cpp)
+target_link_libraries(inference-cli inference-benchmark sc-builder-lib)
+set_target_properties(inference-cli PROPERTIES RUNTIME_OUTPUT_DIRECTORY ${SC_BIN_PATH})
@@ -0,0 +1,106 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "ClassHierarchy.hpp"
+
+#include <queue>
+
+namespace inference
+{
+namespace
+{
+size_t const BITSET_WORD_SIZE = 64;
+}  // namespace
+
+void ClassHierarchy::addSubclass(ScAddr const & subclass, ScAddr const & superclass)
+{
+  size_t const subclassIndex = addClass(subclass);
+  size_t const superclassIndex = addClass(superclass);
+  directSuperclasses[subclassIndex].push_back(superclassIndex);
+}
+
+void ClassHierarchy::encode()
+{
+  size_t const wordsAmount = (classes.size() + BITSET_WORD_SIZE - 1) / BITSET_WORD_SIZE;
+  superclasses.assign(classes.size(), Bitset(wordsAmount, 0));
+  for (size_t classIndex = 0; classIndex < classes.size(); ++classIndex)
+  {
+    Bitset & classSuperclasses = superclasses[classIndex];
+    std::queue<size_t> classesQueue;
+    classSuperclasses[classIndex / BITSET_WORD_SIZE] |= uint64_t(1) << (classIndex % BITSET_WORD_SIZE);
+    classesQueue.push(classIndex);
+    while (!classesQueue.empty())
+    {
+      size_t const currentClassIndex = classesQueue.front();
+      classesQueue.pop();
+      for (size_t superclassIndex : directSuperclasses[currentClassIndex])
+      {
+        uint64_t & word = classSuperclasses[superclassIndex / BITSET_WORD_SIZE];
+        uint64_t const bit = uint64_t(1) << (superclassIndex % BITSET_WORD_SIZE);
+        if ((word & bit) != 0)
+          continue;
+        word |= bit;
+        classesQueue.push(superclassIndex);
+      }
+    }
+  }
+
+  subclasses.assign(classes.size(), ScAddrVector());
+  for (size_t classIndex = 0; classIndex < classes.size(); ++classIndex)
+  {
+    for (size_t superclassIndex = 0; superclassIndex < classes.size(); ++superclassIndex)
+    {
+      if (isSubclassOf(classIndex, superclassIndex))
+        subclasses[superclassIndex].push_back(classes[classIndex]);
+    }
+  }
+}
+
+bool ClassHierarchy::isSubclassOf(ScAddr const & subclass, ScAddr const & superclass) const
+{
+  auto const & subclassIndex = classesIndices.find(subclass);
+  auto const & superclassIndex = classesIndices.find(superclass);
+  if (subclassIndex == classesIndices.cend() || superclassIndex == classesIndices.cend())
+    return subclass == superclass;
+  return isSubclassOf(subclassIndex->second, superclassIndex->second);
+}
+
+ScAddrVector const & ClassHierarchy::getSubclasses(ScAddr const & superclass) const
+{
+  auto const & superclassIndex = classesIndices.find(superclass);
+  if (superclassIndex == classesIndices.cend())
+    SC_THROW_EXCEPTION(utils::ExceptionItemNotFound, "Class is not in the class hierarchy");
+  return subclasses[superclassIndex->second];
+}
+
+bool ClassHierarchy::contains(ScAddr const & classAddr) const
+{
+  return classesIndices.count(classAddr) > 0;
+}
+
+size_t ClassHierarchy::size() const
+{
+  return classes.size();
+}
+
+size_t ClassHierarchy::addClass(ScAddr const & classAddr)
+{
+  auto const & classIndex = classesIndices.emplace(classAddr, classes.size());
+  if (classIndex.second)
+  {
+    classes.push_back(classAddr);
+    directSuperclasses.emplace_back();
+  }
+  return classIndex.first->second;
+}
+
+bool ClassHierarchy::isSubclassOf(size_t subclassIndex, size_t superclassIndex) const
+{
+  return (superclasses[subclassIndex][superclassIndex / BITSET_WORD_SIZE] >> (superclassIndex % BITSET_WORD_SIZE) &
+          1) != 0;
+}
+
+}  // namespace inference
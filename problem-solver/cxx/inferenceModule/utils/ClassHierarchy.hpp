@@ -0,0 +1,55 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <sc-memory/sc_addr.hpp>
+
+namespace inference
+{
+/**
+ * Subsumption graph of classes. Every class has a bitset of its superclasses (transitive and reflexive), so it is
+ * checked in constant time if a class is a subclass of another one, and a list of its subclasses (transitive and
+ * reflexive). Cycles of classes are allowed, classes of a cycle are subclasses of each other.
+ */
+class ClassHierarchy
+{
+public:
+  void addSubclass(ScAddr const & subclass, ScAddr const & superclass);
+
+  /// Find superclasses and subclasses of every class, it is called after all subclasses are added
+  void encode();
+
+  /// @returns true if `subclass` is `superclass` or its subclass by added pairs
+  bool isSubclassOf(ScAddr const & subclass, ScAddr const & superclass) const;
+
+  /// @returns `superclass` and its subclasses in order of adding
+  /// @throws utils::ExceptionItemNotFound if `superclass` is not in the hierarchy
+  ScAddrVector const & getSubclasses(ScAddr const & superclass) const;
+
+  bool contains(ScAddr const & classAddr) const;
+
+  size_t size() const;
+
+private:
+  using Bitset = std::vector<uint64_t>;
+
+  size_t addClass(ScAddr const & classAddr);
+
+  bool isSubclassOf(size_t subclassIndex, size_t superclassIndex) const;
+
+  ScAddrVector classes;
+  std::unordered_map<ScAddr, size_t, ScAddrHashFunc<::size_t>> classesIndices;
+  std::vector<std::vector<size_t>> directSuperclasses;
+  std::vector<Bitset> superclasses;
+  std::vector<ScAddrVector> subclasses;
+};
+
+}  // namespace inference
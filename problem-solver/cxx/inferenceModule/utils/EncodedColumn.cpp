@@ -0,0 +1,160 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "EncodedColumn.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+#include <unordered_map>
+
+namespace inference
+{
+namespace
+{
+size_t const MAX_DICTIONARY_SIZE = std::numeric_limits<uint16_t>::max() + 1;
+}  // namespace
+
+EncodedColumn::EncodedColumn(ScAddrVector const & replacements)
+  : encoding(selectEncoding(replacements))
+{
+  encode(replacements);
+}
+
+EncodedColumn::EncodedColumn(ScAddrVector const & replacements, ColumnEncoding encoding)
+  : encoding(encoding)
+{
+  encode(replacements);
+}
+
+ColumnEncoding EncodedColumn::selectEncoding(ScAddrVector const & replacements)
+{
+  if (replacements.empty())
+    return COLUMN_PLAIN;
+
+  size_t runsAmount = 1;
+  for (size_t index = 1; index < replacements.size(); ++index)
+  {
+    if (replacements[index] != replacements[index - 1])
+      ++runsAmount;
+  }
+  if (runsAmount == 1)
+    return COLUMN_CONSTANT;
+
+  size_t const plainSize = replacements.size() * sizeof(ScAddr);
+  size_t const runLengthSize = runsAmount * (sizeof(ScAddr) + sizeof(uint32_t));
+  bool const isRunLengthAvailable = replacements.size() <= std::numeric_limits<uint32_t>::max();
+  // Dictionary can't be less than a half of plain column, so distinct values are not counted
+  if (isRunLengthAvailable && runLengthSize * 2 <= plainSize)
+    return COLUMN_RUN_LENGTH;
+
+  std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>> distinctValues;
+  for (ScAddr const & replacement : replacements)
+  {
+    distinctValues.insert(replacement);
+    if (distinctValues.size() > MAX_DICTIONARY_SIZE)
+      break;
+  }
+
+  size_t const dictionarySize = distinctValues.size() <= MAX_DICTIONARY_SIZE
+                                    ? distinctValues.size() * sizeof(ScAddr) + replacements.size() * sizeof(uint16_t)
+                                    : plainSize;
+  if (isRunLengthAvailable && runLengthSize < plainSize && runLengthSize <= dictionarySize)
+    return COLUMN_RUN_LENGTH;
+  if (dictionarySize < plainSize)
+    return COLUMN_DICTIONARY;
+  return COLUMN_PLAIN;
+}
+
+ColumnEncoding EncodedColumn::getEncoding() const
+{
+  return encoding;
+}
+
+size_t EncodedColumn::size() const
+{
+  return replacementsAmount;
+}
+
+ScAddr EncodedColumn::get(size_t index) const
+{
+  switch (encoding)
+  {
+  case COLUMN_CONSTANT:
+    return values[0];
+  case COLUMN_RUN_LENGTH:
+    return values[std::upper_bound(runEnds.cbegin(), runEnds.cend(), index) - runEnds.cbegin()];
+  case COLUMN_DICTIONARY:
+    return values[codes[index]];
+  case COLUMN_PLAIN:
+    break;
+  }
+  return getValues()[index];
+}
+
+ScAddrVector const & EncodedColumn::getValues() const
+{
+  return plainValues != nullptr ? *plainValues : values;
+}
+
+size_t EncodedColumn::getBytesSize() const
+{
+  return getValues().size() * sizeof(ScAddr) + runEnds.size() * sizeof(uint32_t) + codes.size() * sizeof(uint16_t);
+}
+
+void EncodedColumn::encode(ScAddrVector const & replacements)
+{
+  replacementsAmount = replacements.size();
+  switch (encoding)
+  {
+  case COLUMN_CONSTANT:
+    if (replacements.empty() ||
+        std::find_if(replacements.cbegin(), replacements.cend(), [&replacements](ScAddr const & replacement) {
+          return replacement != replacements[0];
+        }) != replacements.cend())
+      SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Replacements are not constant");
+    values.push_back(replacements[0]);
+    break;
+  case COLUMN_RUN_LENGTH:
+    for (size_t index = 0; index < replacements.size(); ++index)
+    {
+      if (index == 0 || replacements[index] != values.back())
+      {
+        if (index != 0)
+          runEnds.push_back(index);
+        values.push_back(replacements[index]);
+      }
+    }
+    if (!replacements.empty())
+      runEnds.push_back(replacements.size());
+    break;
+  case COLUMN_DICTIONARY:
+  {
+    std::unordered_map<ScAddr, uint16_t, ScAddrHashFunc<::size_t>> valueCodes;
+    codes.reserve(replacements.size());
+    for (ScAddr const & replacement : replacements)
+    {
+      auto const & valueCode = valueCodes.find(replacement);
+      if (valueCode != valueCodes.cend())
+      {
+        codes.push_back(valueCode->second);
+        continue;
+      }
+      if (values.size() == MAX_DICTIONARY_SIZE)
+        SC_THROW_EXCEPTION(utils::ExceptionInvalidParams, "Too many distinct replacements for dictionary");
+      valueCodes.emplace(replacement, values.size());
+      codes.push_back(values.size());
+      values.push_back(replacement);
+    }
+    break;
+  }
+  case COLUMN_PLAIN:
+    plainValues = &replacements;
+    break;
+  }
+}
+
+}  // namespace inference
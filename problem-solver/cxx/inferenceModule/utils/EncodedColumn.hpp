@@ -0,0 +1,106 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <sc-memory/sc_addr.hpp>
+
+namespace inference
+{
+enum ColumnEncoding
+{
+  COLUMN_PLAIN,
+  COLUMN_CONSTANT,
+  COLUMN_RUN_LENGTH,
+  COLUMN_DICTIONARY
+};
+
+/**
+ * Compressed replacements of one variable. Encoding is selected by the least size:
+ * - constant column stores one value;
+ * - run-length column stores values of runs of equal replacements and ends of the runs;
+ * - dictionary column stores distinct values and 16-bit codes of replacements;
+ * - plain column refers to replacements as they are, so the replacements must outlive the column.
+ * Every replacement refers to one of stored values, so a function of replacements (e.g. hash) may be computed
+ * once per value instead of once per replacement.
+ * Columns are encoded by joins for the time of the join only (see ReplacementsJoin), replacements kept by formulas
+ * and passed between them stay plain vectors, so the encoding doesn't reduce memory of replacements.
+ */
+class EncodedColumn
+{
+public:
+  EncodedColumn() = default;
+
+  explicit EncodedColumn(ScAddrVector const & replacements);
+
+  EncodedColumn(ScAddrVector const & replacements, ColumnEncoding encoding);
+
+  static ColumnEncoding selectEncoding(ScAddrVector const & replacements);
+
+  ColumnEncoding getEncoding() const;
+
+  size_t size() const;
+
+  ScAddr get(size_t index) const;
+
+  /// @returns stored values: one value, values of runs, dictionary or replacements for plain column
+  ScAddrVector const & getValues() const;
+
+  /// Call `function(index, valueIndex)` for every replacement in order, `valueIndex` is an index in `getValues()`
+  template <typename Function>
+  void forEachValueIndex(Function function) const;
+
+  /// @returns amount of bytes used by encoded replacements
+  size_t getBytesSize() const;
+
+private:
+  void encode(ScAddrVector const & replacements);
+
+  ColumnEncoding encoding = COLUMN_PLAIN;
+  size_t replacementsAmount = 0;
+  ScAddrVector values;
+  /// Replacements of plain column, they are not copied
+  ScAddrVector const * plainValues = nullptr;
+  /// Exclusive end of every run for run-length column
+  std::vector<uint32_t> runEnds;
+  /// Indices of values for dictionary column
+  std::vector<uint16_t> codes;
+};
+
+template <typename Function>
+void EncodedColumn::forEachValueIndex(Function function) const
+{
+  switch (encoding)
+  {
+  case COLUMN_CONSTANT:
+    for (size_t index = 0; index < replacementsAmount; ++index)
+      function(index, 0);
+    break;
+  case COLUMN_RUN_LENGTH:
+  {
+    size_t index = 0;
+    for (size_t run = 0; run < runEnds.size(); ++run)
+    {
+      for (; index < runEnds[run]; ++index)
+        function(index, run);
+    }
+    break;
+  }
+  case COLUMN_DICTIONARY:
+    for (size_t index = 0; index < replacementsAmount; ++index)
+      function(index, codes[index]);
+    break;
+  case COLUMN_PLAIN:
+    for (size_t index = 0; index < replacementsAmount; ++index)
+      function(index, index);
+    break;
+  }
+}
+
+}  // namespace inference
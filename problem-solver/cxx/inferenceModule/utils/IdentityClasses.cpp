@@ -0,0 +1,83 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "IdentityClasses.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace inference
+{
+void IdentityClasses::unite(ScAddr const & first, ScAddr const & second)
+{
+  size_t firstRoot = findRoot(addElement(first));
+  size_t secondRoot = findRoot(addElement(second));
+  if (firstRoot == secondRoot)
+    return;
+
+  if (classesElements[firstRoot].size() < classesElements[secondRoot].size())
+    std::swap(firstRoot, secondRoot);
+  parents[secondRoot] = firstRoot;
+
+  std::vector<size_t> classElements;
+  classElements.reserve(classesElements[firstRoot].size() + classesElements[secondRoot].size());
+  std::merge(
+      classesElements[firstRoot].cbegin(),
+      classesElements[firstRoot].cend(),
+      classesElements[secondRoot].cbegin(),
+      classesElements[secondRoot].cend(),
+      std::back_inserter(classElements));
+  classesElements[firstRoot] = std::move(classElements);
+  classesElements[secondRoot].clear();
+  classesElements[secondRoot].shrink_to_fit();
+}
+
+ScAddr IdentityClasses::getRepresentative(ScAddr const & element) const
+{
+  auto const & elementIndex = elementsIndices.find(element);
+  if (elementIndex == elementsIndices.cend())
+    return element;
+  return elements[classesElements[findRoot(elementIndex->second)].front()];
+}
+
+ScAddrVector IdentityClasses::getIdenticalElements(ScAddr const & element) const
+{
+  auto const & elementIndex = elementsIndices.find(element);
+  if (elementIndex == elementsIndices.cend())
+    return {element};
+
+  ScAddrVector identicalElements;
+  for (size_t identicalElementIndex : classesElements[findRoot(elementIndex->second)])
+    identicalElements.push_back(elements[identicalElementIndex]);
+  return identicalElements;
+}
+
+size_t IdentityClasses::size() const
+{
+  return elements.size();
+}
+
+size_t IdentityClasses::addElement(ScAddr const & element)
+{
+  auto const & elementIndex = elementsIndices.emplace(element, elements.size());
+  if (elementIndex.second)
+  {
+    elements.push_back(element);
+    parents.push_back(elementIndex.first->second);
+    classesElements.push_back({elementIndex.first->second});
+  }
+  return elementIndex.first->second;
+}
+
+size_t IdentityClasses::findRoot(size_t elementIndex) const
+{
+  while (parents[elementIndex] != elementIndex)
+    elementIndex = parents[elementIndex];
+  return elementIndex;
+}
+
+}  // namespace inference
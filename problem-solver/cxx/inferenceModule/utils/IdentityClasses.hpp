@@ -0,0 +1,47 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <sc-memory/sc_addr.hpp>
+
+namespace inference
+{
+/**
+ * Classes of identical elements built by union-find. Classes are united by size, so a representative is found in
+ * logarithmic time without path compression and classes are only read by concurrent searches after they are built.
+ * Elements without identical ones are not stored, they are representatives of themselves.
+ */
+class IdentityClasses
+{
+public:
+  void unite(ScAddr const & first, ScAddr const & second);
+
+  /// @returns representative of the class of `element`, it is the first added element of the class
+  ScAddr getRepresentative(ScAddr const & element) const;
+
+  /// @returns elements of the class of `element` in order of adding, it is `element` only if it has no identical ones
+  ScAddrVector getIdenticalElements(ScAddr const & element) const;
+
+  /// @returns amount of elements which have identical ones
+  size_t size() const;
+
+private:
+  size_t addElement(ScAddr const & element);
+
+  size_t findRoot(size_t elementIndex) const;
+
+  ScAddrVector elements;
+  std::unordered_map<ScAddr, size_t, ScAddrHashFunc<::size_t>> elementsIndices;
+  std::vector<size_t> parents;
+  /// Indices of elements of a class in ascending order, they are stored by the root of the class
+  std::vector<std::vector<size_t>> classesElements;
+};
+
+}  // namespace inference
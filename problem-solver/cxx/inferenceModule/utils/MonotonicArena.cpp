@@ -0,0 +1,102 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "MonotonicArena.hpp"
+
+#include <algorithm>
+
+namespace inference
+{
+thread_local MonotonicArena * MonotonicArena::current = nullptr;
+
+MonotonicArena::Scope::Scope(MonotonicArena & arena)
+  : arena(arena)
+  , previousArena(current)
+  , blocksAmount(arena.blocks.size())
+  , offset(arena.offset)
+{
+  current = &arena;
+}
+
+MonotonicArena::Scope::~Scope()
+{
+  arena.rewind(blocksAmount, offset);
+  current = previousArena;
+}
+
+MonotonicArena::HeapScope::HeapScope()
+  : previousArena(current)
+{
+  current = nullptr;
+}
+
+MonotonicArena::HeapScope::~HeapScope()
+{
+  current = previousArena;
+}
+
+MonotonicArena::MonotonicArena(size_t initialBlockSize)
+  : nextBlockSize(std::max<size_t>(initialBlockSize, 1))
+{
+}
+
+void * MonotonicArena::allocate(size_t size, size_t alignment)
+{
+  ++allocationsAmount;
+  bytesAllocated += size;
+
+  if (!blocks.empty())
+  {
+    size_t const alignedOffset = (offset + alignment - 1) / alignment * alignment;
+    if (alignedOffset + size <= blocks.back().size)
+    {
+      offset = alignedOffset + size;
+      return blocks.back().data.get() + alignedOffset;
+    }
+  }
+
+  // Memory of a new block is aligned for any fundamental type
+  size_t const blockSize = std::max(nextBlockSize, size);
+  blocks.push_back({std::unique_ptr<char[]>(new char[blockSize]), blockSize});
+  nextBlockSize = blockSize * 2;
+  blocksSize += blockSize;
+  peakSize = std::max(peakSize, blocksSize);
+  offset = size;
+  return blocks.back().data.get();
+}
+
+size_t MonotonicArena::getAllocationsAmount() const
+{
+  return allocationsAmount;
+}
+
+size_t MonotonicArena::getBytesAllocated() const
+{
+  return bytesAllocated;
+}
+
+size_t MonotonicArena::getPeakSize() const
+{
+  return peakSize;
+}
+
+MonotonicArena * MonotonicArena::getCurrent()
+{
+  return current;
+}
+
+void MonotonicArena::rewind(size_t blocksAmount, size_t otherOffset)
+{
+  while (blocks.size() > blocksAmount)
+  {
+    blocksSize -= blocks.back().size;
+    nextBlockSize = std::max(blocks.back().size / 2, nextBlockSize / 2);
+    blocks.pop_back();
+  }
+  offset = otherOffset;
+}
+
+}  // namespace inference
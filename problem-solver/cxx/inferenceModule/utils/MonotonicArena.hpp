@@ -0,0 +1,172 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <new>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace inference
+{
+/**
+ * Monotonic arena for temporary containers of inference. Memory is allocated from blocks by moving an offset,
+ * deallocation does nothing, all memory of a scope is released at once when the scope ends.
+ * Scopes are nested: a scope releases memory allocated after its start only, so containers allocated in a scope must
+ * not outlive the scope or grow in a nested scope. The arena is not thread-safe, containers use the arena of the scope
+ * opened in their thread, containers of other threads use heap.
+ */
+class MonotonicArena
+{
+public:
+  /// Make arena current for allocators of the thread and release memory allocated in the scope at its end
+  class Scope
+  {
+  public:
+    explicit Scope(MonotonicArena & arena);
+    ~Scope();
+
+    Scope(Scope const & other) = delete;
+    Scope & operator=(Scope const & other) = delete;
+
+  private:
+    MonotonicArena & arena;
+    MonotonicArena * previousArena;
+    size_t blocksAmount;
+    size_t offset;
+  };
+
+  /// Make allocators of the thread use heap until the scope ends, e.g. in a task whose containers outlive the task
+  class HeapScope
+  {
+  public:
+    HeapScope();
+    ~HeapScope();
+
+    HeapScope(HeapScope const & other) = delete;
+    HeapScope & operator=(HeapScope const & other) = delete;
+
+  private:
+    MonotonicArena * previousArena;
+  };
+
+  explicit MonotonicArena(size_t initialBlockSize = 64 * 1024);
+
+  MonotonicArena(MonotonicArena const & other) = delete;
+  MonotonicArena & operator=(MonotonicArena const & other) = delete;
+
+  void * allocate(size_t size, size_t alignment);
+
+  size_t getAllocationsAmount() const;
+
+  size_t getBytesAllocated() const;
+
+  /// @returns the largest size of arena blocks at once
+  size_t getPeakSize() const;
+
+  /// @returns arena of the innermost scope opened in this thread or nullptr
+  static MonotonicArena * getCurrent();
+
+private:
+  struct Block
+  {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+
+  void rewind(size_t blocksAmount, size_t offset);
+
+  std::vector<Block> blocks;
+  size_t offset = 0;
+  size_t blocksSize = 0;
+  size_t nextBlockSize;
+
+  size_t allocationsAmount = 0;
+  size_t bytesAllocated = 0;
+  size_t peakSize = 0;
+
+  static thread_local MonotonicArena * current;
+};
+
+/// Allocator of the current arena of the thread where it is created. Without current arena memory is allocated in heap
+template <typename T>
+class ArenaAllocator
+{
+public:
+  using value_type = T;
+
+  ArenaAllocator() noexcept
+    : arena(MonotonicArena::getCurrent())
+  {
+  }
+
+  explicit ArenaAllocator(MonotonicArena * arena) noexcept
+    : arena(arena)
+  {
+  }
+
+  template <typename U>
+  ArenaAllocator(ArenaAllocator<U> const & other) noexcept
+    : arena(other.getArena())
+  {
+  }
+
+  T * allocate(size_t amount)
+  {
+    if (arena != nullptr)
+      return static_cast<T *>(arena->allocate(amount * sizeof(T), alignof(T)));
+    return static_cast<T *>(::operator new(amount * sizeof(T)));
+  }
+
+  void deallocate(T * pointer, size_t) noexcept
+  {
+    if (arena == nullptr)
+      ::operator delete(pointer);
+  }
+
+  MonotonicArena * getArena() const noexcept
+  {
+    return arena;
+  }
+
+private:
+  MonotonicArena * arena;
+};
+
+template <typename T, typename U>
+bool operator==(ArenaAllocator<T> const & first, ArenaAllocator<U> const & second) noexcept
+{
+  return first.getArena() == second.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(ArenaAllocator<T> const & first, ArenaAllocator<U> const & second) noexcept
+{
+  return !(first == second);
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+template <typename T, typename Compare = std::less<T>>
+using ArenaSet = std::set<T, Compare, ArenaAllocator<T>>;
+
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+using ArenaMap = std::map<Key, Value, Compare, ArenaAllocator<std::pair<Key const, Value>>>;
+
+template <typename T, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+using ArenaUnorderedSet = std::unordered_set<T, Hash, Equal, ArenaAllocator<T>>;
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+using ArenaUnorderedMap = std::unordered_map<Key, Value, Hash, Equal, ArenaAllocator<std::pair<Key const, Value>>>;
+
+}  // namespace inference
@@ -0,0 +1,106 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "NumericLinksIndex.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+
+namespace inference
+{
+namespace
+{
+std::string const RANGE_DELIMITER = "..";
+}  // namespace
+
+bool NumericRange::contains(double value) const
+{
+  bool const isAboveLowerBound = isLowerBoundIncluded ? value >= lowerBound : value > lowerBound;
+  bool const isBelowUpperBound = isUpperBoundIncluded ? value <= upperBound : value < upperBound;
+  return isAboveLowerBound && isBelowUpperBound;
+}
+
+bool NumericLinksIndex::parseNumber(std::string const & content, double & value)
+{
+  if (content.empty() || std::isspace(static_cast<unsigned char>(content.front())))
+    return false;
+
+  char * end = nullptr;
+  errno = 0;
+  double const number = std::strtod(content.c_str(), &end);
+  if (errno == ERANGE || end != content.c_str() + content.size() || std::isnan(number))
+    return false;
+
+  value = number;
+  return true;
+}
+
+bool NumericLinksIndex::parseRange(std::string const & content, NumericRange & range)
+{
+  size_t const delimiterPosition = content.find(RANGE_DELIMITER);
+  if (delimiterPosition == std::string::npos)
+    return false;
+
+  double lowerBound;
+  double upperBound;
+  if (!parseNumber(content.substr(0, delimiterPosition), lowerBound) ||
+      !parseNumber(content.substr(delimiterPosition + RANGE_DELIMITER.size()), upperBound))
+    return false;
+
+  range = {lowerBound, upperBound, true, true};
+  return true;
+}
+
+void NumericLinksIndex::add(ScAddr const & link, std::string const & content)
+{
+  double value;
+  if (!parseNumber(content, value) || !links.insert(link).second)
+    return;
+
+  isSorted = isSorted && (values.empty() || values.back().first <= value);
+  values.emplace_back(value, link);
+}
+
+bool NumericLinksIndex::contains(ScAddr const & link) const
+{
+  return links.count(link) > 0;
+}
+
+ScAddrUnorderedSet NumericLinksIndex::findInRange(NumericRange const & range)
+{
+  if (!isSorted)
+  {
+    std::stable_sort(
+        values.begin(),
+        values.end(),
+        [](std::pair<double, ScAddr> const & first, std::pair<double, ScAddr> const & second) {
+          return first.first < second.first;
+        });
+    isSorted = true;
+  }
+
+  auto const lessThanValue = [](std::pair<double, ScAddr> const & element, double value) {
+    return element.first < value;
+  };
+  auto valueIterator = std::lower_bound(values.cbegin(), values.cend(), range.lowerBound, lessThanValue);
+  ScAddrUnorderedSet rangeLinks;
+  for (; valueIterator != values.cend() && valueIterator->first <= range.upperBound; ++valueIterator)
+  {
+    if (range.contains(valueIterator->first))
+      rangeLinks.insert(valueIterator->second);
+  }
+  return rangeLinks;
+}
+
+size_t NumericLinksIndex::size() const
+{
+  return values.size();
+}
+
+}  // namespace inference
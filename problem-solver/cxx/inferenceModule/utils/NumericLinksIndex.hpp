@@ -0,0 +1,62 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <sc-memory/sc_addr.hpp>
+
+namespace inference
+{
+using ScAddrUnorderedSet = std::unordered_set<ScAddr, ScAddrHashFunc<::size_t>>;
+
+/// Interval of numbers, a bound is infinite if there is no bound
+struct NumericRange
+{
+  double lowerBound = -std::numeric_limits<double>::infinity();
+  double upperBound = std::numeric_limits<double>::infinity();
+  bool isLowerBoundIncluded = true;
+  bool isUpperBoundIncluded = true;
+
+  bool contains(double value) const;
+};
+
+/**
+ * Numeric values of links sorted by value, so links with values in a range are found by binary search instead of
+ * reading content of every link. Values are sorted once after links are added.
+ */
+class NumericLinksIndex
+{
+public:
+  /// @returns true if the whole `content` is a number written as text, the number is written to `value`
+  static bool parseNumber(std::string const & content, double & value);
+
+  /// Parse range of numbers written as `lower..upper`, both bounds are included
+  static bool parseRange(std::string const & content, NumericRange & range);
+
+  /// Add the link if its content is a number
+  void add(ScAddr const & link, std::string const & content);
+
+  bool contains(ScAddr const & link) const;
+
+  /// @returns links of the index with values in `range`
+  ScAddrUnorderedSet findInRange(NumericRange const & range);
+
+  size_t size() const;
+
+private:
+  std::vector<std::pair<double, ScAddr>> values;
+  ScAddrUnorderedSet links;
+  bool isSorted = true;
+};
+
+}  // namespace inference
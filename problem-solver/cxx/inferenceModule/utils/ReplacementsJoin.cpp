@@ -0,0 +1,452 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "ReplacementsJoin.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+
+namespace inference
+{
+namespace
+{
+/// Spilled partitions are selected by next bits of hashes on every level of partitioning
+size_t const SPILLED_PARTITION_BITS = 4;
+size_t const SPILLED_PARTITIONS_AMOUNT = size_t(1) << SPILLED_PARTITION_BITS;
+/// Unjoined partitions of every level are opened, so at most 2 * SPILLED_PARTITIONS_AMOUNT * MAX_SPILL_DEPTH spill
+/// files are opened at once
+size_t const MAX_SPILL_DEPTH = 4;
+/// Partitions joined as tasks are smaller than partitions of threads, so idle workers steal partitions of slower ones
+size_t const TASKS_PER_THREAD_AMOUNT = 4;
+
+size_t getSpilledPartitionIndex(size_t hash, size_t depth)
+{
+  return (hash >> (depth * SPILLED_PARTITION_BITS)) & (SPILLED_PARTITIONS_AMOUNT - 1);
+}
+}  // namespace
+
+ReplacementsJoin::ReplacementsJoin(
+    Replacements const & first,
+    Replacements const & second,
+    JoinConfig const & config,
+    WorkStealingScheduler * scheduler)
+  : first(first)
+  , second(second)
+  , config(config)
+  , scheduler(scheduler)
+{
+  for (auto const & pair : first)
+  {
+    if (second.find(pair.first) != second.cend())
+      commonVarNames.push_back(pair.first);
+  }
+}
+
+Replacements ReplacementsJoin::getReplacements()
+{
+  encodeOperand(first, firstOperand);
+  encodeOperand(second, secondOperand);
+
+  Replacements result;
+  if (!pruneConstantVars())
+    return result;
+  hashOperand(firstOperand);
+  hashOperand(secondOperand);
+
+  std::vector<ResultVar> const resultVars = prepareResult(result);
+  ColumnsPairs const pairs = isSpilled() ? joinSpilled() : (isParallel() ? joinParallel() : joinSerial());
+  for (ResultVar const & resultVar : resultVars)
+    resultVar.values->reserve(pairs.size());
+  for (auto const & pair : pairs)
+    addColumn(resultVars, pair.first, pair.second);
+
+  if (ReplacementsUtils::getColumnsAmount(result) == 0)
+    result.clear();
+  return result;
+}
+
+void ReplacementsJoin::encodeOperand(Replacements const & replacements, Operand & operand) const
+{
+  operand.columnsAmount = ReplacementsUtils::getColumnsAmount(replacements);
+  operand.commonReplacements.clear();
+  operand.commonColumns.clear();
+  for (std::string const & varName : commonVarNames)
+  {
+    ScAddrVector const & replacementsVector = replacements.find(varName)->second;
+    operand.commonReplacements.push_back(&replacementsVector);
+    operand.commonColumns.emplace_back(replacementsVector);
+  }
+}
+
+bool ReplacementsJoin::pruneConstantVars()
+{
+  for (size_t varIndex = commonVarNames.size(); varIndex-- > 0;)
+  {
+    EncodedColumn const & firstColumn = firstOperand.commonColumns[varIndex];
+    EncodedColumn const & secondColumn = secondOperand.commonColumns[varIndex];
+    if (firstColumn.getEncoding() != COLUMN_CONSTANT || secondColumn.getEncoding() != COLUMN_CONSTANT)
+      continue;
+    ScAddr const & firstValue = firstColumn.getValues()[0];
+    ScAddr const & secondValue = secondColumn.getValues()[0];
+    // Padded replacement is compatible with any value, so it is pruned too
+    if (firstValue.IsValid() && secondValue.IsValid() && firstValue != secondValue)
+      return false;
+
+    commonVarNames.erase(commonVarNames.begin() + varIndex);
+    for (Operand * operand : {&firstOperand, &secondOperand})
+    {
+      operand->commonReplacements.erase(operand->commonReplacements.begin() + varIndex);
+      operand->commonColumns.erase(operand->commonColumns.begin() + varIndex);
+    }
+  }
+  return true;
+}
+
+void ReplacementsJoin::hashOperand(Operand & operand) const
+{
+  ScAddrHashFunc<::size_t> addrHashFunc;
+  operand.hashes.assign(operand.columnsAmount, 0);
+  operand.padded.assign(operand.columnsAmount, false);
+  operand.hasPadded = false;
+  for (EncodedColumn const & column : operand.commonColumns)
+  {
+    ScAddrVector const & values = column.getValues();
+    ArenaVector<size_t> valuesHashes(values.size());
+    for (size_t valueIndex = 0; valueIndex < values.size(); ++valueIndex)
+      valuesHashes[valueIndex] = addrHashFunc(values[valueIndex]);
+
+    column.forEachValueIndex([&operand, &values, &valuesHashes](size_t columnIndex, size_t valueIndex) {
+      if (!values[valueIndex].IsValid())
+      {
+        operand.padded[columnIndex] = true;
+        operand.hasPadded = true;
+        return;
+      }
+      size_t & hash = operand.hashes[columnIndex];
+      hash ^= valuesHashes[valueIndex] + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    });
+  }
+}
+
+bool ReplacementsJoin::areCompatible(size_t firstColumnIndex, size_t secondColumnIndex) const
+{
+  for (size_t varIndex = 0; varIndex < commonVarNames.size(); ++varIndex)
+  {
+    ScAddr const & firstValue = (*firstOperand.commonReplacements[varIndex])[firstColumnIndex];
+    ScAddr const & secondValue = (*secondOperand.commonReplacements[varIndex])[secondColumnIndex];
+    // Padded replacement is compatible with any value
+    if (firstValue.IsValid() && secondValue.IsValid() && firstValue != secondValue)
+      return false;
+  }
+  return true;
+}
+
+void ReplacementsJoin::joinColumns(
+    ArenaVector<size_t> const & firstColumns,
+    ArenaVector<size_t> const & secondColumns,
+    ColumnsPairs & pairs) const
+{
+  ArenaUnorderedMap<size_t, ArenaVector<size_t>> table;
+  ArenaVector<size_t> paddedSecondColumns;
+  for (size_t const secondColumnIndex : secondColumns)
+  {
+    if (secondOperand.padded[secondColumnIndex])
+      paddedSecondColumns.push_back(secondColumnIndex);
+    else
+      table[secondOperand.hashes[secondColumnIndex]].push_back(secondColumnIndex);
+  }
+
+  ArenaVector<size_t> const noColumns;
+  for (size_t const firstColumnIndex : firstColumns)
+  {
+    if (firstOperand.padded[firstColumnIndex])
+    {
+      for (size_t const secondColumnIndex : secondColumns)
+      {
+        if (areCompatible(firstColumnIndex, secondColumnIndex))
+          pairs.emplace_back(firstColumnIndex, secondColumnIndex);
+      }
+      continue;
+    }
+
+    auto const & bucket = table.find(firstOperand.hashes[firstColumnIndex]);
+    ArenaVector<size_t> const & hashedColumns = bucket == table.cend() ? noColumns : bucket->second;
+    // Merge of hashed and padded columns keeps columns of `second` in ascending order
+    auto hashedIt = hashedColumns.cbegin();
+    auto paddedIt = paddedSecondColumns.cbegin();
+    while (hashedIt != hashedColumns.cend() || paddedIt != paddedSecondColumns.cend())
+    {
+      size_t secondColumnIndex;
+      if (paddedIt == paddedSecondColumns.cend() || (hashedIt != hashedColumns.cend() && *hashedIt < *paddedIt))
+        secondColumnIndex = *hashedIt++;
+      else
+        secondColumnIndex = *paddedIt++;
+
+      // Hashes may collide, so replacements are compared anyway
+      if (areCompatible(firstColumnIndex, secondColumnIndex))
+        pairs.emplace_back(firstColumnIndex, secondColumnIndex);
+    }
+  }
+}
+
+ReplacementsJoin::ColumnsPairs ReplacementsJoin::joinSerial() const
+{
+  ArenaVector<size_t> firstColumns(firstOperand.columnsAmount);
+  for (size_t columnIndex = 0; columnIndex < firstColumns.size(); ++columnIndex)
+    firstColumns[columnIndex] = columnIndex;
+  ArenaVector<size_t> secondColumns(secondOperand.columnsAmount);
+  for (size_t columnIndex = 0; columnIndex < secondColumns.size(); ++columnIndex)
+    secondColumns[columnIndex] = columnIndex;
+
+  ColumnsPairs pairs;
+  joinColumns(firstColumns, secondColumns, pairs);
+  return pairs;
+}
+
+ReplacementsJoin::ColumnsPairs ReplacementsJoin::joinParallel() const
+{
+  // Partitions are selected by low bits of hashes, so equal replacements are always in the same partition
+  size_t const minPartitionsAmount = config.threadsAmount * (scheduler != nullptr ? TASKS_PER_THREAD_AMOUNT : 1);
+  size_t partitionsAmount = 1;
+  while (partitionsAmount < minPartitionsAmount)
+    partitionsAmount <<= 1;
+  size_t const partitionMask = partitionsAmount - 1;
+
+  ArenaVector<ArenaVector<size_t>> firstPartitions(partitionsAmount);
+  for (size_t columnIndex = 0; columnIndex < firstOperand.columnsAmount; ++columnIndex)
+    firstPartitions[firstOperand.hashes[columnIndex] & partitionMask].push_back(columnIndex);
+  ArenaVector<ArenaVector<size_t>> secondPartitions(partitionsAmount);
+  for (size_t columnIndex = 0; columnIndex < secondOperand.columnsAmount; ++columnIndex)
+    secondPartitions[secondOperand.hashes[columnIndex] & partitionMask].push_back(columnIndex);
+
+  std::vector<ColumnsPairs> partitionsPairs(partitionsAmount);
+  if (scheduler != nullptr)
+  {
+    WorkStealingScheduler::TaskGroup partitionsTasks(*scheduler);
+    for (size_t partition = 0; partition < partitionsAmount; ++partition)
+    {
+      partitionsTasks.run([this, partition, &firstPartitions, &secondPartitions, &partitionsPairs]() {
+        joinColumns(firstPartitions[partition], secondPartitions[partition], partitionsPairs[partition]);
+      });
+    }
+    partitionsTasks.wait();
+  }
+  else
+  {
+    size_t const threadsAmount = std::min(config.threadsAmount, partitionsAmount);
+    std::vector<std::thread> threads;
+    threads.reserve(threadsAmount);
+    for (size_t threadIndex = 0; threadIndex < threadsAmount; ++threadIndex)
+    {
+      threads.emplace_back([this, threadIndex, threadsAmount, partitionsAmount, &firstPartitions, &secondPartitions,
+                            &partitionsPairs]() {
+        for (size_t partition = threadIndex; partition < partitionsAmount; partition += threadsAmount)
+          joinColumns(firstPartitions[partition], secondPartitions[partition], partitionsPairs[partition]);
+      });
+    }
+    for (std::thread & thread : threads)
+      thread.join();
+  }
+
+  size_t pairsAmount = 0;
+  for (ColumnsPairs const & pairs : partitionsPairs)
+    pairsAmount += pairs.size();
+  ColumnsPairs result;
+  result.reserve(pairsAmount);
+  for (ColumnsPairs const & pairs : partitionsPairs)
+    result.insert(result.end(), pairs.cbegin(), pairs.cend());
+
+  if (config.deterministic)
+    std::sort(result.begin(), result.end());
+  return result;
+}
+
+bool ReplacementsJoin::isParallel() const
+{
+  // Columns with padded common replacements must be compared with columns of all partitions
+  return config.threadsAmount > 1 && !commonVarNames.empty() && !firstOperand.hasPadded &&
+         !secondOperand.hasPadded && firstOperand.columnsAmount >= config.parallelThreshold &&
+         secondOperand.columnsAmount >= config.parallelThreshold;
+}
+
+/// Estimation of bytes needed for hash table of columns of `second` with their common replacements
+size_t ReplacementsJoin::getHashTableSize(size_t secondColumnsAmount) const
+{
+  return secondColumnsAmount * (commonVarNames.size() * sizeof(ScAddr) + 4 * sizeof(size_t));
+}
+
+bool ReplacementsJoin::isSpilled() const
+{
+  return config.memoryThreshold > 0 && !commonVarNames.empty() && !firstOperand.hasPadded &&
+         !secondOperand.hasPadded && getHashTableSize(secondOperand.columnsAmount) > config.memoryThreshold;
+}
+
+ReplacementsJoin::SpilledPartitions ReplacementsJoin::createSpilledPartitions()
+{
+  SpilledPartitions partitions(SPILLED_PARTITIONS_AMOUNT);
+  for (SpilledPartition & partition : partitions)
+    partition.file = std::make_unique<SpillFile>();
+  return partitions;
+}
+
+void ReplacementsJoin::spillOperand(Operand const & operand, SpilledPartitions & partitions) const
+{
+  SpilledColumn column;
+  for (size_t columnIndex = 0; columnIndex < operand.columnsAmount; ++columnIndex)
+  {
+    column.columnIndex = columnIndex;
+    column.hash = operand.hashes[columnIndex];
+    column.commonReplacements.clear();
+    for (ScAddrVector const * replacementsVector : operand.commonReplacements)
+      column.commonReplacements.push_back((*replacementsVector)[columnIndex]);
+    writeSpilledColumn(partitions[getSpilledPartitionIndex(column.hash, 0)], column);
+  }
+}
+
+void ReplacementsJoin::writeSpilledColumn(SpilledPartition & partition, SpilledColumn const & column)
+{
+  partition.file->writeSize(column.columnIndex);
+  partition.file->writeSize(column.hash);
+  for (ScAddr const & value : column.commonReplacements)
+    partition.file->writeAddr(value);
+  ++partition.columnsAmount;
+}
+
+bool ReplacementsJoin::readSpilledColumn(SpillFile & partition, SpilledColumn & column) const
+{
+  uint64_t columnIndex;
+  uint64_t hash;
+  if (!partition.readSize(columnIndex) || !partition.readSize(hash))
+    return false;
+  column.columnIndex = columnIndex;
+  column.hash = hash;
+  column.commonReplacements.resize(commonVarNames.size());
+  for (ScAddr & value : column.commonReplacements)
+  {
+    if (!partition.readAddr(value))
+      SC_THROW_EXCEPTION(utils::ExceptionCritical, "Spill file of replacements is truncated");
+  }
+  return true;
+}
+
+ReplacementsJoin::SpilledPartitions ReplacementsJoin::repartition(SpilledPartition & partition, size_t depth) const
+{
+  SpilledPartitions partitions = createSpilledPartitions();
+  SpilledColumn column;
+  partition.file->rewind();
+  while (readSpilledColumn(*partition.file, column))
+    writeSpilledColumn(partitions[getSpilledPartitionIndex(column.hash, depth)], column);
+  partition.file.reset();
+  return partitions;
+}
+
+void ReplacementsJoin::joinSpilledPartitions(
+    SpilledPartitions & firstPartitions,
+    SpilledPartitions & secondPartitions,
+    size_t depth,
+    ColumnsPairs & pairs) const
+{
+  for (size_t partitionIndex = 0; partitionIndex < SPILLED_PARTITIONS_AMOUNT; ++partitionIndex)
+  {
+    SpilledPartition & firstPartition = firstPartitions[partitionIndex];
+    SpilledPartition & secondPartition = secondPartitions[partitionIndex];
+    if (firstPartition.columnsAmount > 0 && secondPartition.columnsAmount > 0)
+    {
+      // Columns with equal hashes are never split, so the depth of partitioning is limited
+      if (getHashTableSize(secondPartition.columnsAmount) > config.memoryThreshold && depth + 1 < MAX_SPILL_DEPTH)
+      {
+        SpilledPartitions firstSubpartitions = repartition(firstPartition, depth + 1);
+        SpilledPartitions secondSubpartitions = repartition(secondPartition, depth + 1);
+        joinSpilledPartitions(firstSubpartitions, secondSubpartitions, depth + 1, pairs);
+      }
+      else
+        joinPartition(*firstPartition.file, *secondPartition.file, pairs);
+    }
+
+    firstPartition.file.reset();
+    secondPartition.file.reset();
+  }
+}
+
+void ReplacementsJoin::joinPartition(SpillFile & firstPartition, SpillFile & secondPartition, ColumnsPairs & pairs)
+    const
+{
+  std::vector<SpilledColumn> secondColumns;
+  std::unordered_map<size_t, std::vector<size_t>> table;
+  SpilledColumn column;
+  secondPartition.rewind();
+  while (readSpilledColumn(secondPartition, column))
+  {
+    table[column.hash].push_back(secondColumns.size());
+    secondColumns.push_back(column);
+  }
+
+  firstPartition.rewind();
+  while (readSpilledColumn(firstPartition, column))
+  {
+    auto const & bucket = table.find(column.hash);
+    if (bucket == table.cend())
+      continue;
+    for (size_t const secondColumnPosition : bucket->second)
+    {
+      SpilledColumn const & secondColumn = secondColumns[secondColumnPosition];
+      if (column.commonReplacements == secondColumn.commonReplacements)
+        pairs.emplace_back(column.columnIndex, secondColumn.columnIndex);
+    }
+  }
+}
+
+ReplacementsJoin::ColumnsPairs ReplacementsJoin::joinSpilled() const
+{
+  SC_LOG_DEBUG("Join spills replacements to " << SPILLED_PARTITIONS_AMOUNT << " partitions");
+  SpilledPartitions firstPartitions = createSpilledPartitions();
+  SpilledPartitions secondPartitions = createSpilledPartitions();
+  spillOperand(firstOperand, firstPartitions);
+  spillOperand(secondOperand, secondPartitions);
+
+  ColumnsPairs pairs;
+  joinSpilledPartitions(firstPartitions, secondPartitions, 0, pairs);
+  // Partitions are joined in order of hashes
+  if (config.deterministic)
+    std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
+std::vector<ReplacementsJoin::ResultVar> ReplacementsJoin::prepareResult(Replacements & result) const
+{
+  std::vector<ResultVar> resultVars;
+  for (auto const & pair : first)
+  {
+    auto const & secondValues = second.find(pair.first);
+    resultVars.push_back(
+        {&result[pair.first], &pair.second, secondValues == second.cend() ? nullptr : &secondValues->second});
+  }
+  for (auto const & pair : second)
+  {
+    if (first.find(pair.first) == first.cend())
+      resultVars.push_back({&result[pair.first], nullptr, &pair.second});
+  }
+  return resultVars;
+}
+
+void ReplacementsJoin::addColumn(
+    std::vector<ResultVar> const & resultVars,
+    size_t firstColumnIndex,
+    size_t secondColumnIndex)
+{
+  for (ResultVar const & resultVar : resultVars)
+  {
+    // Padded replacement of `first` is replaced by a value of `second`
+    if (resultVar.firstValues != nullptr &&
+        ((*resultVar.firstValues)[firstColumnIndex].IsValid() || resultVar.secondValues == nullptr))
+      resultVar.values->push_back((*resultVar.firstValues)[firstColumnIndex]);
+    else
+      resultVar.values->push_back((*resultVar.secondValues)[secondColumnIndex]);
+  }
+}
+
+}  // namespace inference
@@ -0,0 +1,156 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sc-memory/sc_addr.hpp>
+
+#include "inferenceConfig/InferenceConfig.hpp"
+
+#include "EncodedColumn.hpp"
+#include "MonotonicArena.hpp"
+#include "ReplacementsUtils.hpp"
+#include "SpillFile.hpp"
+#include "WorkStealingScheduler.hpp"
+
+namespace inference
+{
+/**
+ * Join of replacements by their common variables. Columns of `second` are put into a hash table by replacements of
+ * common variables, columns of `first` probe it. Replacements of common variables are encoded (see EncodedColumn), so
+ * hash is computed once per encoded value. A common variable with the same constant replacement in both operands is
+ * not compared at all, different constant replacements mean an empty join. Padded (empty) replacement of a common
+ * variable is compatible with any value, such columns are compared with all columns of other operand.
+ * If both operands have at least `parallelThreshold` columns, they are partitioned by hashes of common replacements
+ * and partitions are joined in `threadsAmount` threads, or as tasks of `scheduler` if it is set.
+ * If the hash table needs more than `memoryThreshold` bytes, common replacements of both operands are partitioned to
+ * temporary files and partitions are joined one by one (grace hash join). A partition which hash table still needs
+ * more bytes is partitioned again by next bits of hashes, so only the hash table of one partition is in memory at
+ * once. Operands and joined replacements are kept in memory anyway.
+ * Joined columns are ordered by column of `first`, then by column of `second`, unless parallel or spilled join is not
+ * deterministic.
+ */
+class ReplacementsJoin
+{
+public:
+  ReplacementsJoin(
+      Replacements const & first,
+      Replacements const & second,
+      JoinConfig const & config,
+      WorkStealingScheduler * scheduler = nullptr);
+
+  ReplacementsJoin(ReplacementsJoin const & other) = delete;
+  ReplacementsJoin & operator=(ReplacementsJoin const & other) = delete;
+
+  Replacements getReplacements();
+
+private:
+  /// Pairs of column indices of `first` and `second` to join
+  using ColumnsPairs = std::vector<std::pair<size_t, size_t>>;
+
+  /// Variable of joined replacements with its replacements in operands, replacements of absent variable are nullptr
+  struct ResultVar
+  {
+    ScAddrVector * values;
+    ScAddrVector const * firstValues;
+    ScAddrVector const * secondValues;
+  };
+
+  /// Column of common replacements read from a spill file
+  struct SpilledColumn
+  {
+    size_t columnIndex;
+    size_t hash;
+    ScAddrVector commonReplacements;
+  };
+
+  /// Partition of common replacements of an operand spilled to a temporary file
+  struct SpilledPartition
+  {
+    std::unique_ptr<SpillFile> file;
+    size_t columnsAmount = 0;
+  };
+
+  using SpilledPartitions = std::vector<SpilledPartition>;
+
+  struct Operand
+  {
+    std::vector<ScAddrVector const *> commonReplacements;
+    std::vector<EncodedColumn> commonColumns;
+    ArenaVector<size_t> hashes;
+    ArenaVector<bool> padded;
+    size_t columnsAmount = 0;
+    bool hasPadded = false;
+  };
+
+  void encodeOperand(Replacements const & replacements, Operand & operand) const;
+
+  /// Remove common variables with constant replacements from join
+  /// @returns false if some common variable has different constant replacements
+  bool pruneConstantVars();
+
+  void hashOperand(Operand & operand) const;
+
+  bool areCompatible(size_t firstColumnIndex, size_t secondColumnIndex) const;
+
+  /// Hash join of given columns, the columns are expected in ascending order
+  void joinColumns(
+      ArenaVector<size_t> const & firstColumns,
+      ArenaVector<size_t> const & secondColumns,
+      ColumnsPairs & pairs) const;
+
+  ColumnsPairs joinSerial() const;
+
+  ColumnsPairs joinParallel() const;
+
+  bool isParallel() const;
+
+  size_t getHashTableSize(size_t secondColumnsAmount) const;
+
+  bool isSpilled() const;
+
+  static SpilledPartitions createSpilledPartitions();
+
+  void spillOperand(Operand const & operand, SpilledPartitions & partitions) const;
+
+  static void writeSpilledColumn(SpilledPartition & partition, SpilledColumn const & column);
+
+  bool readSpilledColumn(SpillFile & partition, SpilledColumn & column) const;
+
+  /// Move columns of the partition to partitions of the next level of partitioning, the partition is closed
+  SpilledPartitions repartition(SpilledPartition & partition, size_t depth) const;
+
+  /// Join spilled partitions with the same index, partitions with too large hash table are partitioned again
+  void joinSpilledPartitions(
+      SpilledPartitions & firstPartitions,
+      SpilledPartitions & secondPartitions,
+      size_t depth,
+      ColumnsPairs & pairs) const;
+
+  void joinPartition(SpillFile & firstPartition, SpillFile & secondPartition, ColumnsPairs & pairs) const;
+
+  ColumnsPairs joinSpilled() const;
+
+  std::vector<ResultVar> prepareResult(Replacements & result) const;
+
+  static void addColumn(std::vector<ResultVar> const & resultVars, size_t firstColumnIndex, size_t secondColumnIndex);
+
+  Replacements const & first;
+  Replacements const & second;
+  JoinConfig config;
+  WorkStealingScheduler * scheduler;
+
+  std::vector<std::string> commonVarNames;
+  Operand firstOperand;
+  Operand secondOperand;
+};
+
+}  // namespace inference
@@ -0,0 +1,102 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "ReplacementsUnion.hpp"
+
+namespace inference
+{
+ReplacementsUnion::ReplacementsUnion()
+  : columnsIndex(0, ColumnHashFunc{&columns}, ColumnEqualFunc{&columns})
+{
+}
+
+void ReplacementsUnion::add(Replacements const & replacements)
+{
+  size_t const columnsAmount = ReplacementsUtils::getColumnsAmount(replacements);
+  if (columnsAmount == 0)
+    return;
+
+  bool varsAdded = false;
+  ArenaVector<std::pair<size_t, ScAddrVector const *>> operandVars;
+  operandVars.reserve(replacements.size());
+  for (auto const & pair : replacements)
+  {
+    auto const & varIndex = varIndices.find(pair.first);
+    if (varIndex == varIndices.cend())
+    {
+      operandVars.emplace_back(addVariable(pair.first), &pair.second);
+      varsAdded = true;
+    }
+    else
+      operandVars.emplace_back(varIndex->second, &pair.second);
+  }
+
+  // Padded columns have new hashes, but they are still pairwise different
+  if (varsAdded)
+  {
+    columnsIndex.clear();
+    for (size_t columnIndex = 0; columnIndex < columns.size(); ++columnIndex)
+      columnsIndex.insert(columnIndex);
+  }
+
+  for (size_t columnIndex = 0; columnIndex < columnsAmount; ++columnIndex)
+  {
+    Column column(varNames.size());
+    for (auto const & operandVar : operandVars)
+      column[operandVar.first] = (*operandVar.second)[columnIndex];
+
+    columns.push_back(std::move(column));
+    if (!columnsIndex.insert(columns.size() - 1).second)
+      columns.pop_back();
+  }
+}
+
+size_t ReplacementsUnion::getColumnsAmount() const
+{
+  return columns.size();
+}
+
+Replacements ReplacementsUnion::getReplacements() const
+{
+  Replacements result;
+  if (columns.empty())
+    return result;
+
+  for (size_t varIndex = 0; varIndex < varNames.size(); ++varIndex)
+  {
+    ScAddrVector & replacementsVector = result[varNames[varIndex]];
+    replacementsVector.reserve(columns.size());
+    for (Column const & column : columns)
+      replacementsVector.push_back(column[varIndex]);
+  }
+  return result;
+}
+
+size_t ReplacementsUnion::addVariable(std::string const & varName)
+{
+  size_t const varIndex = varNames.size();
+  varNames.push_back(varName);
+  varIndices.emplace(varName, varIndex);
+  for (Column & column : columns)
+    column.emplace_back();
+  return varIndex;
+}
+
+size_t ReplacementsUnion::ColumnHashFunc::operator()(size_t columnIndex) const
+{
+  ScAddrHashFunc<::size_t> addrHashFunc;
+  size_t hash = 0;
+  for (ScAddr const & addr : (*columns)[columnIndex])
+    hash ^= addrHashFunc(addr) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
+bool ReplacementsUnion::ColumnEqualFunc::operator()(size_t firstColumnIndex, size_t secondColumnIndex) const
+{
+  return (*columns)[firstColumnIndex] == (*columns)[secondColumnIndex];
+}
+
+}  // namespace inference
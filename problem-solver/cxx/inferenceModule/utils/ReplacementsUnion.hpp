@@ -0,0 +1,69 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <sc-memory/sc_addr.hpp>
+
+#include "MonotonicArena.hpp"
+#include "ReplacementsUtils.hpp"
+
+namespace inference
+{
+/**
+ * Union of replacements. Operands are added one by one, so the union never builds a cross product of them.
+ * Variables of the operands are aligned by names: if an operand doesn't have some variable, its columns are padded
+ * with an empty ScAddr for this variable. Duplicated columns are stored once in order of their first occurrence.
+ * Columns are allocated in the current arena, so the union must not outlive the arena scope where it is used.
+ */
+class ReplacementsUnion
+{
+public:
+  ReplacementsUnion();
+
+  ReplacementsUnion(ReplacementsUnion const & other) = delete;
+  ReplacementsUnion & operator=(ReplacementsUnion const & other) = delete;
+
+  /// Append all columns of `replacements` which are not in the union yet
+  void add(Replacements const & replacements);
+
+  size_t getColumnsAmount() const;
+
+  /// @returns union as replacements. Union without columns is returned as empty replacements
+  Replacements getReplacements() const;
+
+private:
+  /// Replacements of all variables in order of `varNames`
+  using Column = ArenaVector<ScAddr>;
+
+  struct ColumnHashFunc
+  {
+    ArenaVector<Column> const * columns;
+
+    size_t operator()(size_t columnIndex) const;
+  };
+
+  struct ColumnEqualFunc
+  {
+    ArenaVector<Column> const * columns;
+
+    bool operator()(size_t firstColumnIndex, size_t secondColumnIndex) const;
+  };
+
+  size_t addVariable(std::string const & varName);
+
+  std::vector<std::string> varNames;
+  std::map<std::string, size_t> varIndices;
+  ArenaVector<Column> columns;
+  ArenaUnorderedSet<size_t, ColumnHashFunc, ColumnEqualFunc> columnsIndex;
+};
+
+}  // namespace inference
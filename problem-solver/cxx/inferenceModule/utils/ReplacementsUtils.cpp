@@ -7,110 +7,50 @@
 #include "ReplacementsUtils.hpp"
 #include "sc-memory/kpm/sc_agent.hpp"
 
+#include "ReplacementsJoin.hpp"
+#include "ReplacementsUnion.hpp"
+
+std::atomic<size_t> inference::ReplacementsUtils::joinedColumnsAmount{0};
+
+/**
+ * @brief Join replacements by their common variables, see ReplacementsJoin
+ * @returns copy of other replacements if one of them has no columns
+ */
 Replacements inference::ReplacementsUtils::intersectReplacements(
     Replacements const & first,
-    Replacements const & second)
+    Replacements const & second,
+    JoinSettings const & joinSettings)
 {
-  Replacements result;
-  size_t resultSize = 0;
-  set<string> firstKeys;
-  getKeySet(first, firstKeys);
-  set<string> secondKeys;
-  getKeySet(second, secondKeys);
-  set<string> commonKeysSet = getCommonKeys(firstKeys, secondKeys);
-  size_t firstAmountOfColumns = getColumnsAmount(first);
-  size_t secondAmountOfColumns = getColumnsAmount(second);
-
-  if (firstAmountOfColumns == 0)
+  if (getColumnsAmount(first) == 0)
     return copyReplacements(second);
-  if (secondAmountOfColumns == 0)
+  if (getColumnsAmount(second) == 0)
     return copyReplacements(first);
 
-  for (size_t columnIndexInFirst = 0; columnIndexInFirst < firstAmountOfColumns; ++columnIndexInFirst)
-  {
-    for (size_t columnIndexInSecond = 0; columnIndexInSecond < secondAmountOfColumns; ++columnIndexInSecond)
-    {
-      bool commonPartsAreIdentical = true;
-      for (string const & commonKey : commonKeysSet)
-      {
-        if (first.find(commonKey)->second[columnIndexInFirst] != second.find(commonKey)->second[columnIndexInSecond])
-          commonPartsAreIdentical = false;
-      }
-      if (commonPartsAreIdentical)
-      {
-        for (string const & firstKey : firstKeys)
-          result[firstKey].push_back(first.find(firstKey)->second[columnIndexInFirst]);
-        for (string const & secondKey : secondKeys)
-        {
-          if (result[secondKey].size() == resultSize)
-            result[secondKey].push_back(second.find(secondKey)->second[columnIndexInSecond]);
-        }
-        ++resultSize;
-      }
-    }
-  }
+  ReplacementsJoin join(first, second, joinSettings.config, joinSettings.scheduler.get());
+  Replacements result = join.getReplacements();
+  joinedColumnsAmount += getColumnsAmount(result);
   return result;
 }
 
+/**
+ * @brief Unite replacements without building a cross product of them. Variables absent in one of the operands are
+ * padded with an empty ScAddr, duplicated columns are skipped
+ * @returns replacements with all columns of `first` followed by new columns of `second`
+ */
 Replacements inference::ReplacementsUtils::uniteReplacements(Replacements const & first, Replacements const & second)
 {
-  Replacements result;
-  size_t resultSize = 0;
-  set<string> firstKeys;
-  getKeySet(first, firstKeys);
-  set<string> secondKeys;
-  getKeySet(second, secondKeys);
-  set<string> commonKeysSet = getCommonKeys(firstKeys, secondKeys);
-  size_t firstAmountOfColumns = getColumnsAmount(first);
-  size_t secondAmountOfColumns = getColumnsAmount(second);
-
-  if (firstAmountOfColumns == 0)
-    return copyReplacements(second);
-  if (secondAmountOfColumns == 0)
-    return copyReplacements(first);
-
-  for (size_t columnIndexInFirst = 0; columnIndexInFirst < firstAmountOfColumns; ++columnIndexInFirst)
-  {
-    for (size_t columnIndexInSecond = 0; columnIndexInSecond < secondAmountOfColumns; ++columnIndexInSecond)
-    {
-      for (string const & firstKey : firstKeys)
-        result[firstKey].push_back(first.find(firstKey)->second[columnIndexInFirst]);
-      for (string const & secondKey : secondKeys)
-      {
-        if (result[secondKey].size() == resultSize)
-          result[secondKey].push_back(second.find(secondKey)->second[columnIndexInSecond]);
-      }
-      ++resultSize;
-      for (string const & secondKey : secondKeys)
-        result[secondKey].push_back(second.find(secondKey)->second[columnIndexInSecond]);
-      for (string const & firstKey : firstKeys)
-      {
-        if (result[firstKey].size() == resultSize)
-          result[firstKey].push_back(first.find(firstKey)->second[columnIndexInFirst]);
-      }
-      ++resultSize;
-    }
-  }
-  return result;
+  ReplacementsUnion replacementsUnion;
+  replacementsUnion.add(first);
+  replacementsUnion.add(second);
+  return replacementsUnion.getReplacements();
 }
 
-void inference::ReplacementsUtils::getKeySet(Replacements const & map, std::set<std::string> & keySet)
+void inference::ReplacementsUtils::getKeySet(Replacements const & map, VarNames & keySet)
 {
   for (auto const & pair : map)
     keySet.insert(pair.first);
 }
 
-set<string> inference::ReplacementsUtils::getCommonKeys(set<string> const & first, set<string> const & second)
-{
-  set<string> result;
-  for (string const & key : first)
-  {
-    if (second.find(key) != second.end())
-      result.insert(key);
-  }
-  return result;
-}
-
 Replacements inference::ReplacementsUtils::copyReplacements(Replacements const & replacements)
 {
   Replacements result;
@@ -124,7 +64,8 @@ Replacements inference::ReplacementsUtils::copyReplacements(Replacements const &
 }
 
 /**
- * @brief The size of the all ScAddrVector of variables is the same (it is a matrix)
+ * @brief The size of the all ScAddrVector of variables is the same (it is a matrix). Padded (empty) replacements are
+ * not added to params, so these variables stay free
  * @param replacements to convert to vector<ScTemplateParams>
  * @return vector<ScTemplateParams> of converted replacements
  */
@@ -132,18 +73,18 @@ vector<ScTemplateParams> inference::ReplacementsUtils::getReplacementsToScTempla
     Replacements const & replacements)
 {
   vector<ScTemplateParams> result;
-  set<string> keys;
-  getKeySet(replacements, keys);
-  if (keys.empty())
-    return result;
-
-  size_t columnsAmount = replacements.begin()->second.size();
+  size_t const columnsAmount = getColumnsAmount(replacements);
+  result.reserve(columnsAmount);
   for (size_t columnIndex = 0; columnIndex < columnsAmount; ++columnIndex)
   {
     ScTemplateParams params;
-    for (string const & key : keys)
-      params.Add(key, replacements.find(key)->second[columnIndex]);
-    result.push_back(params);
+    for (auto const & pair : replacements)
+    {
+      ScAddr const & value = pair.second[columnIndex];
+      if (value.IsValid())
+        params.Add(pair.first, value);
+    }
+    result.push_back(std::move(params));
   }
   return result;
 }
@@ -152,3 +93,8 @@ size_t inference::ReplacementsUtils::getColumnsAmount(Replacements const & repla
 {
   return (replacements.empty() ? 0 : replacements.begin()->second.size());
 }
+
+size_t inference::ReplacementsUtils::getJoinedColumnsAmount()
+{
+  return joinedColumnsAmount;
+}
@@ -6,28 +6,52 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <set>
 
 #include <sc-memory/sc_addr.hpp>
 #include <sc-memory/sc_template.hpp>
 
+#include "inferenceConfig/InferenceConfig.hpp"
+
+#include "MonotonicArena.hpp"
+#include "WorkStealingScheduler.hpp"
+
 using Replacements = std::map<std::string, ScAddrVector>;
+/// Names of variables of a formula, they are allocated in the current arena (see MonotonicArena)
+using VarNames = inference::ArenaSet<std::string>;
 using namespace std;
 
 namespace inference
 {
+/// Config and scheduler of joins of an inference manager, nodes of formulas pass them to `intersectReplacements`
+struct JoinSettings
+{
+  JoinConfig config;
+  /// Scheduler to join partitions as tasks, partitions are joined by threads of their own if it is nullptr
+  std::shared_ptr<WorkStealingScheduler> scheduler;
+};
+
 class ReplacementsUtils
 {
 public:
-  static Replacements intersectReplacements(Replacements const & first, Replacements const & second);
+  static Replacements intersectReplacements(
+      Replacements const & first,
+      Replacements const & second,
+      JoinSettings const & joinSettings = JoinSettings());
   static Replacements uniteReplacements(Replacements const & first, Replacements const & second);
   static vector<ScTemplateParams> getReplacementsToScTemplateParams(Replacements const & replacements);
   static size_t getColumnsAmount(Replacements const & replacements);
-  static void getKeySet(Replacements const & map, std::set<std::string> & keySet);
+  static void getKeySet(Replacements const & map, VarNames & keySet);
+
+  /// @returns amount of columns made by joins of `intersectReplacements` of all inference managers
+  static size_t getJoinedColumnsAmount();
 
 private:
-  static set<string> getCommonKeys(set<string> const & first, set<string> const & second);
+  static std::atomic<size_t> joinedColumnsAmount;
+
   static Replacements copyReplacements(Replacements const & replacements);
 };
 
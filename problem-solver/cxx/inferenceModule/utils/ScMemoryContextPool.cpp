@@ -0,0 +1,166 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "ScMemoryContextPool.hpp"
+
+#include <algorithm>
+
+namespace inference
+{
+void ScMemoryContextCaches::clear()
+{
+  templatesWithLinks.clear();
+  templatesLinksContent.clear();
+  linksContent.clear();
+  templateLinksMatches.clear();
+  numericLinksIndex = NumericLinksIndex();
+  isNumericLinksIndexBuilt = false;
+  rangesLinks.clear();
+  linksNumericValues.clear();
+}
+
+ScMemoryContextPool::Lease::Lease(ScMemoryContextPool * pool, Entry * entry)
+  : pool(pool)
+  , entry(entry)
+  , checkoutTime(std::chrono::steady_clock::now())
+{
+}
+
+ScMemoryContextPool::Lease::Lease(Lease && other) noexcept
+  : pool(other.pool)
+  , entry(other.entry)
+  , checkoutTime(other.checkoutTime)
+{
+  other.pool = nullptr;
+  other.entry = nullptr;
+}
+
+ScMemoryContextPool::Lease::~Lease()
+{
+  if (pool != nullptr)
+    pool->checkin(entry, std::chrono::steady_clock::now() - checkoutTime);
+}
+
+ScMemoryContext * ScMemoryContextPool::Lease::getContext() const
+{
+  return entry->context.get();
+}
+
+ScMemoryContextCaches & ScMemoryContextPool::Lease::getCaches() const
+{
+  return entry->caches;
+}
+
+ScMemoryContextPool::ScMemoryContextPool(size_t size, std::string const & name)
+  : name(name)
+  , size(std::max<size_t>(size, 1))
+  , creationTime(std::chrono::steady_clock::now())
+{
+  createEntries();
+}
+
+ScMemoryContextPool::Lease ScMemoryContextPool::checkout()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  if (freeEntries.empty())
+  {
+    ++waitsAmount;
+    entryReturned.wait(lock, [this]() { return !freeEntries.empty(); });
+  }
+
+  Lease::Entry * entry = freeEntries.back();
+  freeEntries.pop_back();
+  ++checkoutsAmount;
+  peakInUse = std::max(peakInUse, entries.size() - freeEntries.size());
+  return {this, entry};
+}
+
+void ScMemoryContextPool::resize(size_t otherSize)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  size = std::max<size_t>(otherSize, 1);
+  createEntries();
+
+  // Checked out contexts are destroyed when they are returned
+  while (entries.size() > size && !freeEntries.empty())
+  {
+    Lease::Entry * entry = freeEntries.back();
+    freeEntries.pop_back();
+    entries.erase(std::find_if(
+        entries.begin(), entries.end(), [entry](std::unique_ptr<Lease::Entry> const & other) {
+          return other.get() == entry;
+        }));
+  }
+  entryReturned.notify_all();
+}
+
+void ScMemoryContextPool::clearCaches()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  for (Lease::Entry * entry : freeEntries)
+    entry->caches.clear();
+}
+
+size_t ScMemoryContextPool::getSize() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return size;
+}
+
+size_t ScMemoryContextPool::getCheckoutsAmount() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return checkoutsAmount;
+}
+
+size_t ScMemoryContextPool::getWaitsAmount() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return waitsAmount;
+}
+
+size_t ScMemoryContextPool::getPeakInUse() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return peakInUse;
+}
+
+double ScMemoryContextPool::getUtilization() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  auto const lifeTime = (std::chrono::steady_clock::now() - creationTime) * size;
+  return lifeTime.count() == 0 ? 0 : static_cast<double>(busyTime.count()) / lifeTime.count();
+}
+
+void ScMemoryContextPool::checkin(Lease::Entry * entry, std::chrono::steady_clock::duration entryBusyTime)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  busyTime += entryBusyTime;
+  if (entries.size() > size)
+  {
+    entries.erase(std::find_if(
+        entries.begin(), entries.end(), [entry](std::unique_ptr<Lease::Entry> const & other) {
+          return other.get() == entry;
+        }));
+    return;
+  }
+  freeEntries.push_back(entry);
+  entryReturned.notify_one();
+}
+
+void ScMemoryContextPool::createEntries()
+{
+  while (entries.size() < size)
+  {
+    std::unique_ptr<Lease::Entry> entry = std::make_unique<Lease::Entry>();
+    entry->context =
+        std::make_unique<ScMemoryContext>(sc_access_lvl_make_min, name + "_" + std::to_string(entries.size()));
+    freeEntries.push_back(entry.get());
+    entries.push_back(std::move(entry));
+  }
+}
+
+}  // namespace inference
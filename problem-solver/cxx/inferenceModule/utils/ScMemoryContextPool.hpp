@@ -0,0 +1,152 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sc-memory/sc_addr.hpp>
+#include <sc-memory/sc_memory.hpp>
+
+#include "NumericLinksIndex.hpp"
+
+namespace inference
+{
+/// Content of a link of search results with its hash, so content of the link is read once
+struct LinkContent
+{
+  std::string content;
+  size_t contentHash = 0;
+};
+
+/// Content of a link of a template, links of search results are compared with it by hash before comparing content
+struct TemplateLinkContent
+{
+  ScAddr link;
+  std::string content;
+  size_t contentHash = 0;
+  /// Numeric content of found links is compared with `range` instead of equality of content if it is true
+  bool isComparison = false;
+  NumericRange range;
+};
+
+/// Data read through a memory context of the pool, it is cached until the pool caches are cleared
+struct ScMemoryContextCaches
+{
+  /// Whether a template belongs to `concept_template_with_links`
+  std::map<ScAddr, bool, ScAddLessFunc> templatesWithLinks;
+  /// Content of links of a template by the hash of link
+  std::map<ScAddr, std::map<std::string, TemplateLinkContent>, ScAddLessFunc> templatesLinksContent;
+  /// Content of links of search results, so content of every link is read once
+  std::unordered_map<ScAddr, LinkContent, ScAddrHashFunc<::size_t>> linksContent;
+  /// Links found by the content index of sc-memory with content of a template link, by the template link
+  std::unordered_map<ScAddr, ScAddrUnorderedSet, ScAddrHashFunc<::size_t>> templateLinksMatches;
+  /// Numeric links of input structures, it is built by the first comparison of content
+  NumericLinksIndex numericLinksIndex;
+  bool isNumericLinksIndexBuilt = false;
+  /// Links of the index in ranges of template links
+  std::unordered_map<ScAddr, ScAddrUnorderedSet, ScAddrHashFunc<::size_t>> rangesLinks;
+  /// Numeric values of links which are not in the index, NaN if content of a link is not a number
+  std::unordered_map<ScAddr, double, ScAddrHashFunc<::size_t>> linksNumericValues;
+
+  void clear();
+};
+
+/**
+ * Pool of memory contexts for workers searching concurrently. A worker checks out a context for a unit of work and
+ * the context is returned to the pool when the lease is destroyed. Every context has its own caches, so workers don't
+ * share any data read from memory.
+ */
+class ScMemoryContextPool
+{
+public:
+  class Lease
+  {
+  public:
+    Lease(Lease && other) noexcept;
+    ~Lease();
+
+    Lease(Lease const & other) = delete;
+    Lease & operator=(Lease const & other) = delete;
+    Lease & operator=(Lease && other) = delete;
+
+    ScMemoryContext * getContext() const;
+
+    ScMemoryContextCaches & getCaches() const;
+
+  private:
+    friend class ScMemoryContextPool;
+
+    struct Entry;
+
+    Lease(ScMemoryContextPool * pool, Entry * entry);
+
+    ScMemoryContextPool * pool;
+    Entry * entry;
+    std::chrono::steady_clock::time_point checkoutTime;
+  };
+
+  explicit ScMemoryContextPool(size_t size, std::string const & name = "inference_worker");
+
+  ScMemoryContextPool(ScMemoryContextPool const & other) = delete;
+  ScMemoryContextPool & operator=(ScMemoryContextPool const & other) = delete;
+
+  /// Check out a free context, wait until some context is returned if all contexts are used
+  Lease checkout();
+
+  /// Create new contexts or destroy returned ones to get `size` contexts
+  void resize(size_t size);
+
+  /// Clear caches of all contexts which are not checked out
+  void clearCaches();
+
+  size_t getSize() const;
+
+  size_t getCheckoutsAmount() const;
+
+  /// @returns amount of checkouts which waited for a free context
+  size_t getWaitsAmount() const;
+
+  /// @returns the largest amount of contexts checked out at once
+  size_t getPeakInUse() const;
+
+  /// @returns part of time since pool creation when contexts were checked out
+  double getUtilization() const;
+
+private:
+  void checkin(Lease::Entry * entry, std::chrono::steady_clock::duration busyTime);
+
+  void createEntries();
+
+  mutable std::mutex mutex;
+  std::condition_variable entryReturned;
+
+  std::string name;
+  size_t size;
+  std::vector<std::unique_ptr<Lease::Entry>> entries;
+  std::vector<Lease::Entry *> freeEntries;
+
+  std::chrono::steady_clock::time_point creationTime;
+  std::chrono::steady_clock::duration busyTime{0};
+  size_t checkoutsAmount = 0;
+  size_t waitsAmount = 0;
+  size_t peakInUse = 0;
+};
+
+struct ScMemoryContextPool::Lease::Entry
+{
+  std::unique_ptr<ScMemoryContext> context;
+  ScMemoryContextCaches caches;
+};
+
+}  // namespace inference
@@ -0,0 +1,72 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "SpillFile.hpp"
+
+namespace inference
+{
+SpillFile::SpillFile()
+  : file(std::tmpfile())
+{
+  if (file == nullptr)
+    SC_THROW_EXCEPTION(utils::ExceptionCritical, "Can't create temporary file to spill replacements");
+}
+
+SpillFile::~SpillFile()
+{
+  std::fclose(file);
+}
+
+void SpillFile::writeSize(uint64_t value)
+{
+  write(&value, sizeof(value));
+}
+
+void SpillFile::writeAddr(ScAddr const & addr)
+{
+  sc_addr const & realAddr = addr.GetRealAddr();
+  write(&realAddr.seg, sizeof(realAddr.seg));
+  write(&realAddr.offset, sizeof(realAddr.offset));
+}
+
+void SpillFile::rewind()
+{
+  std::fflush(file);
+  std::rewind(file);
+}
+
+bool SpillFile::readSize(uint64_t & value)
+{
+  return read(&value, sizeof(value));
+}
+
+bool SpillFile::readAddr(ScAddr & addr)
+{
+  sc_addr realAddr;
+  if (!read(&realAddr.seg, sizeof(realAddr.seg)) || !read(&realAddr.offset, sizeof(realAddr.offset)))
+    return false;
+  addr = ScAddr(realAddr);
+  return true;
+}
+
+size_t SpillFile::getBytesWritten() const
+{
+  return bytesWritten;
+}
+
+void SpillFile::write(void const * data, size_t size)
+{
+  if (std::fwrite(data, size, 1, file) != 1)
+    SC_THROW_EXCEPTION(utils::ExceptionCritical, "Can't write " << size << " bytes to spill file");
+  bytesWritten += size;
+}
+
+bool SpillFile::read(void * data, size_t size)
+{
+  return std::fread(data, size, 1, file) == 1;
+}
+
+}  // namespace inference
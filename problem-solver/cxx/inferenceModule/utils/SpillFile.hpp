@@ -0,0 +1,52 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+#include <sc-memory/sc_addr.hpp>
+
+namespace inference
+{
+/**
+ * Temporary binary file to spill intermediate data of inference. The file is created in the temporary directory of
+ * the system and removed when it is closed. Values are written in native byte order, ScAddr is written as its segment
+ * and offset.
+ */
+class SpillFile
+{
+public:
+  /// @throws utils::ExceptionCritical if the file can't be created
+  SpillFile();
+
+  ~SpillFile();
+
+  SpillFile(SpillFile const & other) = delete;
+  SpillFile & operator=(SpillFile const & other) = delete;
+
+  void writeSize(uint64_t value);
+  void writeAddr(ScAddr const & addr);
+
+  /// Start reading the file from the beginning
+  void rewind();
+
+  /// @returns false if the end of the file is reached
+  bool readSize(uint64_t & value);
+  bool readAddr(ScAddr & addr);
+
+  size_t getBytesWritten() const;
+
+private:
+  void write(void const * data, size_t size);
+  bool read(void * data, size_t size);
+
+  std::FILE * file;
+  size_t bytesWritten = 0;
+};
+
+}  // namespace inference
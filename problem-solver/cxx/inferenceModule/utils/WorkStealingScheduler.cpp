@@ -0,0 +1,220 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "WorkStealingScheduler.hpp"
+
+#include <algorithm>
+
+#include "MonotonicArena.hpp"
+
+namespace inference
+{
+thread_local WorkStealingScheduler const * WorkStealingScheduler::currentScheduler = nullptr;
+thread_local size_t WorkStealingScheduler::currentThreadIndex = 0;
+
+WorkStealingScheduler::TaskGroup::TaskGroup(WorkStealingScheduler & scheduler)
+  : scheduler(scheduler)
+{
+}
+
+WorkStealingScheduler::TaskGroup::~TaskGroup()
+{
+  try
+  {
+    wait();
+  }
+  catch (...)
+  {
+  }
+}
+
+void WorkStealingScheduler::TaskGroup::run(Task task)
+{
+  ++pendingTasksAmount;
+  scheduler.push({std::move(task), this});
+}
+
+void WorkStealingScheduler::TaskGroup::wait()
+{
+  while (pendingTasksAmount > 0)
+  {
+    if (!scheduler.tryRunJob(this))
+      scheduler.waitForJob([this]() { return pendingTasksAmount == 0 || queuedTasksAmount > 0; });
+  }
+
+  std::exception_ptr taskException;
+  {
+    std::lock_guard<std::mutex> lock(exceptionMutex);
+    std::swap(taskException, exception);
+  }
+  if (taskException)
+    std::rethrow_exception(taskException);
+}
+
+WorkStealingScheduler::WorkStealingScheduler(size_t threadsAmount)
+{
+  for (size_t queueIndex = 0; queueIndex <= threadsAmount; ++queueIndex)
+    queues.push_back(std::make_unique<Queue>());
+
+  threads.reserve(threadsAmount);
+  for (size_t threadIndex = 0; threadIndex < threadsAmount; ++threadIndex)
+    threads.emplace_back(&WorkStealingScheduler::work, this, threadIndex);
+}
+
+WorkStealingScheduler::~WorkStealingScheduler()
+{
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    isStopped = true;
+  }
+  stateChanged.notify_all();
+  for (std::thread & thread : threads)
+    thread.join();
+}
+
+size_t WorkStealingScheduler::getThreadsAmount() const
+{
+  return threads.size();
+}
+
+size_t WorkStealingScheduler::getTasksAmount() const
+{
+  return tasksAmount;
+}
+
+size_t WorkStealingScheduler::getStealsAmount() const
+{
+  return stealsAmount;
+}
+
+std::chrono::steady_clock::duration WorkStealingScheduler::getIdleTime() const
+{
+  return std::chrono::steady_clock::duration(idleTime.load());
+}
+
+void WorkStealingScheduler::push(Job job)
+{
+  ++tasksAmount;
+  TaskGroup * group = job.group;
+  {
+    Queue & queue = *queues[getQueueIndex()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+    ++group->queuedTasksAmount;
+    ++queuedJobsAmount;
+  }
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+  }
+  stateChanged.notify_all();
+}
+
+bool WorkStealingScheduler::tryRunJob(TaskGroup * group)
+{
+  size_t const ownQueueIndex = getQueueIndex();
+  Job job;
+  bool isTaken = tryTakeJob(ownQueueIndex, true, group, job);
+  for (size_t shift = 1; !isTaken && shift < queues.size(); ++shift)
+  {
+    isTaken = tryTakeJob((ownQueueIndex + shift) % queues.size(), false, group, job);
+    if (isTaken)
+      ++stealsAmount;
+  }
+
+  if (isTaken)
+    runJob(job);
+  return isTaken;
+}
+
+bool WorkStealingScheduler::tryTakeJob(size_t queueIndex, bool isOwnQueue, TaskGroup * group, Job & job)
+{
+  Queue & queue = *queues[queueIndex];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  auto const isGroupJob = [group](Job const & otherJob) {
+    return group == nullptr || otherJob.group == group;
+  };
+
+  // The own queue is a stack of the newest tasks, other queues are stolen from their oldest tasks
+  std::deque<Job>::iterator jobIterator;
+  if (isOwnQueue)
+  {
+    auto const reverseIterator = std::find_if(queue.jobs.rbegin(), queue.jobs.rend(), isGroupJob);
+    if (reverseIterator == queue.jobs.rend())
+      return false;
+    jobIterator = std::next(reverseIterator).base();
+  }
+  else
+  {
+    jobIterator = std::find_if(queue.jobs.begin(), queue.jobs.end(), isGroupJob);
+    if (jobIterator == queue.jobs.end())
+      return false;
+  }
+
+  job = std::move(*jobIterator);
+  queue.jobs.erase(jobIterator);
+  --job.group->queuedTasksAmount;
+  --queuedJobsAmount;
+  return true;
+}
+
+void WorkStealingScheduler::runJob(Job & job)
+{
+  TaskGroup & group = *job.group;
+  try
+  {
+    MonotonicArena::HeapScope const heapScope;
+    job.task();
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> lock(group.exceptionMutex);
+    if (!group.exception)
+      group.exception = std::current_exception();
+  }
+
+  // The group may be destroyed by its waiting thread right after the last task is finished
+  if (--group.pendingTasksAmount == 0)
+  {
+    {
+      std::lock_guard<std::mutex> lock(stateMutex);
+    }
+    stateChanged.notify_all();
+  }
+}
+
+void WorkStealingScheduler::waitForJob(std::function<bool()> const & isReady)
+{
+  std::unique_lock<std::mutex> lock(stateMutex);
+  if (isReady())
+    return;
+
+  auto const idleStartTime = std::chrono::steady_clock::now();
+  stateChanged.wait(lock, isReady);
+  idleTime += (std::chrono::steady_clock::now() - idleStartTime).count();
+}
+
+void WorkStealingScheduler::work(size_t threadIndex)
+{
+  currentScheduler = this;
+  currentThreadIndex = threadIndex;
+  while (true)
+  {
+    if (tryRunJob(nullptr))
+      continue;
+
+    waitForJob([this]() { return isStopped || queuedJobsAmount > 0; });
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (isStopped)
+      break;
+  }
+}
+
+size_t WorkStealingScheduler::getQueueIndex() const
+{
+  return currentScheduler == this ? currentThreadIndex : queues.size() - 1;
+}
+
+}  // namespace inference
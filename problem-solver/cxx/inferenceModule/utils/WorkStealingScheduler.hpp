@@ -0,0 +1,125 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace inference
+{
+/**
+ * Scheduler of tasks with work stealing. Every worker thread has its own queue: a worker takes its newest task, an
+ * idle worker steals the oldest task of another queue. Tasks added by other threads are put into a shared queue.
+ * Tasks are run in groups: a thread waiting for a group runs tasks of the group too, so the waiting thread is a worker
+ * while it waits and nested groups (e.g. join partitions of a rule task) never block all workers.
+ * Tasks are run without the current arena of the thread (see MonotonicArena), so their containers may outlive them.
+ */
+class WorkStealingScheduler
+{
+public:
+  using Task = std::function<void()>;
+
+  /// Group of tasks with a barrier. The first exception of tasks is rethrown by `wait`
+  class TaskGroup
+  {
+  public:
+    explicit TaskGroup(WorkStealingScheduler & scheduler);
+    /// Wait for tasks, their exceptions are ignored
+    ~TaskGroup();
+
+    TaskGroup(TaskGroup const & other) = delete;
+    TaskGroup & operator=(TaskGroup const & other) = delete;
+
+    void run(Task task);
+
+    /// Run tasks of the group in this thread until all of them are finished
+    void wait();
+
+  private:
+    friend class WorkStealingScheduler;
+
+    WorkStealingScheduler & scheduler;
+    /// Tasks which are added and not finished
+    std::atomic<size_t> pendingTasksAmount{0};
+    /// Tasks which are added and not taken from queues
+    std::atomic<size_t> queuedTasksAmount{0};
+    std::mutex exceptionMutex;
+    std::exception_ptr exception;
+  };
+
+  /// @param threadsAmount is amount of worker threads. Threads waiting for groups run tasks too
+  explicit WorkStealingScheduler(size_t threadsAmount);
+  ~WorkStealingScheduler();
+
+  WorkStealingScheduler(WorkStealingScheduler const & other) = delete;
+  WorkStealingScheduler & operator=(WorkStealingScheduler const & other) = delete;
+
+  size_t getThreadsAmount() const;
+
+  size_t getTasksAmount() const;
+
+  /// @returns amount of tasks taken from a queue of another thread
+  size_t getStealsAmount() const;
+
+  /// @returns total time when workers and waiting threads had no task to run
+  std::chrono::steady_clock::duration getIdleTime() const;
+
+private:
+  struct Job
+  {
+    Task task;
+    TaskGroup * group;
+  };
+
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  void push(Job job);
+
+  /// Take a job of `group` (or any job if `group` is nullptr) from the own queue or steal it, and run it
+  bool tryRunJob(TaskGroup * group);
+
+  bool tryTakeJob(size_t queueIndex, bool isOwnQueue, TaskGroup * group, Job & job);
+
+  void runJob(Job & job);
+
+  void waitForJob(std::function<bool()> const & isReady);
+
+  void work(size_t threadIndex);
+
+  /// @returns index of the queue of this thread, the shared queue for threads which are not workers
+  size_t getQueueIndex() const;
+
+  /// Queues of workers and the shared queue at the end
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> threads;
+
+  std::mutex stateMutex;
+  std::condition_variable stateChanged;
+  std::atomic<size_t> queuedJobsAmount{0};
+  bool isStopped = false;
+
+  std::atomic<size_t> tasksAmount{0};
+  std::atomic<size_t> stealsAmount{0};
+  std::atomic<std::chrono::steady_clock::rep> idleTime{0};
+
+  static thread_local WorkStealingScheduler const * currentScheduler;
+  static thread_local size_t currentThreadIndex;
+};
+
+}  // namespace inference